@@ -0,0 +1,376 @@
+/*
+    TINYVULKAN BENCHMARKS:
+        Headless micro benchmarks (no window or surface) which run against any Vulkan ICD, including lavapipe on
+        machines without a GPU, and write their results as JSON so they can be tracked per commit.
+
+        tinyvk_bench [--output tinyvk_bench.json] [--filter name] [--min-time seconds] [--quick]
+            --output    JSON result file (default: tinyvk_bench.json).
+            --filter    Only runs benchmarks whose name contains the filter.
+            --min-time  Minimum measured time per benchmark case in seconds (default: 0.5).
+            --quick     Smaller case sizes and min-time 0.1 (CI smoke runs).
+
+        Force lavapipe: VK_DRIVER_FILES=/usr/share/vulkan/icd.d/lvp_icd.x86_64.json ./tinyvk_bench
+
+        BENCHMARKS:
+            stage_buffer_data       TinyVkBuffer::StageBufferData() throughput vs transfer size.
+            stage_image_data        TinyVkImage::StageImageData() throughput vs image size.
+            command_buffer_lease    TinyVkCommandPool::LeaseBuffer()/ReturnBuffer() rate (single and full pool).
+            render_execute          TinyVkGraphicsRenderer::RenderExecute() frames/sec for N draws into an offscreen target.
+            compute_execute         TinyVkComputeRenderer::ComputeExecute() overhead for N empty dispatches.
+            swapchain_present       TinyVkSwapchainRenderer::RenderExecute() frames/sec on a headless window (VK_EXT_headless_surface).
+            swapchain_resize        Same as swapchain_present with a frame buffer resize (swapchain recreation) every frame.
+
+        Every case reports the min/median/mean/max nanoseconds per iteration and a throughput derived from the median.
+*/
+#include "../TinyVulkan/TinyVulkan.hpp"
+#include <chrono>
+#include <ctime>
+#include <iomanip>
+using namespace tinyvk;
+
+#ifndef TINYVK_BENCH_SHADER_DIR
+    #define TINYVK_BENCH_SHADER_DIR "./Shaders/"
+#endif
+#ifndef TINYVK_BENCH_GIT_COMMIT
+    #define TINYVK_BENCH_GIT_COMMIT "unknown"
+#endif
+
+const std::vector<VkPhysicalDeviceType> benchDeviceTypes = { VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU, VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU, VK_PHYSICAL_DEVICE_TYPE_CPU };
+const TinyVkVertexDescription vertexDescription = TinyVkVertex::GetVertexDescription();
+const std::vector<VkDescriptorSetLayoutBinding> pushDescriptorLayouts = { TinyVkGraphicsPipeline::SelectPushDescriptorLayoutBinding(0, VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, VK_SHADER_STAGE_VERTEX_BIT, 1) };
+const std::vector<std::tuple<VkShaderStageFlagBits, std::string>> defaultShaders = {
+    { VK_SHADER_STAGE_VERTEX_BIT, TINYVK_BENCH_SHADER_DIR "passthrough_vert.spv" },
+    { VK_SHADER_STAGE_FRAGMENT_BIT, TINYVK_BENCH_SHADER_DIR "passthrough_frag.spv" }
+};
+const std::string computeShader = TINYVK_BENCH_SHADER_DIR "bench_dispatch.spv";
+
+// Embedded SPIR-V generated by the build (registered under the paths above, pipelines never read the .spv files).
+#include "passthrough_vert_spv.h"
+#include "passthrough_frag_spv.h"
+#include "bench_dispatch_spv.h"
+
+/// @brief Measured samples of a single benchmark case.
+struct TinyVkBenchResult {
+    std::string name;
+    std::vector<std::pair<std::string, uint64_t>> params;
+    std::vector<double> samplesNs;
+    double workPerIteration;
+    std::string throughputUnit;
+
+    double Min() const { return *std::min_element(samplesNs.begin(), samplesNs.end()); }
+    double Max() const { return *std::max_element(samplesNs.begin(), samplesNs.end()); }
+    double Mean() const { double sum = 0.0; for(double s : samplesNs) sum += s; return sum / samplesNs.size(); }
+    double Median() const {
+        std::vector<double> sorted = samplesNs;
+        std::sort(sorted.begin(), sorted.end());
+        size_t middle = sorted.size() / 2;
+        return (sorted.size() % 2 == 0)? (sorted[middle - 1] + sorted[middle]) * 0.5 : sorted[middle];
+    }
+    double Throughput() const { return workPerIteration / (Median() * 1.0e-9); }
+};
+
+/// @brief Runs benchmark cases (warmup + timed iterations until min-time has elapsed) and collects their results.
+class TinyVkBenchRunner {
+public:
+    std::vector<TinyVkBenchResult> results;
+    std::string filter;
+    double minSeconds = 0.5;
+    size_t minIterations = 5;
+    size_t maxIterations = 100000;
+    size_t warmupIterations = 2;
+
+    bool Enabled(const std::string& name) { return filter.empty() || name.find(filter) != std::string::npos; }
+
+    /// @brief Times iteration() until both minIterations and minSeconds are reached, workPerIteration is in throughputUnit (e.g. bytes -> bytes/s).
+    template<typename Iteration>
+    void Run(const std::string& name, std::vector<std::pair<std::string, uint64_t>> params, double workPerIteration, const std::string& throughputUnit, Iteration iteration) {
+        if (!Enabled(name)) return;
+        for(size_t i = 0; i < warmupIterations; i++) iteration();
+
+        TinyVkBenchResult result { name, params, {}, workPerIteration, throughputUnit };
+        double elapsedNs = 0.0;
+        while ((result.samplesNs.size() < minIterations || elapsedNs < minSeconds * 1.0e9) && result.samplesNs.size() < maxIterations) {
+            auto begin = std::chrono::steady_clock::now();
+            iteration();
+            double sampleNs = static_cast<double>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - begin).count());
+            result.samplesNs.push_back(sampleNs);
+            elapsedNs += sampleNs;
+        }
+
+        std::cout << std::left << std::setw(24) << name;
+        for(auto& param : params) std::cout << ' ' << param.first << '=' << param.second;
+        std::cout << "  median " << std::fixed << std::setprecision(1) << (result.Median() / 1000.0) << " us, "
+            << std::setprecision(2) << result.Throughput() << ' ' << throughputUnit << " (" << result.samplesNs.size() << " iterations)" << std::endl;
+        results.push_back(result);
+    }
+};
+
+/// @brief Escapes a string for a JSON string literal.
+std::string EscapeJson(const std::string& text) {
+    std::string escaped;
+    for(char c : text) {
+        switch(c) {
+            case '"': escaped += "\\\""; break;
+            case '\\': escaped += "\\\\"; break;
+            case '\n': escaped += "\\n"; break;
+            default: if (static_cast<unsigned char>(c) >= 0x20) escaped += c;
+        }
+    }
+    return escaped;
+}
+
+/// @brief Returns the benchmark results with the device/commit they were measured on as JSON.
+std::string ExportJson(TinyVkVulkanDevice& vkdevice, TinyVkBenchRunner& runner) {
+    VkPhysicalDeviceProperties properties;
+    vkGetPhysicalDeviceProperties(vkdevice.GetPhysicalDevice(), &properties);
+
+    std::time_t now = std::time(nullptr);
+    char timestamp[32];
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    std::ostringstream json;
+    json.setf(std::ios::fixed);
+    json.precision(3);
+    json << "{\n\t\"commit\": \"" << EscapeJson(TINYVK_BENCH_GIT_COMMIT) << "\",\n\t\"timestamp\": \"" << timestamp << "\",\n";
+    json << "\t\"device\": { \"name\": \"" << EscapeJson(properties.deviceName) << "\", \"type\": " << properties.deviceType
+        << ", \"vendorID\": " << properties.vendorID << ", \"deviceID\": " << properties.deviceID
+        << ", \"apiVersion\": \"" << VK_API_VERSION_MAJOR(properties.apiVersion) << '.' << VK_API_VERSION_MINOR(properties.apiVersion) << '.' << VK_API_VERSION_PATCH(properties.apiVersion)
+        << "\", \"driverVersion\": " << properties.driverVersion << " },\n";
+    json << "\t\"results\": [";
+
+    for(size_t i = 0; i < runner.results.size(); i++) {
+        TinyVkBenchResult& result = runner.results[i];
+        json << ((i == 0)? "\n" : ",\n") << "\t\t{ \"name\": \"" << EscapeJson(result.name) << "\", \"params\": {";
+        for(size_t p = 0; p < result.params.size(); p++)
+            json << ((p == 0)? " " : ", ") << '"' << EscapeJson(result.params[p].first) << "\": " << result.params[p].second;
+        json << " }, \"iterations\": " << result.samplesNs.size()
+            << ", \"min_ns\": " << result.Min() << ", \"median_ns\": " << result.Median() << ", \"mean_ns\": " << result.Mean() << ", \"max_ns\": " << result.Max()
+            << ", \"throughput\": " << result.Throughput() << ", \"throughput_unit\": \"" << EscapeJson(result.throughputUnit) << "\" }";
+    }
+
+    json << "\n\t]\n}\n";
+    return json.str();
+}
+
+void BenchStageBufferData(TinyVkBenchRunner& runner, TinyVkRenderContext& renderContext, bool quick) {
+    std::vector<VkDeviceSize> sizes = { 4096, 65536, 1048576, 16777216 };
+    if (quick) sizes.pop_back();
+
+    for(VkDeviceSize size : sizes) {
+        std::vector<uint8_t> data(size, 0x5A);
+        TinyVkBuffer buffer(renderContext, size, TinyVkBufferType::TINYVK_BUFFER_TYPE_STORAGE);
+        runner.Run("stage_buffer_data", {{ "bytes", size }}, static_cast<double>(size) / 1048576.0, "MiB/s",
+            [&]() {
+                buffer.StageBufferData(data.data(), size, 0, 0);
+                buffer.lastUse.Wait(UINT64_MAX, "stage_buffer_data");
+                renderContext.vkdevice.CollectRetiredResources();
+            });
+    }
+}
+
+void BenchStageImageData(TinyVkBenchRunner& runner, TinyVkRenderContext& renderContext, bool quick) {
+    std::vector<VkDeviceSize> extents = { 256, 1024, 2048 };
+    if (quick) extents.pop_back();
+
+    for(VkDeviceSize extent : extents) {
+        VkDeviceSize size = extent * extent * 4; // VK_FORMAT_B8G8R8A8_UNORM.
+        std::vector<uint8_t> data(size, 0x7F);
+        TinyVkImage image(renderContext, TinyVkImageType::TINYVK_IMAGE_TYPE_COLORATTACHMENT, extent, extent);
+        runner.Run("stage_image_data", {{ "width", extent }, { "height", extent }, { "bytes", size }}, static_cast<double>(size) / 1048576.0, "MiB/s",
+            [&]() {
+                image.StageImageData(data.data(), size);
+                image.lastUse.Wait(UINT64_MAX, "stage_image_data");
+                renderContext.vkdevice.CollectRetiredResources();
+            });
+    }
+}
+
+void BenchCommandBufferLease(TinyVkBenchRunner& runner, TinyVkVulkanDevice& vkdevice) {
+    const size_t operations = 1000;
+    TinyVkCommandPool commandPool(vkdevice, false);
+
+    runner.Run("command_buffer_lease", {{ "batch", 1 }, { "operations", operations }}, static_cast<double>(operations), "leases/s", [&]() {
+        for(size_t i = 0; i < operations; i++)
+            commandPool.ReturnBuffer(commandPool.LeaseBuffer(false));
+    });
+
+    const size_t poolSize = commandPool.GetBufferCount();
+    std::vector<std::pair<VkCommandBuffer, int32_t>> leased(poolSize);
+    runner.Run("command_buffer_lease", {{ "batch", poolSize }, { "operations", operations * poolSize }}, static_cast<double>(operations * poolSize), "leases/s", [&]() {
+        for(size_t i = 0; i < operations; i++) {
+            for(size_t b = 0; b < poolSize; b++) leased[b] = commandPool.LeaseBuffer(false);
+            for(size_t b = 0; b < poolSize; b++) commandPool.ReturnBuffer(leased[b]);
+        }
+    });
+}
+
+void BenchRenderExecute(TinyVkBenchRunner& runner, TinyVkVulkanDevice& vkdevice, TinyVkGraphicsPipeline& pipeline, bool quick) {
+    const uint32_t width = 512, height = 512;
+    TinyVkCommandPool commandPool(vkdevice, false);
+    TinyVkRenderContext renderContext(vkdevice, commandPool, pipeline);
+
+    std::vector<TinyVkVertex> quad = TinyVkQuad::CreateWithOffsetExt(glm::vec2(0.0f, 0.0f), glm::vec3(16.0f, 16.0f, 1.0f));
+    std::vector<uint32_t> indices = { 0,1,2,2,3,0 };
+
+    size_t sizeofQuad = TinyVkBuffer::GetSizeofVector<TinyVkVertex>(quad);
+    TinyVkBuffer vbuffer(renderContext, sizeofQuad, TinyVkBufferType::TINYVK_BUFFER_TYPE_VERTEX);
+    vbuffer.StageBufferData(quad.data(), sizeofQuad, 0, 0);
+
+    size_t sizeofIndices = TinyVkBuffer::GetSizeofVector<uint32_t>(indices);
+    TinyVkBuffer ibuffer(renderContext, sizeofIndices, TinyVkBufferType::TINYVK_BUFFER_TYPE_INDEX);
+    ibuffer.StageBufferData(indices.data(), sizeofIndices, 0, 0);
+
+    glm::mat4 camera = TinyVkMath::Project2D(width, height, 0, 0, 1.0, 0.0);
+    TinyVkBuffer projection(renderContext, sizeof(glm::mat4), TinyVkBufferType::TINYVK_BUFFER_TYPE_UNIFORM);
+    projection.StageBufferData(&camera, sizeof(glm::mat4), 0, 0);
+
+    TinyVkImage renderTarget(renderContext, TinyVkImageType::TINYVK_IMAGE_TYPE_COLORATTACHMENT, width, height);
+    TinyVkGraphicsRenderer renderer(renderContext, &commandPool, &renderTarget, VK_NULL_HANDLE);
+
+    uint32_t drawCount = 1;
+    renderer.onRenderEvents.hook(TinyVkCallback<TinyVkCommandPool&>(
+    [&drawCount, &indices, &renderer, &pipeline, &vbuffer, &ibuffer, &projection](TinyVkCommandPool& commandPool) {
+        auto commandBuffer = commandPool.LeaseBuffer(false);
+        renderer.BeginRecordCmdBuffer(commandBuffer.first);
+            VkDescriptorBufferInfo cameraDescriptorInfo = projection.GetBufferDescriptor();
+            VkWriteDescriptorSet cameraDescriptor = pipeline.SelectWriteBufferDescriptor(0, 1, { &cameraDescriptorInfo });
+            renderer.PushDescriptorSet(commandBuffer.first, { cameraDescriptor });
+
+            VkDeviceSize offsets[] = { 0 };
+            renderer.CmdBindGeometry(commandBuffer.first, &vbuffer.buffer, ibuffer.buffer, offsets);
+            for(uint32_t i = 0; i < drawCount; i++)
+                renderer.CmdDrawGeometry(commandBuffer.first, true, 1, 0, indices.size(), 0, 0);
+        renderer.EndRecordCmdBuffer(commandBuffer.first);
+    }));
+
+    std::vector<uint32_t> drawCounts = { 1, 100, 1000 };
+    if (quick) drawCounts.pop_back();
+
+    for(uint32_t draws : drawCounts) {
+        drawCount = draws;
+        // RenderExecute() waits for the previous frame's last use, so each iteration measures one full frame (record + submit + GPU).
+        runner.Run("render_execute", {{ "draws", draws }, { "width", width }, { "height", height }}, 1.0, "frames/s", [&]() {
+            if (renderer.RenderExecute() != VK_SUCCESS) throw TinyVkRuntimeError("TinyVulkan: Benchmark RenderExecute failed!");
+        });
+        renderTarget.lastUse.Wait(UINT64_MAX, "tinyvk_bench::render_execute");
+    }
+}
+
+void BenchComputeExecute(TinyVkBenchRunner& runner, TinyVkVulkanDevice& vkdevice, bool quick) {
+    TinyVkCommandPool commandPool(vkdevice, true);
+    TinyVkComputeRenderer renderer(vkdevice, commandPool, vertexDescription, computeShader, {}, {});
+
+    uint32_t dispatchCount = 1;
+    renderer.onRenderEvents.hook(TinyVkCallback<TinyVkCommandPool&>(
+    [&dispatchCount, &renderer](TinyVkCommandPool& commandPool) {
+        auto commandBuffer = commandPool.LeaseBuffer(false);
+        renderer.BeginRecordCmdBuffer(commandBuffer.first, {}, {});
+            for(uint32_t i = 0; i < dispatchCount; i++)
+                renderer.CmdispatchGroups(commandBuffer.first, { 1, 1, 1 }, { 0, 0, 0 });
+        renderer.EndRecordCmdBuffer(commandBuffer.first, {}, {});
+    }));
+
+    std::vector<uint32_t> dispatchCounts = { 1, 256 };
+    if (quick) dispatchCounts.pop_back();
+
+    for(uint32_t dispatches : dispatchCounts) {
+        dispatchCount = dispatches;
+        // ComputeExecute() reuses command buffers whose submission completed, it only waits once every buffer of the pool is in flight.
+        runner.Run("compute_execute", {{ "dispatches", dispatches }}, static_cast<double>(dispatches), "dispatches/s", [&]() {
+            if (renderer.ComputeExecute() != VK_SUCCESS) throw TinyVkRuntimeError("TinyVulkan: Benchmark ComputeExecute failed!");
+        });
+        commandPool.ReturnAllBuffers();
+    }
+}
+
+void BenchSwapchainPresent(TinyVkBenchRunner& runner) {
+    if (!runner.Enabled("swapchain_present") && !runner.Enabled("swapchain_resize")) return;
+
+    const int width = 512, height = 512;
+    TinyVkWindow window("TinyVulkan Benchmarks", width, height, true, false, false, 200, 200, true);
+    TinyVkVulkanDevice vkdevice("TinyVulkan Benchmarks", false, benchDeviceTypes, &window);
+    TinyVkCommandPool commandPool(vkdevice, false);
+    TinyVkGraphicsPipeline pipeline(vkdevice, vertexDescription, defaultShaders, pushDescriptorLayouts, {}, false);
+    TinyVkRenderContext renderContext(vkdevice, commandPool, pipeline);
+
+    // A single renderer: TinyVkWindow::onResizeFrameBuffer is static and keeps the renderer's resize callback hooked.
+    TinyVkSwapchainRenderer swapRenderer(renderContext, window, TinyVkBufferingMode::DOUBLE);
+    swapRenderer.onRenderEvents.hook(TinyVkCallback<TinyVkCommandPool&>([&swapRenderer](TinyVkCommandPool& commandPool) {
+        auto commandBuffer = commandPool.LeaseBuffer(false);
+        swapRenderer.BeginRecordCmdBuffer(commandBuffer.first);
+        swapRenderer.EndRecordCmdBuffer(commandBuffer.first);
+    }));
+
+    auto presentFrame = [&swapRenderer]() {
+        VkResult result = swapRenderer.RenderExecute();
+        if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR && result != VK_ERROR_OUT_OF_DATE_KHR)
+            throw TinyVkRuntimeError("TinyVulkan: Benchmark swapchain RenderExecute failed!");
+    };
+
+    const uint64_t framesInFlight = swapRenderer.GetFramesInFlight(), imageCount = swapRenderer.GetSwapchainImageCount();
+    runner.Run("swapchain_present", {{ "frames_in_flight", framesInFlight }, { "images", imageCount }, { "width", width }, { "height", height }}, 1.0, "frames/s", presentFrame);
+
+    // The resize event renders a frame at the new size immediately (renderer idle), followed by a regular frame.
+    bool resized = false;
+    runner.Run("swapchain_resize", {{ "frames_in_flight", framesInFlight }, { "images", imageCount }}, 1.0, "resizes/s", [&]() {
+        resized = !resized;
+        window.SetHeadlessFrameBufferSize((resized)? width / 2 : width, (resized)? height / 2 : height);
+        presentFrame();
+    });
+
+    vkdevice.DeviceWaitIdle();
+}
+
+int main(int argc, char* argv[]) {
+    std::string outputPath = "tinyvk_bench.json";
+    TinyVkBenchRunner runner;
+    bool quick = false;
+
+    for(int i = 1; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--output" && i + 1 < argc) { outputPath = argv[++i]; }
+        else if (arg == "--filter" && i + 1 < argc) { runner.filter = argv[++i]; }
+        else if (arg == "--min-time" && i + 1 < argc) { runner.minSeconds = std::stod(argv[++i]); }
+        else if (arg == "--quick") { quick = true; runner.minSeconds = 0.1; }
+        else {
+            std::cerr << "usage: tinyvk_bench [--output file.json] [--filter name] [--min-time seconds] [--quick]" << std::endl;
+            return EXIT_FAILURE;
+        }
+    }
+
+    try {
+        TinyVkVulkanDevice vkdevice("TinyVulkan Benchmarks", true, benchDeviceTypes, VK_NULL_HANDLE);
+        VkPhysicalDeviceProperties properties;
+        vkGetPhysicalDeviceProperties(vkdevice.GetPhysicalDevice(), &properties);
+        std::cout << "TinyVulkan: Benchmarking on " << properties.deviceName << " [" << TINYVK_BENCH_GIT_COMMIT << "]" << std::endl;
+
+        TinyVkCommandPool commandPool(vkdevice, false);
+        TinyVkGraphicsPipeline pipeline(vkdevice, vertexDescription, defaultShaders, pushDescriptorLayouts, {}, false);
+        TinyVkRenderContext renderContext(vkdevice, commandPool, pipeline);
+
+        BenchStageBufferData(runner, renderContext, quick);
+        BenchStageImageData(runner, renderContext, quick);
+        BenchCommandBufferLease(runner, vkdevice);
+        BenchRenderExecute(runner, vkdevice, pipeline, quick);
+        BenchComputeExecute(runner, vkdevice, quick);
+
+        try {
+            BenchSwapchainPresent(runner);
+        } catch (TinyVkRuntimeError& err) {
+            std::cerr << "TinyVulkan: Skipping swapchain benchmarks: " << err.what() << std::endl;
+        }
+
+        std::ofstream file(outputPath, std::ios::out | std::ios::trunc);
+        file << ExportJson(vkdevice, runner);
+        if (!file.good()) {
+            std::cerr << "TinyVulkan: Failed to write benchmark results to " << outputPath << std::endl;
+            return EXIT_FAILURE;
+        }
+        std::cout << "TinyVulkan: Wrote " << runner.results.size() << " benchmark results to " << outputPath << std::endl;
+    } catch (TinyVkRuntimeError& err) {
+        std::cerr << err.what() << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
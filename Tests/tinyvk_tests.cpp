@@ -0,0 +1,332 @@
+/*
+    TINYVULKAN TESTS:
+        Headless unit tests of TinyVulkan's CPU-side logic: no instance, device, window or ICD is created, so they run on
+        machines without a GPU or Vulkan driver (the loader is linked but never called).
+
+        tinyvk_tests [group...]
+            Runs the given test groups (default: all), returns EXIT_FAILURE if any check failed.
+
+        TEST GROUPS:
+            frame_graph         TinyVkFrameGraph::CullPasses() dependency ordering and TinyVkGraphAccess stage/layout resolution.
+            pipeline_cache      TinyVkVulkanDevice::QueryPipelineCacheCompatible() header validation against device properties.
+            pipeline_variant    TinyVkPipelineVariant hashing and equality (the pipeline variant map key).
+            render_stats        TinyVkRenderStats frame/total aggregation, active stats scopes and JSON/Prometheus export.
+*/
+#include "../TinyVulkan/TinyVulkan.hpp"
+#include <unordered_map>
+using namespace tinyvk;
+
+/// @brief Failed checks of the running test group.
+static int testFailures = 0;
+
+#define TINYVK_TEST_CHECK(condition) \
+    do { \
+        if (!(condition)) { \
+            testFailures ++; \
+            std::cerr << "TinyVulkan: " << __FILE__ << ":" << __LINE__ << ": check failed: " << #condition << std::endl; \
+        } \
+    } while(false)
+
+#pragma region FRAME_GRAPH
+
+/// @brief Culls the passes against the given output (imported/MarkOutput) resources and deletes them, returns each pass' culled flag.
+std::vector<bool> CullPasses(const std::vector<TinyVkGraphPass*>& passes, const std::vector<bool>& outputs) {
+    TinyVkFrameGraph::CullPasses(passes, outputs);
+
+    std::vector<bool> culled;
+    for(TinyVkGraphPass* pass : passes) {
+        culled.push_back(pass->culled);
+        delete pass;
+    }
+    return culled;
+}
+
+void TestFrameGraph() {
+    const TinyVkGraphResource transient = 0, imported = 1, unused = 2;
+    const std::vector<bool> outputs = { false, true, false };
+
+    // Passes only contribute through the resources they write: the unused chain is culled, the producer of a read transient is kept.
+    {
+        TinyVkGraphPass* gbuffer = new TinyVkGraphPass("gbuffer");
+        gbuffer->Write(transient, TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT);
+        TinyVkGraphPass* debug = new TinyVkGraphPass("debug");
+        debug->Write(unused, TinyVkGraphUsage::TINYVK_GRAPH_STORAGE);
+        TinyVkGraphPass* lighting = new TinyVkGraphPass("lighting");
+        lighting->Read(transient, TinyVkGraphUsage::TINYVK_GRAPH_SAMPLED).Write(imported, TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT);
+
+        std::vector<bool> culled = CullPasses({ gbuffer, debug, lighting }, outputs);
+        TINYVK_TEST_CHECK(culled == std::vector<bool>({ false, true, false }));
+    }
+
+    // A pass depends on the most recent earlier writer: a loaded write keeps every earlier writer, a cleared write none.
+    {
+        TinyVkGraphPass* first = new TinyVkGraphPass("first");
+        first->Write(transient, TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT);
+        TinyVkGraphPass* second = new TinyVkGraphPass("second");
+        second->Write(transient, TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT);
+        TinyVkGraphPass* resolve = new TinyVkGraphPass("resolve");
+        resolve->Read(transient, TinyVkGraphUsage::TINYVK_GRAPH_TRANSFER_SRC).Write(imported, TinyVkGraphUsage::TINYVK_GRAPH_TRANSFER_DST);
+
+        std::vector<bool> culled = CullPasses({ first, second, resolve }, outputs);
+        TINYVK_TEST_CHECK(culled == std::vector<bool>({ false, false, false }));
+    }
+    {
+        TinyVkGraphPass* first = new TinyVkGraphPass("first");
+        first->Write(transient, TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT);
+        TinyVkGraphPass* cleared = new TinyVkGraphPass("cleared");
+        cleared->Write(transient, TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT, VkClearValue { .color = { { 0.0f, 0.0f, 0.0f, 1.0f } } });
+        TinyVkGraphPass* resolve = new TinyVkGraphPass("resolve");
+        resolve->Read(transient, TinyVkGraphUsage::TINYVK_GRAPH_SAMPLED).Write(imported, TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT);
+
+        std::vector<bool> culled = CullPasses({ first, cleared, resolve }, outputs);
+        TINYVK_TEST_CHECK(culled == std::vector<bool>({ true, false, false }));
+    }
+
+    // Writers declared after a reader are not its dependencies (passes run in declaration order), side effect passes are always kept.
+    {
+        TinyVkGraphPass* reader = new TinyVkGraphPass("reader");
+        reader->Read(transient, TinyVkGraphUsage::TINYVK_GRAPH_SAMPLED).Write(unused, TinyVkGraphUsage::TINYVK_GRAPH_STORAGE);
+        TinyVkGraphPass* writer = new TinyVkGraphPass("writer");
+        writer->Write(transient, TinyVkGraphUsage::TINYVK_GRAPH_STORAGE);
+        TinyVkGraphPass* readback = new TinyVkGraphPass("readback");
+        readback->Read(unused, TinyVkGraphUsage::TINYVK_GRAPH_TRANSFER_SRC).SideEffects();
+
+        std::vector<bool> culled = CullPasses({ reader, writer, readback }, outputs);
+        TINYVK_TEST_CHECK(culled == std::vector<bool>({ false, true, false }));
+    }
+
+    // Accesses resolve their synchronization2 stage/access masks and image layout from the usage.
+    TinyVkGraphAccess colorWrite(transient, TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT, true);
+    TINYVK_TEST_CHECK(colorWrite.IsAttachment());
+    TINYVK_TEST_CHECK(colorWrite.layout == VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL);
+    TINYVK_TEST_CHECK(colorWrite.stageMask == VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+    TINYVK_TEST_CHECK((colorWrite.accessMask & VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT) != 0);
+
+    TinyVkGraphAccess sampledRead(transient, TinyVkGraphUsage::TINYVK_GRAPH_SAMPLED, false);
+    TINYVK_TEST_CHECK(!sampledRead.IsAttachment());
+    TINYVK_TEST_CHECK(sampledRead.layout == VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+    TINYVK_TEST_CHECK(sampledRead.accessMask == VK_ACCESS_2_SHADER_SAMPLED_READ_BIT);
+
+    TinyVkGraphAccess storageRead(transient, TinyVkGraphUsage::TINYVK_GRAPH_STORAGE, false);
+    TINYVK_TEST_CHECK(storageRead.layout == VK_IMAGE_LAYOUT_GENERAL);
+    TINYVK_TEST_CHECK((storageRead.accessMask & VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT) == 0);
+
+    TinyVkGraphAccess indirectRead(imported, TinyVkGraphUsage::TINYVK_GRAPH_INDIRECT, false);
+    TINYVK_TEST_CHECK(indirectRead.stageMask == VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT);
+    TINYVK_TEST_CHECK(indirectRead.layout == VK_IMAGE_LAYOUT_UNDEFINED);
+}
+
+#pragma endregion
+#pragma region PIPELINE_CACHE
+
+/// @brief Returns pipeline cache data with a version one header for the properties, followed by dataSize bytes of driver data.
+std::vector<char> MakePipelineCacheData(const VkPhysicalDeviceProperties& properties, size_t dataSize = 64) {
+    VkPipelineCacheHeaderVersionOne header {};
+    header.headerSize = sizeof(VkPipelineCacheHeaderVersionOne);
+    header.headerVersion = VK_PIPELINE_CACHE_HEADER_VERSION_ONE;
+    header.vendorID = properties.vendorID;
+    header.deviceID = properties.deviceID;
+    std::memcpy(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE);
+
+    std::vector<char> cacheData(sizeof(VkPipelineCacheHeaderVersionOne) + dataSize, 0);
+    std::memcpy(cacheData.data(), &header, sizeof(VkPipelineCacheHeaderVersionOne));
+    return cacheData;
+}
+
+void TestPipelineCache() {
+    VkPhysicalDeviceProperties properties {};
+    properties.vendorID = 0x10DE;
+    properties.deviceID = 0x2684;
+    for(uint32_t i = 0; i < VK_UUID_SIZE; i++) properties.pipelineCacheUUID[i] = static_cast<uint8_t>(i * 7 + 1);
+
+    const std::vector<char> cacheData = MakePipelineCacheData(properties);
+    TINYVK_TEST_CHECK(TinyVkVulkanDevice::QueryPipelineCacheCompatible(cacheData, properties));
+    TINYVK_TEST_CHECK(TinyVkVulkanDevice::QueryPipelineCacheCompatible(MakePipelineCacheData(properties, 0), properties));
+
+    // Empty and truncated files (shorter than the header) are rejected.
+    TINYVK_TEST_CHECK(!TinyVkVulkanDevice::QueryPipelineCacheCompatible({}, properties));
+    TINYVK_TEST_CHECK(!TinyVkVulkanDevice::QueryPipelineCacheCompatible(std::vector<char>(cacheData.begin(), cacheData.begin() + sizeof(VkPipelineCacheHeaderVersionOne) - 1), properties));
+
+    // Caches of another vendor, device or driver (pipelineCacheUUID) are stale.
+    VkPhysicalDeviceProperties otherDevice = properties;
+    otherDevice.vendorID = 0x1002;
+    TINYVK_TEST_CHECK(!TinyVkVulkanDevice::QueryPipelineCacheCompatible(cacheData, otherDevice));
+    otherDevice = properties;
+    otherDevice.deviceID ++;
+    TINYVK_TEST_CHECK(!TinyVkVulkanDevice::QueryPipelineCacheCompatible(cacheData, otherDevice));
+    otherDevice = properties;
+    otherDevice.pipelineCacheUUID[VK_UUID_SIZE - 1] ^= 0xFF;
+    TINYVK_TEST_CHECK(!TinyVkVulkanDevice::QueryPipelineCacheCompatible(cacheData, otherDevice));
+
+    // Corrupt headers: unknown header version, header size smaller than version one or larger than the file.
+    VkPipelineCacheHeaderVersionOne header {};
+    std::memcpy(&header, cacheData.data(), sizeof(VkPipelineCacheHeaderVersionOne));
+    auto withHeader = [&cacheData](const VkPipelineCacheHeaderVersionOne& header) {
+        std::vector<char> corrupt = cacheData;
+        std::memcpy(corrupt.data(), &header, sizeof(VkPipelineCacheHeaderVersionOne));
+        return corrupt;
+    };
+
+    VkPipelineCacheHeaderVersionOne corrupt = header;
+    corrupt.headerVersion = static_cast<VkPipelineCacheHeaderVersion>(2);
+    TINYVK_TEST_CHECK(!TinyVkVulkanDevice::QueryPipelineCacheCompatible(withHeader(corrupt), properties));
+    corrupt = header;
+    corrupt.headerSize = sizeof(VkPipelineCacheHeaderVersionOne) - 4;
+    TINYVK_TEST_CHECK(!TinyVkVulkanDevice::QueryPipelineCacheCompatible(withHeader(corrupt), properties));
+    corrupt = header;
+    corrupt.headerSize = static_cast<uint32_t>(cacheData.size() + 1);
+    TINYVK_TEST_CHECK(!TinyVkVulkanDevice::QueryPipelineCacheCompatible(withHeader(corrupt), properties));
+}
+
+#pragma endregion
+#pragma region PIPELINE_VARIANT
+
+void TestPipelineVariant() {
+    TinyVkPipelineVariantHash hasher;
+    TinyVkPipelineVariant base, same;
+    TINYVK_TEST_CHECK(base == same);
+    TINYVK_TEST_CHECK(hasher(base) == hasher(same));
+
+    // Every render state field takes part in equality (and for these changes the hash).
+    std::vector<std::pair<const char*, std::function<void(TinyVkPipelineVariant&)>>> changes = {
+        { "shaders", [](TinyVkPipelineVariant& v) { v.shaders = {{ VK_SHADER_STAGE_FRAGMENT_BIT, "Shaders/sprite_frag.spv" }}; } },
+        { "vertexBindings", [](TinyVkPipelineVariant& v) { v.vertexBindings = {{ 0, 32, VK_VERTEX_INPUT_RATE_VERTEX }}; } },
+        { "vertexAttributes", [](TinyVkPipelineVariant& v) { v.vertexAttributes = {{ 0, 0, VK_FORMAT_R32G32_SFLOAT, 0 }}; } },
+        { "topology", [](TinyVkPipelineVariant& v) { v.topology = VK_PRIMITIVE_TOPOLOGY_LINE_LIST; } },
+        { "polygonMode", [](TinyVkPipelineVariant& v) { v.polygonMode = VK_POLYGON_MODE_LINE; } },
+        { "cullMode", [](TinyVkPipelineVariant& v) { v.cullMode = VK_CULL_MODE_NONE; } },
+        { "frontFace", [](TinyVkPipelineVariant& v) { v.frontFace = VK_FRONT_FACE_COUNTER_CLOCKWISE; } },
+        { "blendEnable", [](TinyVkPipelineVariant& v) { v.blendState.blendEnable = VK_FALSE; } },
+        { "alphaBlendOp", [](TinyVkPipelineVariant& v) { v.blendState.alphaBlendOp = VK_BLEND_OP_MAX; } },
+        { "colorWriteMask", [](TinyVkPipelineVariant& v) { v.blendState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT; } },
+        { "primitiveRestart", [](TinyVkPipelineVariant& v) { v.primitiveRestart = VK_TRUE; } },
+        { "depthTest", [](TinyVkPipelineVariant& v) { v.depthTest = VK_TRUE; } },
+        { "depthWrite", [](TinyVkPipelineVariant& v) { v.depthWrite = VK_TRUE; } },
+        { "depthCompareOp", [](TinyVkPipelineVariant& v) { v.depthCompareOp = VK_COMPARE_OP_GREATER; } },
+        { "colorFormat", [](TinyVkPipelineVariant& v) { v.colorFormat = VK_FORMAT_R16G16B16A16_SFLOAT; } },
+        { "depthFormat", [](TinyVkPipelineVariant& v) { v.depthFormat = VK_FORMAT_D32_SFLOAT; } }
+    };
+
+    std::unordered_map<TinyVkPipelineVariant, size_t, TinyVkPipelineVariantHash> variants;
+    variants.emplace(base, 0);
+    for(size_t i = 0; i < changes.size(); i++) {
+        TinyVkPipelineVariant changed = base;
+        changes[i].second(changed);
+        if (changed == base || hasher(changed) == hasher(base))
+            std::cerr << "TinyVulkan: pipeline variant field not distinguished: " << changes[i].first << std::endl;
+        TINYVK_TEST_CHECK(!(changed == base));
+        TINYVK_TEST_CHECK(hasher(changed) != hasher(base));
+        TINYVK_TEST_CHECK(variants.emplace(changed, i + 1).second);
+    }
+    TINYVK_TEST_CHECK(variants.size() == changes.size() + 1);
+
+    // Equal variants built separately (e.g. per draw) find the existing map entry.
+    TinyVkPipelineVariant lookup;
+    lookup.blendState.colorWriteMask = VK_COLOR_COMPONENT_R_BIT;
+    TINYVK_TEST_CHECK(variants.find(lookup) != variants.end());
+    TINYVK_TEST_CHECK(variants.find(base)->second == 0);
+
+    // Vertex descriptions compare by value and in declaration order.
+    TinyVkPipelineVariant twoBindings, swappedBindings;
+    twoBindings.vertexBindings = {{ 0, 16, VK_VERTEX_INPUT_RATE_VERTEX }, { 1, 64, VK_VERTEX_INPUT_RATE_INSTANCE }};
+    swappedBindings.vertexBindings = {{ 1, 64, VK_VERTEX_INPUT_RATE_INSTANCE }, { 0, 16, VK_VERTEX_INPUT_RATE_VERTEX }};
+    TINYVK_TEST_CHECK(!(twoBindings == swappedBindings));
+    swappedBindings.vertexBindings = twoBindings.vertexBindings;
+    TINYVK_TEST_CHECK(twoBindings == swappedBindings && hasher(twoBindings) == hasher(swappedBindings));
+}
+
+#pragma endregion
+#pragma region RENDER_STATS
+
+void TestRenderStats() {
+    TinyVkRenderStats stats("tinyvk_tests \"stats\"");
+    stats.RecordDraw(true, 6, 4);
+    stats.RecordDraw(false, 3, 1);
+    stats.RecordSubmit(2);
+    stats.RecordWait(1500);
+    stats.Add(TinyVkRenderCounter::TINYVK_COUNTER_BARRIERS, 3);
+
+    TinyVkRenderStatsSnapshot current = stats.GetCurrent();
+    TINYVK_TEST_CHECK(current.frames == 0);
+    TINYVK_TEST_CHECK(current.Get(TinyVkRenderCounter::TINYVK_COUNTER_DRAW_CALLS) == 2);
+    TINYVK_TEST_CHECK(current.Get(TinyVkRenderCounter::TINYVK_COUNTER_DRAWN_INDICES) == 24);
+    TINYVK_TEST_CHECK(current.Get(TinyVkRenderCounter::TINYVK_COUNTER_DRAWN_VERTICES) == 3);
+    TINYVK_TEST_CHECK(current.Get(TinyVkRenderCounter::TINYVK_COUNTER_COMMAND_BUFFERS) == 2);
+    TINYVK_TEST_CHECK(current.Get(TinyVkRenderCounter::TINYVK_COUNTER_WAIT_NS) == 1500);
+
+    // EndFrame moves the counters into the last frame snapshot and adds them to the totals.
+    stats.EndFrame();
+    TINYVK_TEST_CHECK(stats.GetCurrent().Get(TinyVkRenderCounter::TINYVK_COUNTER_DRAW_CALLS) == 0);
+    TINYVK_TEST_CHECK(stats.GetSnapshot().Get(TinyVkRenderCounter::TINYVK_COUNTER_BARRIERS) == 3);
+
+    stats.RecordDraw(false, 30, 2);
+    stats.EndFrame();
+    TinyVkRenderStatsSnapshot frame = stats.GetSnapshot(), totals = stats.GetTotals();
+    TINYVK_TEST_CHECK(frame.frames == 1 && totals.frames == 2);
+    TINYVK_TEST_CHECK(frame.Get(TinyVkRenderCounter::TINYVK_COUNTER_DRAW_CALLS) == 1);
+    TINYVK_TEST_CHECK(frame.Get(TinyVkRenderCounter::TINYVK_COUNTER_BARRIERS) == 0);
+    TINYVK_TEST_CHECK(totals.Get(TinyVkRenderCounter::TINYVK_COUNTER_DRAW_CALLS) == 3);
+    TINYVK_TEST_CHECK(totals.Get(TinyVkRenderCounter::TINYVK_COUNTER_DRAWN_VERTICES) == 63);
+    TINYVK_TEST_CHECK(totals.Get(TinyVkRenderCounter::TINYVK_COUNTER_SUBMITS) == 1);
+
+    // Scopes route the calling thread's Active() counters and restore the previous stats object.
+    TINYVK_TEST_CHECK(&TinyVkRenderStats::Active() == &TinyVkRenderStats::Global());
+    {
+        TinyVkRenderStatsScope scope(stats, true);
+        TINYVK_TEST_CHECK(&TinyVkRenderStats::Active() == &stats);
+        TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_DISPATCHES, 5);
+    }
+    TINYVK_TEST_CHECK(&TinyVkRenderStats::Active() == &TinyVkRenderStats::Global());
+    TINYVK_TEST_CHECK(stats.GetTotals().frames == 3);
+    TINYVK_TEST_CHECK(stats.GetSnapshot().Get(TinyVkRenderCounter::TINYVK_COUNTER_DISPATCHES) == 5);
+
+    // Exports contain every live stats object with escaped names.
+    std::string json = TinyVkRenderStats::ExportAll(TinyVkStatsFormat::TINYVK_STATS_JSON);
+    TINYVK_TEST_CHECK(json.find("\"name\":\"tinyvk_tests \\\"stats\\\"\"") != std::string::npos);
+    TINYVK_TEST_CHECK(json.find("\"frames\":3,\"frame\":{\"draw_calls\":0") != std::string::npos);
+    TINYVK_TEST_CHECK(json.find("\"total\":{\"draw_calls\":3,") != std::string::npos);
+
+    std::string prometheus = TinyVkRenderStats::ExportAll(TinyVkStatsFormat::TINYVK_STATS_PROMETHEUS);
+    TINYVK_TEST_CHECK(prometheus.find("# TYPE tinyvk_draw_calls_total counter\n") != std::string::npos);
+    TINYVK_TEST_CHECK(prometheus.find("tinyvk_drawn_vertices_total{renderer=\"tinyvk_tests \\\"stats\\\"\"") != std::string::npos);
+    TINYVK_TEST_CHECK(prometheus.find("tinyvk_frames_total{renderer=\"TinyVulkan\"") != std::string::npos);
+
+    stats.Reset();
+    TINYVK_TEST_CHECK(stats.GetTotals().frames == 0 && stats.GetTotals().Get(TinyVkRenderCounter::TINYVK_COUNTER_DRAW_CALLS) == 0);
+}
+
+#pragma endregion
+
+int main(int argc, char* argv[]) {
+    const std::vector<std::pair<std::string, std::function<void()>>> groups = {
+        { "frame_graph", TestFrameGraph },
+        { "pipeline_cache", TestPipelineCache },
+        { "pipeline_variant", TestPipelineVariant },
+        { "render_stats", TestRenderStats }
+    };
+
+    std::vector<std::string> selected(argv + 1, argv + argc);
+    for(const std::string& name : selected)
+        if (std::none_of(groups.begin(), groups.end(), [&name](auto& group) { return group.first == name; })) {
+            std::cerr << "usage: tinyvk_tests [frame_graph] [pipeline_cache] [pipeline_variant] [render_stats]" << std::endl;
+            return EXIT_FAILURE;
+        }
+
+    int failedGroups = 0;
+    for(const auto& group : groups) {
+        if (selected.size() > 0 && std::find(selected.begin(), selected.end(), group.first) == selected.end()) continue;
+
+        testFailures = 0;
+        try {
+            group.second();
+        } catch (std::exception& err) {
+            testFailures ++;
+            std::cerr << "TinyVulkan: " << group.first << " threw: " << err.what() << std::endl;
+        }
+
+        std::cout << "TinyVulkan: " << group.first << ((testFailures == 0)? " passed" : " FAILED") << std::endl;
+        if (testFailures > 0) failedGroups ++;
+    }
+
+    return (failedGroups == 0)? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,114 @@
+#pragma once
+#ifndef TINYVK_TINYVKBARRIERBATCH
+#define TINYVK_TINYVKBARRIERBATCH
+	#include "./TinyVulkan.hpp"
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT BARRIER BATCHES:
+				Every barrier keeps its own synchronization2 stage/access masks (no global OR of all source/destination
+				stages as with vkCmdPipelineBarrier), and all barriers collected before the next use of the resources are
+				recorded with a single vkCmdPipelineBarrier2. Barriers added twice for the same image/buffer before a
+				Flush() are merged: the source scope and old layout of the first and the new layout of the last are kept.
+		*/
+
+		/// @brief Collects image/buffer/memory barriers and records them with one vkCmdPipelineBarrier2.
+		class TinyVkBarrierBatch {
+		public:
+			std::vector<VkMemoryBarrier2> memoryBarriers;
+			std::vector<VkBufferMemoryBarrier2> bufferBarriers;
+			std::vector<VkImageMemoryBarrier2> imageBarriers;
+			VkDependencyFlags dependencyFlags = 0;
+
+			/// @brief Adds a global memory barrier.
+			TinyVkBarrierBatch& Memory(VkPipelineStageFlags2 srcStageMask, VkAccessFlags2 srcAccessMask, VkPipelineStageFlags2 dstStageMask, VkAccessFlags2 dstAccessMask) {
+				memoryBarriers.push_back(VkMemoryBarrier2 {
+					.sType = VK_STRUCTURE_TYPE_MEMORY_BARRIER_2,
+					.srcStageMask = srcStageMask, .srcAccessMask = srcAccessMask,
+					.dstStageMask = dstStageMask, .dstAccessMask = dstAccessMask
+				});
+				return (*this);
+			}
+
+			/// @brief Adds (or merges into a previous barrier for the same buffer) a buffer memory barrier.
+			TinyVkBarrierBatch& Add(const VkBufferMemoryBarrier2& barrier) {
+				for(VkBufferMemoryBarrier2& batched : bufferBarriers)
+					if (batched.buffer == barrier.buffer && batched.offset == barrier.offset && batched.size == barrier.size) {
+						batched.dstStageMask |= barrier.dstStageMask;
+						batched.dstAccessMask |= barrier.dstAccessMask;
+						return (*this);
+					}
+
+				bufferBarriers.push_back(barrier);
+				return (*this);
+			}
+
+			/// @brief Adds (or merges into a previous barrier for the same image) an image memory barrier.
+			TinyVkBarrierBatch& Add(const VkImageMemoryBarrier2& barrier) {
+				for(VkImageMemoryBarrier2& batched : imageBarriers)
+					if (batched.image == barrier.image && batched.subresourceRange.aspectMask == barrier.subresourceRange.aspectMask) {
+						batched.newLayout = barrier.newLayout;
+						batched.dstStageMask = barrier.dstStageMask;
+						batched.dstAccessMask = barrier.dstAccessMask;
+						return (*this);
+					}
+
+				imageBarriers.push_back(barrier);
+				return (*this);
+			}
+
+			/// @brief Adds a buffer memory barrier for the buffer range.
+			TinyVkBarrierBatch& Buffer(VkBuffer buffer, VkPipelineStageFlags2 srcStageMask, VkAccessFlags2 srcAccessMask, VkPipelineStageFlags2 dstStageMask, VkAccessFlags2 dstAccessMask, VkDeviceSize offset = 0, VkDeviceSize size = VK_WHOLE_SIZE) {
+				return Add(VkBufferMemoryBarrier2 {
+					.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+					.srcStageMask = srcStageMask, .srcAccessMask = srcAccessMask,
+					.dstStageMask = dstStageMask, .dstAccessMask = dstAccessMask,
+					.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED, .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.buffer = buffer, .offset = offset, .size = size
+				});
+			}
+
+			/// @brief Adds an image memory barrier (layout transition) for the first mip level/array layer of the image.
+			TinyVkBarrierBatch& Image(VkImage image, VkImageAspectFlags aspectMask, VkImageLayout oldLayout, VkImageLayout newLayout, VkPipelineStageFlags2 srcStageMask, VkAccessFlags2 srcAccessMask, VkPipelineStageFlags2 dstStageMask, VkAccessFlags2 dstAccessMask) {
+				return Add(VkImageMemoryBarrier2 {
+					.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+					.srcStageMask = srcStageMask, .srcAccessMask = srcAccessMask,
+					.dstStageMask = dstStageMask, .dstAccessMask = dstAccessMask,
+					.oldLayout = oldLayout, .newLayout = newLayout,
+					.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED, .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+					.image = image,
+					.subresourceRange = { .aspectMask = aspectMask, .baseMipLevel = 0, .levelCount = 1, .baseArrayLayer = 0, .layerCount = 1 }
+				});
+			}
+
+			/// @brief Returns the number of barriers waiting to be flushed.
+			size_t Count() { return memoryBarriers.size() + bufferBarriers.size() + imageBarriers.size(); }
+
+			/// @brief Returns true if there are no barriers waiting to be flushed.
+			bool IsEmpty() { return Count() == 0; }
+
+			/// @brief Removes all collected barriers without recording them.
+			void Clear() {
+				memoryBarriers.clear();
+				bufferBarriers.clear();
+				imageBarriers.clear();
+			}
+
+			/// @brief Records all collected barriers with a single vkCmdPipelineBarrier2 (no-op if empty) and clears the batch.
+			void Flush(VkCommandBuffer commandBuffer) {
+				if (IsEmpty()) return;
+
+				VkDependencyInfo dependencyInfo {
+					.sType = VK_STRUCTURE_TYPE_DEPENDENCY_INFO,
+					.dependencyFlags = dependencyFlags,
+					.memoryBarrierCount = static_cast<uint32_t>(memoryBarriers.size()), .pMemoryBarriers = memoryBarriers.data(),
+					.bufferMemoryBarrierCount = static_cast<uint32_t>(bufferBarriers.size()), .pBufferMemoryBarriers = bufferBarriers.data(),
+					.imageMemoryBarrierCount = static_cast<uint32_t>(imageBarriers.size()), .pImageMemoryBarriers = imageBarriers.data()
+				};
+				vkCmdPipelineBarrier2(commandBuffer, &dependencyInfo);
+				TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_BARRIERS, Count());
+				Clear();
+			}
+		};
+	}
+#endif
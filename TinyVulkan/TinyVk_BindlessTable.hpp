@@ -0,0 +1,237 @@
+#pragma once
+#ifndef TINYVK_TINYVKBINDLESSTABLE
+#define TINYVK_TINYVKBINDLESSTABLE
+	#include "./TinyVulkan.hpp"
+	#include <unordered_map>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT BINDLESS TEXTURES:
+				TinyVkBindlessTable is one persistent descriptor set holding a large partially bound, update-after-bind array of
+				sampled images (binding 0) and of their samplers (binding 1) using descriptor indexing (core in Vulkan 1.2, see
+				TinyVkVulkanDevice::IsDescriptorIndexingSupported()). Graphics pipelines created with a table bind it as set 1,
+				set 0 stays the push descriptor set, and TinyVkGraphicsRenderer::BeginRecordCmdBuffer() binds it once per
+				command buffer (it stays bound across pipeline variants).
+
+				TinyVkImage::RegisterBindless() writes an image into a free slot and returns its index, which stays stable until
+				the image is disposed or unregistered (re-created images are rewritten in place). Pass indices in push constants or
+				instance data so every draw sharing a pipeline can be batched into one instanced or indirect draw:
+					#extension GL_EXT_nonuniform_qualifier : require
+					layout(set = 1, binding = 0) uniform texture2D bindlessTextures[];
+					layout(set = 1, binding = 1) uniform sampler bindlessSamplers[];
+					texture(sampler2D(bindlessTextures[nonuniformEXT(index)], bindlessSamplers[nonuniformEXT(index)]), uv);
+
+				Slots are written while command buffers using the set may be pending (update-after-bind), a released slot is only
+				reused once the graphics queue's submissions made before its release complete. Images must be in the layout they
+				were registered with (default SHADER_READONLY) when sampled. Either the table or its images may be disposed first,
+				the table must outlive the graphics pipelines created with it.
+		*/
+
+		/// @brief Persistent descriptor indexed table of sampled images/samplers shared by graphics pipelines (bindless textures).
+		class TinyVkBindlessTable : public TinyVkDisposable {
+		private:
+			VkDescriptorSetLayout descriptorLayout = VK_NULL_HANDLE;
+			VkDescriptorPool descriptorPool = VK_NULL_HANDLE;
+			VkDescriptorSet descriptorSet = VK_NULL_HANDLE;
+			uint32_t capacity;
+
+			std::timed_mutex table_lock;
+			uint32_t slotCount = 0; /// Slots handed out so far (free slots below are reused first).
+			std::vector<uint32_t> freeSlots;
+			std::vector<std::pair<TinyVkTimelinePoint, uint32_t>> retiredSlots;
+			std::unordered_map<uint32_t, std::function<void()>> slotDetach; /// Invoked on the slot's owner if the table is disposed first.
+
+			/// @brief Clamps the requested capacity to the device's update-after-bind sampled image/sampler limits.
+			uint32_t QueryCapacity(uint32_t requested) {
+				VkPhysicalDeviceVulkan12Properties vulkan12Properties{};
+				vulkan12Properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_PROPERTIES;
+				VkPhysicalDeviceProperties2 properties{};
+				properties.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2;
+				properties.pNext = &vulkan12Properties;
+				vkGetPhysicalDeviceProperties2(vkdevice.GetPhysicalDevice(), &properties);
+
+				return std::min({ requested, vulkan12Properties.maxDescriptorSetUpdateAfterBindSampledImages, vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSampledImages,
+					vulkan12Properties.maxDescriptorSetUpdateAfterBindSamplers, vulkan12Properties.maxPerStageDescriptorUpdateAfterBindSamplers, vulkan12Properties.maxPerStageUpdateAfterBindResources / 2 });
+			}
+
+			void CreateDescriptorSet() {
+				std::array<VkDescriptorSetLayoutBinding, 2> layoutBindings = {
+					VkDescriptorSetLayoutBinding { 0, VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, capacity, VK_SHADER_STAGE_ALL_GRAPHICS, VK_NULL_HANDLE },
+					VkDescriptorSetLayoutBinding { 1, VK_DESCRIPTOR_TYPE_SAMPLER, capacity, VK_SHADER_STAGE_ALL_GRAPHICS, VK_NULL_HANDLE }
+				};
+				VkDescriptorBindingFlags bindingFlags = VK_DESCRIPTOR_BINDING_PARTIALLY_BOUND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_AFTER_BIND_BIT | VK_DESCRIPTOR_BINDING_UPDATE_UNUSED_WHILE_PENDING_BIT;
+				std::array<VkDescriptorBindingFlags, 2> layoutBindingFlags = { bindingFlags, bindingFlags };
+
+				VkDescriptorSetLayoutBindingFlagsCreateInfo bindingFlagsInfo{};
+				bindingFlagsInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_BINDING_FLAGS_CREATE_INFO;
+				bindingFlagsInfo.bindingCount = static_cast<uint32_t>(layoutBindingFlags.size());
+				bindingFlagsInfo.pBindingFlags = layoutBindingFlags.data();
+
+				VkDescriptorSetLayoutCreateInfo layoutCreateInfo{};
+				layoutCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
+				layoutCreateInfo.pNext = &bindingFlagsInfo;
+				layoutCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_UPDATE_AFTER_BIND_POOL_BIT;
+				layoutCreateInfo.bindingCount = static_cast<uint32_t>(layoutBindings.size());
+				layoutCreateInfo.pBindings = layoutBindings.data();
+
+				if (vkCreateDescriptorSetLayout(vkdevice.GetLogicalDevice(), &layoutCreateInfo, VK_NULL_HANDLE, &descriptorLayout) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to create bindless descriptor set layout!");
+
+				std::array<VkDescriptorPoolSize, 2> poolSizes = {
+					VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE, capacity },
+					VkDescriptorPoolSize { VK_DESCRIPTOR_TYPE_SAMPLER, capacity }
+				};
+
+				VkDescriptorPoolCreateInfo poolCreateInfo{};
+				poolCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_POOL_CREATE_INFO;
+				poolCreateInfo.flags = VK_DESCRIPTOR_POOL_CREATE_UPDATE_AFTER_BIND_BIT;
+				poolCreateInfo.maxSets = 1;
+				poolCreateInfo.poolSizeCount = static_cast<uint32_t>(poolSizes.size());
+				poolCreateInfo.pPoolSizes = poolSizes.data();
+
+				if (vkCreateDescriptorPool(vkdevice.GetLogicalDevice(), &poolCreateInfo, VK_NULL_HANDLE, &descriptorPool) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to create bindless descriptor pool!");
+
+				VkDescriptorSetAllocateInfo allocateInfo{};
+				allocateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_ALLOCATE_INFO;
+				allocateInfo.descriptorPool = descriptorPool;
+				allocateInfo.descriptorSetCount = 1;
+				allocateInfo.pSetLayouts = &descriptorLayout;
+
+				if (vkAllocateDescriptorSets(vkdevice.GetLogicalDevice(), &allocateInfo, &descriptorSet) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to allocate bindless descriptor set!");
+			}
+
+			/// @brief Writes the image view and sampler descriptors of a slot.
+			void WriteSlot(uint32_t index, VkImageView imageView, VkSampler imageSampler, VkImageLayout imageLayout) {
+				VkDescriptorImageInfo imageInfo = { VK_NULL_HANDLE, imageView, imageLayout };
+				VkDescriptorImageInfo samplerInfo = { imageSampler, VK_NULL_HANDLE, VK_IMAGE_LAYOUT_UNDEFINED };
+
+				std::array<VkWriteDescriptorSet, 2> writeDescriptorSets{};
+				for(VkWriteDescriptorSet& write : writeDescriptorSets) {
+					write.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
+					write.dstSet = descriptorSet;
+					write.dstArrayElement = index;
+					write.descriptorCount = 1;
+				}
+				writeDescriptorSets[0].dstBinding = 0;
+				writeDescriptorSets[0].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+				writeDescriptorSets[0].pImageInfo = &imageInfo;
+				writeDescriptorSets[1].dstBinding = 1;
+				writeDescriptorSets[1].descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER;
+				writeDescriptorSets[1].pImageInfo = &samplerInfo;
+				vkUpdateDescriptorSets(vkdevice.GetLogicalDevice(), static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data(), 0, VK_NULL_HANDLE);
+			}
+
+			/// @brief Returns a free slot, reclaiming released slots whose last possible use has completed (table_lock must be held).
+			uint32_t AcquireSlot() {
+				std::erase_if(retiredSlots, [this](std::pair<TinyVkTimelinePoint, uint32_t>& retired) {
+					if (!retired.first.IsComplete()) return false;
+					freeSlots.push_back(retired.second);
+					return true;
+				});
+
+				if (!freeSlots.empty()) {
+					uint32_t index = freeSlots.back();
+					freeSlots.pop_back();
+					return index;
+				}
+
+				if (slotCount >= capacity)
+					throw TinyVkRuntimeError("TinyVulkan: TinyVkBindlessTable is full (" + std::to_string(capacity) + " images)!");
+				return slotCount++;
+			}
+
+		public:
+			/// @brief Descriptor set index of the table in the pipeline layouts created with it (set 0 is the push descriptor set).
+			inline static const uint32_t descriptorSetIndex = 1;
+
+			TinyVkVulkanDevice& vkdevice;
+
+			TinyVkBindlessTable operator=(const TinyVkBindlessTable& table) = delete;
+
+			~TinyVkBindlessTable() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				std::vector<std::function<void()>> detaches;
+				{
+					timed_guard<false> tableLock(table_lock);
+					for(auto& detach : slotDetach) if (detach.second) detaches.push_back(detach.second);
+					slotDetach.clear();
+				}
+				for(auto& detach : detaches) detach();
+
+				if (waitIdle) vkdevice.DeviceWaitIdle();
+
+				VkDevice logicalDevice = vkdevice.GetLogicalDevice();
+				VkDescriptorPool descriptorPool = this->descriptorPool;
+				VkDescriptorSetLayout descriptorLayout = this->descriptorLayout;
+				vkdevice.RetireResource(vkdevice.GetGraphicsTimeline().GetSubmittedPoint(), [logicalDevice, descriptorPool, descriptorLayout]() {
+					vkDestroyDescriptorPool(logicalDevice, descriptorPool, VK_NULL_HANDLE);
+					vkDestroyDescriptorSetLayout(logicalDevice, descriptorLayout, VK_NULL_HANDLE);
+				});
+			}
+
+			/// @brief Creates the bindless descriptor set with room for maxImages images (clamped to the device's update-after-bind limits).
+			TinyVkBindlessTable(TinyVkVulkanDevice& vkdevice, uint32_t maxImages = 16384) : vkdevice(vkdevice) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				if (!vkdevice.IsDescriptorIndexingSupported())
+					throw TinyVkRuntimeError("TinyVulkan: TinyVkBindlessTable requires descriptor indexing (partially bound, update-after-bind sampled image arrays)!");
+
+				capacity = QueryCapacity(maxImages);
+				CreateDescriptorSet();
+				SetDebugName("TinyVkBindlessTable");
+			}
+
+			/// @brief Names the descriptor set, its layout and pool in validation messages and GPU captures (VK_EXT_debug_utils, compiled out in release).
+			void SetDebugName(const std::string& name) {
+				#if TVK_DEBUG_UTILS
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_DESCRIPTOR_SET, descriptorSet, name + "::DescriptorSet");
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, descriptorLayout, name + "::DescriptorSetLayout");
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_DESCRIPTOR_POOL, descriptorPool, name + "::DescriptorPool");
+				#endif
+			}
+
+			/// @brief Writes an image view/sampler into a free slot and returns its index, tableDetach is invoked if the table is disposed first (use TinyVkImage::RegisterBindless()).
+			uint32_t RegisterImage(VkImageView imageView, VkSampler imageSampler, VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, std::function<void()> tableDetach = nullptr) {
+				timed_guard<false> tableLock(table_lock);
+				uint32_t index = AcquireSlot();
+				WriteSlot(index, imageView, imageSampler, imageLayout);
+				slotDetach[index] = tableDetach;
+				return index;
+			}
+
+			/// @brief Rewrites the image view/sampler of a registered slot (e.g. after the image was re-created), the slot must not be in use by pending draws.
+			void UpdateImage(uint32_t index, VkImageView imageView, VkSampler imageSampler, VkImageLayout imageLayout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL) {
+				timed_guard<false> tableLock(table_lock);
+				WriteSlot(index, imageView, imageSampler, imageLayout);
+			}
+
+			/// @brief Releases a slot, it is reused once the graphics queue's submissions made so far complete.
+			void ReleaseImage(uint32_t index) {
+				TinyVkTimelinePoint lastUse = vkdevice.GetGraphicsTimeline().GetSubmittedPoint();
+				timed_guard<false> tableLock(table_lock);
+				slotDetach.erase(index);
+				retiredSlots.push_back(std::pair(lastUse, index));
+			}
+
+			/// @brief Binds the table as set 1 of a pipeline layout created with it (stays bound across pipelines with compatible layouts).
+			void CmdBindDescriptorSet(VkCommandBuffer cmdBuffer, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout) {
+				vkCmdBindDescriptorSets(cmdBuffer, bindPoint, pipelineLayout, descriptorSetIndex, 1, &descriptorSet, 0, VK_NULL_HANDLE);
+			}
+
+			VkDescriptorSetLayout GetDescriptorLayout() { return descriptorLayout; }
+			VkDescriptorSet GetDescriptorSet() { return descriptorSet; }
+
+			/// @brief Returns the maximum number of images the table can hold.
+			uint32_t GetCapacity() { return capacity; }
+
+			/// @brief Returns the number of registered images.
+			uint32_t GetImageCount() {
+				timed_guard<false> tableLock(table_lock);
+				return static_cast<uint32_t>(slotDetach.size());
+			}
+		};
+	}
+#endif
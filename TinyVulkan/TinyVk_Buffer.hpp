@@ -12,7 +12,7 @@
 				There are 3 types of GPU dedicated memory buffers:
 					Vertex:		Allows you to send mesh triangle data to the GPU.
 					Index:		Allws you to send mapped indices for vertex buffers to the GPU.
-					Uniform:	Allows you to send data to shaders using uniforms.
+					Uniform:	Allows you to send data to shaders using uniforms (host mapped, see WriteMappedData/TinyVkUniformBlock).
 						* Push Constants are an alternative that do not require buffers, simply use: vkCmdPushConstants(...).
 
 				The last buffer type is a CPU memory buffer for transfering data from the CPU to the GPU:
@@ -58,23 +58,26 @@
 			VmaAllocation memory = VK_NULL_HANDLE;
 			VmaAllocationInfo description;
 			VkDeviceSize size;
-			VkFence bufferWaitable;
+			TinyVkTimelinePoint lastUse; /// Timeline point of the last submission using this buffer.
 
 			/// @brief Deleted copy constructor (dynamic objects are not copyable).
 			TinyVkBuffer operator=(const TinyVkBuffer& buffer) = delete;
 			
 			~TinyVkBuffer() { this->Dispose(); }
 
+			/// @brief Destroys the buffer after its last use: waits on the CPU (waitIdle) or retires it to the TinyVkVulkanDevice.
 			void Disposable(bool waitIdle) {
-				if (waitIdle) renderContext.vkdevice.DeviceWaitIdle();
+				if (waitIdle) lastUse.Wait(UINT64_MAX, "TinyVkBuffer::Disposable");
 
-				vmaDestroyBuffer(renderContext.vkdevice.GetAllocator(), buffer, memory);
-				vkDestroyFence(renderContext.vkdevice.GetLogicalDevice(), bufferWaitable, VK_NULL_HANDLE);
+				VmaAllocator allocator = renderContext.vkdevice.GetAllocator();
+				VkBuffer buffer = this->buffer;
+				VmaAllocation memory = this->memory;
+				renderContext.vkdevice.RetireResource(lastUse, [allocator, buffer, memory]() { vmaDestroyBuffer(allocator, buffer, memory); });
 			}
 
 			/// @brief Creates a VkBuffer of the specified size in bytes with auto-set memory allocation properties by TinyVkBufferType.
 			TinyVkBuffer(TinyVkRenderContext& renderContext, VkDeviceSize dataSize, TinyVkBufferType type)
-			: renderContext(renderContext), size(dataSize), bufferType(bufferType) {
+			: renderContext(renderContext), size(dataSize), bufferType(type) {
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
 
 				switch (type) {
@@ -85,7 +88,7 @@
 					CreateBuffer(size, VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT);
 					break;
 					case TinyVkBufferType::TINYVK_BUFFER_TYPE_UNIFORM:
-					CreateBuffer(size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT);
+					CreateBuffer(size, VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_ALLOCATION_CREATE_HOST_ACCESS_SEQUENTIAL_WRITE_BIT | VMA_ALLOCATION_CREATE_MAPPED_BIT);
 					break;
 					case TinyVkBufferType::TINYVK_BUFFER_TYPE_INDIRECT:
 					CreateBuffer(size, VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT, VMA_ALLOCATION_CREATE_DEDICATED_MEMORY_BIT);
@@ -99,12 +102,15 @@
 					break;
 				}
 
-				VkFenceCreateInfo fenceInfo{};
-				fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-				fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
+				#if TVK_DEBUG_UTILS
+					static const char* typeNames[] = { "VERTEX", "INDEX", "UNIFORM", "INDIRECT", "STAGING", "STORAGE" };
+					SetDebugName("TinyVkBuffer[" + std::string(typeNames[static_cast<size_t>(type)]) + ", " + std::to_string(size) + " bytes]");
+				#endif
+			}
 
-				if (vkCreateFence(renderContext.vkdevice.GetLogicalDevice(), &fenceInfo, VK_NULL_HANDLE, &bufferWaitable) != VK_SUCCESS)
-					throw TinyVkRuntimeError("TinyVulkan: Failed to create synchronization objects for TinyVkBuffer!");
+			/// @brief Names the VkBuffer in validation messages and GPU captures (VK_EXT_debug_utils, compiled out in release).
+			void SetDebugName(const std::string& name) {
+				TinyVkDebugUtils::SetObjectName(renderContext.vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_BUFFER, buffer, name);
 			}
 
 			/// @brief Begins a transfer command and returns the command buffer index pair used for the command allocated from a TinyVkCommandPool.
@@ -115,26 +121,40 @@
 				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 				vkBeginCommandBuffer(bufferIndexPair.first, &beginInfo);
+				if (renderContext.gpuProfiler != nullptr) renderContext.gpuProfiler->BeginScope(bufferIndexPair.first, "TinyVkBuffer::Transfer");
+
+				// Earlier submissions on the queue which still use the transferred resources finish before the copy (replaces the CPU wait on lastUse).
+				TinyVkBarrierBatch barrierBatch;
+				barrierBatch.Memory(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT,
+					VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT);
+				barrierBatch.Flush(bufferIndexPair.first);
 				return bufferIndexPair;
 			}
 
-			/// @brief Ends a transfer command and gives the leased/rented command buffer pair back to the TinyVkCommandPool.
-			void EndTransferCmd(std::pair<VkCommandBuffer, int32_t> bufferIndexPair) {
-				vkEndCommandBuffer(bufferIndexPair.first);
+			/// @brief Ends a transfer command, submits it to the graphics timeline (collected by an active TinyVkSubmissionBatch) and
+			/// retires the command buffer to the returned timeline point, the CPU does not wait (wait on lastUse before reading back).
+			/// Pass the waits of resources last used on another queue (see TinyVkTimeline::AddWait()), the GPU waits on those instead.
+			TinyVkTimelinePoint EndTransferCmd(std::pair<VkCommandBuffer, int32_t> bufferIndexPair, const std::vector<TinyVkSemaphoreWait>& waits = {}) {
+				// Transfer writes are made visible to every later submission on the queue and to host reads of the timeline point.
+				TinyVkBarrierBatch barrierBatch;
+				barrierBatch.Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+					VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT | VK_ACCESS_2_HOST_READ_BIT);
+				barrierBatch.Flush(bufferIndexPair.first);
 
-				VkSubmitInfo submitInfo{};
-				submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-				submitInfo.commandBufferCount = 1;
-				submitInfo.pCommandBuffers = &bufferIndexPair.first;
+				if (renderContext.gpuProfiler != nullptr) renderContext.gpuProfiler->EndScope(bufferIndexPair.first);
+				vkEndCommandBuffer(bufferIndexPair.first);
 
-				vkQueueSubmit(renderContext.graphicsPipeline.GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
-				vkQueueWaitIdle(renderContext.graphicsPipeline.GetGraphicsQueue());
-				vkResetCommandBuffer(bufferIndexPair.first, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
-				renderContext.commandPool.ReturnBuffer(bufferIndexPair);
+				TINYVK_TRACE_SCOPE_CATEGORY("TinyVkBuffer::EndTransferCmd", "tinyvk");
+				lastUse = renderContext.vkdevice.GetGraphicsTimeline().Submit({ bufferIndexPair.first }, waits);
+				renderContext.commandPool.RetireBuffer(bufferIndexPair, lastUse);
+				return lastUse;
 			}
 
 			/// @brief Copies data from the source TinyVkBuffer into this TinyVkBuffer.
 			void TransferBufferCmd(TinyVkRenderContext& renderContext, TinyVkBuffer& srcBuffer, TinyVkBuffer& dstBuffer, VkDeviceSize dataSize, VkDeviceSize srceOffset = 0, VkDeviceSize destOffset = 0) {
+				std::vector<TinyVkSemaphoreWait> waits;
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, srcBuffer.lastUse, VK_PIPELINE_STAGE_2_TRANSFER_BIT);
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, dstBuffer.lastUse, VK_PIPELINE_STAGE_2_TRANSFER_BIT);
 				std::pair<VkCommandBuffer,int32_t> bufferIndexPair = BeginTransferCmd();
 
 				VkBufferCopy copyRegion{};
@@ -142,8 +162,10 @@
 				copyRegion.dstOffset = destOffset;
 				copyRegion.size = dataSize;
 				vkCmdCopyBuffer(bufferIndexPair.first, srcBuffer.buffer, dstBuffer.buffer, 1, &copyRegion);
+				if (srcBuffer.bufferType == TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING) TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_BYTES_UPLOADED, dataSize);
+				if (dstBuffer.bufferType == TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING) TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_BYTES_READ_BACK, dataSize);
 
-				EndTransferCmd(bufferIndexPair);
+				srcBuffer.lastUse = dstBuffer.lastUse = EndTransferCmd(bufferIndexPair, waits);
 			}
 			
 			/// @brief Copies data from CPU accessible memory to GPU accessible memory for a list of buffers.
@@ -158,6 +180,7 @@
 					VkDeviceSize srcOffset = std::get<3>(staging);
 					VkDeviceSize dstOffset = std::get<4>(staging);
 					memcpy(buffer.description.pMappedData, memory, (size_t)size);
+					TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_BYTES_UPLOADED, size);
 				}
 
 				EndTransferCmd(bufferIndexPair);
@@ -165,117 +188,109 @@
 
 			/// @brief Copies data from CPU accessible memory to GPU accessible memory.
 			void StageBufferData(void* data, VkDeviceSize dataSize, VkDeviceSize srcOffset = 0, VkDeviceSize dstOffset = 0) {
-				TinyVkBuffer stagingBuffer = TinyVkBuffer(renderContext, dataSize, TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING);
-				memcpy(stagingBuffer.description.pMappedData, data, (size_t)dataSize);
-				TransferBufferCmd(renderContext, stagingBuffer, *this, size, srcOffset, dstOffset);
-				stagingBuffer.Dispose();
+				TinyVkBuffer* stagingBuffer = new TinyVkBuffer(renderContext, dataSize, TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING);
+				memcpy(stagingBuffer->description.pMappedData, data, (size_t)dataSize);
+				TransferBufferCmd(renderContext, *stagingBuffer, *this, dataSize, srcOffset, dstOffset);
+				renderContext.vkdevice.RetireResource(stagingBuffer->lastUse, [stagingBuffer]() { delete stagingBuffer; });
+			}
+
+			/// @brief Copies data straight into the buffer's persistently mapped memory (uniform/staging buffers), the range must not be read by pending GPU work.
+			void WriteMappedData(const void* data, VkDeviceSize dataSize, VkDeviceSize dstOffset = 0) {
+				if (description.pMappedData == nullptr)
+					throw TinyVkRuntimeError("TinyVulkan: TinyVkBuffer is not host mapped, use StageBufferData instead!");
+				#if TVK_VALIDATION_LAYERS
+					if (dstOffset + dataSize > size)
+						throw TinyVkRuntimeError("TinyVulkan: TinyVkBuffer::WriteMappedData writes past the end of the buffer!");
+				#endif
+
+				memcpy(static_cast<uint8_t*>(description.pMappedData) + dstOffset, data, (size_t)dataSize);
+				vmaFlushAllocation(renderContext.vkdevice.GetAllocator(), memory, dstOffset, dataSize);
+				TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_BYTES_UPLOADED, dataSize);
 			}
 
 			#pragma region SYNCHRONIZATION
 			
-			/// @brief Get pipeline stages relative to the current image layout and command buffer recording stage.
-			void GetPipelineBarrierStages(TinyVkCmdBufferSubmitStage cmdBufferStage, VkPipelineStageFlags& srcStage, VkPipelineStageFlags& dstStage, VkAccessFlags& srcAccessMask, VkAccessFlags& dstAccessMask) {
-				if (cmdBufferStage == TinyVkCmdBufferSubmitStage::TINYVK_BEGIN) {
-					switch(bufferType) {
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING:
-						srcAccessMask = VK_ACCESS_NONE;
-						dstAccessMask = VK_ACCESS_NONE;
-						srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-						dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-						break;
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_STORAGE:
-						srcAccessMask = VK_ACCESS_NONE;
-						dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
-						srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-						dstStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-						break;
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_VERTEX:
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_INDEX:
-						srcAccessMask = VK_ACCESS_NONE;
-						dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-						srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-						dstStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-						break;
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_UNIFORM:
-						srcAccessMask = VK_ACCESS_NONE;
-						dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
-						srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-						dstStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-						break;
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_INDIRECT:
-						default:
-						srcAccessMask = VK_ACCESS_NONE;
-						dstAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-						srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-						dstStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-						break;
-					}
+			/// @brief Get the synchronization2 stage/access masks for this buffer's type relative to the command buffer recording stage.
+			void GetPipelineBarrierStages(TinyVkCmdBufferSubmitStage cmdBufferStage, VkPipelineStageFlags2& srcStage, VkPipelineStageFlags2& dstStage, VkAccessFlags2& srcAccessMask, VkAccessFlags2& dstAccessMask) {
+				VkPipelineStageFlags2 useStage;
+				VkAccessFlags2 useAccess;
+
+				switch(bufferType) {
+					case TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING:
+					useStage = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+					useAccess = VK_ACCESS_2_TRANSFER_READ_BIT;
+					break;
+					case TinyVkBufferType::TINYVK_BUFFER_TYPE_STORAGE:
+					useStage = VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+					useAccess = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+					break;
+					case TinyVkBufferType::TINYVK_BUFFER_TYPE_VERTEX:
+					useStage = VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT;
+					useAccess = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+					break;
+					case TinyVkBufferType::TINYVK_BUFFER_TYPE_INDEX:
+					useStage = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
+					useAccess = VK_ACCESS_2_INDEX_READ_BIT;
+					break;
+					case TinyVkBufferType::TINYVK_BUFFER_TYPE_UNIFORM:
+					useStage = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+					useAccess = VK_ACCESS_2_UNIFORM_READ_BIT;
+					break;
+					case TinyVkBufferType::TINYVK_BUFFER_TYPE_INDIRECT:
+					default:
+					useStage = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+					useAccess = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+					break;
 				}
 
-				if (cmdBufferStage == TinyVkCmdBufferSubmitStage::TINYVK_END) {
-					switch(bufferType) {
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING:
-						srcAccessMask = VK_ACCESS_NONE;
-						dstAccessMask = VK_ACCESS_NONE;
-						srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-						dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-						break;
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_STORAGE:
-						srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;
-						dstAccessMask = VK_ACCESS_NONE;
-						srcStage = VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT;
-						dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-						break;
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_VERTEX:
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_INDEX:
-						srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-						dstAccessMask = VK_ACCESS_NONE;
-						srcStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT;
-						dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-						break;
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_UNIFORM:
-						srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-						dstAccessMask = VK_ACCESS_NONE;
-						srcStage = VK_PIPELINE_STAGE_VERTEX_INPUT_BIT | VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-						dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-						break;
-						case TinyVkBufferType::TINYVK_BUFFER_TYPE_INDIRECT:
-						default:
-						srcAccessMask = VK_ACCESS_INDIRECT_COMMAND_READ_BIT;
-						dstAccessMask = VK_ACCESS_NONE;
-						srcStage = VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT;
-						dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-						break;
-					}
+				srcStage = dstStage = VK_PIPELINE_STAGE_2_NONE;
+				srcAccessMask = dstAccessMask = VK_ACCESS_2_NONE;
+
+				// Earlier writes are transfers (staging uploads) or, for storage buffers, previous dispatches.
+				VkPipelineStageFlags2 writeStage = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+				VkAccessFlags2 writeAccess = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+				if (bufferType == TinyVkBufferType::TINYVK_BUFFER_TYPE_STORAGE) {
+					writeStage |= useStage;
+					writeAccess |= VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT;
+				}
+
+				if (cmdBufferStage == TinyVkCmdBufferSubmitStage::TINYVK_BEGIN) {
+					srcStage = writeStage;
+					srcAccessMask = writeAccess;
+					dstStage = useStage;
+					dstAccessMask = useAccess;
 				}
 
-				if (cmdBufferStage == TinyVkCmdBufferSubmitStage::TINYVK_BEGIN_TO_END) {
-					srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-					dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-					srcAccessMask = VK_ACCESS_NONE;
-					dstAccessMask = VK_ACCESS_NONE;
+				if (cmdBufferStage == TinyVkCmdBufferSubmitStage::TINYVK_END) {
+					srcStage = useStage;
+					srcAccessMask = useAccess & writeAccess;
+					dstStage = writeStage;
+					dstAccessMask = writeAccess;
 				}
 			}
 			
-			/// @brief Get the pipeline barrier info for resource synchronization in buffer pipeline barrier pNext chain.
-			VkBufferMemoryBarrier GetPipelineBarrier(TinyVkCmdBufferSubmitStage cmdBufferStage, VkPipelineStageFlags& srcStage, VkPipelineStageFlags& dstStage) {
-				VkBufferMemoryBarrier pipelineBarrier {
+			/// @brief Get the synchronization2 buffer memory barrier (stage/access masks included) for the command buffer recording stage.
+			VkBufferMemoryBarrier2 GetPipelineBarrier(TinyVkCmdBufferSubmitStage cmdBufferStage) {
+				VkBufferMemoryBarrier2 pipelineBarrier {
 					.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
-					.srcAccessMask = VK_ACCESS_NONE, .dstAccessMask = VK_ACCESS_NONE,
 					.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED, .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-					.size = VK_WHOLE_SIZE, .offset = 0,
-					.buffer = buffer,
+					.buffer = buffer, .offset = 0, .size = VK_WHOLE_SIZE,
 				};
 
-				GetPipelineBarrierStages(cmdBufferStage, srcStage, dstStage, pipelineBarrier.srcAccessMask, pipelineBarrier.dstAccessMask);
+				GetPipelineBarrierStages(cmdBufferStage, pipelineBarrier.srcStageMask, pipelineBarrier.dstStageMask, pipelineBarrier.srcAccessMask, pipelineBarrier.dstAccessMask);
 				return pipelineBarrier;
 			}
 
-			/// @brief Get the pipeline barrier info and submit call of vkCmdPipelineBarrier to VkCommandBuffer.
+			/// @brief Adds the buffer memory barrier to a barrier batch (recorded on the batch's next Flush()).
+			void MemoryPipelineBarrier(TinyVkBarrierBatch& barrierBatch, TinyVkCmdBufferSubmitStage cmdBufferStage) {
+				barrierBatch.Add(GetPipelineBarrier(cmdBufferStage));
+			}
+
+			/// @brief Get the pipeline barrier info and record it to the VkCommandBuffer with vkCmdPipelineBarrier2.
 			void MemoryPipelineBarrier(VkCommandBuffer cmdBuffer, TinyVkCmdBufferSubmitStage cmdBufferStage) {
-				VkPipelineStageFlags srcStage, dstStage;
-				VkBufferMemoryBarrier pipelineBarrier = GetPipelineBarrier(cmdBufferStage, srcStage, dstStage);
-				vkCmdPipelineBarrier(cmdBuffer, srcStage, dstStage, 0, 0, VK_NULL_HANDLE, 1, &pipelineBarrier, 0, VK_NULL_HANDLE);
+				TinyVkBarrierBatch barrierBatch;
+				MemoryPipelineBarrier(barrierBatch, cmdBufferStage);
+				barrierBatch.Flush(cmdBuffer);
 			}
 			
 			#pragma endregion
@@ -284,6 +299,9 @@
 			/// @brief Creates the data descriptor that represents this buffer when passing into graphicspipeline.SelectWrite*Descriptor().
 			VkDescriptorBufferInfo GetBufferDescriptor(VkDeviceSize offset = 0, VkDeviceSize range = VK_WHOLE_SIZE) { return { buffer, offset, range }; }
 
+			/// @brief Returns the descriptor type this buffer binds as (uniform buffers as VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, all others as VK_DESCRIPTOR_TYPE_STORAGE_BUFFER).
+			VkDescriptorType GetDescriptorType() { return (bufferType == TinyVkBufferType::TINYVK_BUFFER_TYPE_UNIFORM)? VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER : VK_DESCRIPTOR_TYPE_STORAGE_BUFFER; }
+
 			#pragma endregion
 			
 			/// @brief Get the data/memory size of a vector of objects.
@@ -50,20 +50,28 @@
 				std::for_each(temporary.begin(), temporary.end(), [&buffers](VkCommandBuffer cmdBuffer) {
 					buffers.push_back(std::pair(cmdBuffer, static_cast<VkBool32>(false)));
 				});
+				bufferRetirements.resize(commandBuffers.size());
+			}
+
+			/// @brief Returns true if the leased command buffer at index is free to record again (not leased or its retired submission completed).
+			bool IsBufferAvailable(size_t index) {
+				return !commandBuffers[index].second || (bufferRetirements[index].timeline != VK_NULL_HANDLE && bufferRetirements[index].IsComplete());
 			}
 
 		public:
 			TinyVkVulkanDevice& vkdevice;
 			std::vector<std::pair<VkCommandBuffer, VkBool32>> commandBuffers;
+			std::vector<TinyVkTimelinePoint> bufferRetirements; /// Submission of each retired (in flight) command buffer, null timeline while recording or free.
 			static const size_t defaultCommandPoolSize = 32UL;
 			const bool useAsComputeCommandPool;
+			TinyVkTimelinePoint lastUse; /// Timeline point of the last submission using this pool's command buffers.
 
 			TinyVkCommandPool operator=(const TinyVkCommandPool& cmdPool) = delete;
 
 			~TinyVkCommandPool() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
-				if (waitIdle) vkdevice.DeviceWaitIdle();
+				if (waitIdle) lastUse.Wait(UINT64_MAX, "TinyVkCommandPool::Disposable");
 
 				vkDestroyCommandPool(vkdevice.GetLogicalDevice(), commandPool, VK_NULL_HANDLE);
 			}
@@ -74,6 +82,16 @@
 
 				CreateCommandPool();
 				CreateCommandBuffers(bufferCount+1);
+				SetDebugName((useAsComputeCommandPool)? "TinyVkCommandPool[COMPUTE]" : "TinyVkCommandPool[GRAPHICS]");
+			}
+
+			/// @brief Names the VkCommandPool and its command buffers (VK_EXT_debug_utils, compiled out in release).
+			void SetDebugName(const std::string& name) {
+				#if TVK_DEBUG_UTILS
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_COMMAND_POOL, commandPool, name);
+					for(size_t i = 0; i < commandBuffers.size(); i++)
+						TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_COMMAND_BUFFER, commandBuffers[i].first, name + "::CommandBuffer[" + std::to_string(i) + "]");
+				#endif
 			}
 
 			#pragma region REFERENCE_GETTERS
@@ -88,8 +106,8 @@
 
 			/// @brief Returns true/false if ANY VkCommandBuffers are available to be Leased.
 			bool HasBuffers() {
-				for (auto& cmdBuffer : commandBuffers)
-					if (!cmdBuffer.second) return true;
+				for(size_t index = 0; index < commandBuffers.size(); index++)
+					if (IsBufferAvailable(index)) return true;
 
 				return false;
 			}
@@ -97,39 +115,88 @@
 			/// @brief Returns the number of available VkCommandBuffers that can be Leased.
 			size_t HasBuffersCount() {
 				size_t count = 0;
-				for(auto& cmdBuffer : commandBuffers)
-					count += static_cast<size_t>(!cmdBuffer.second);
+				for(size_t index = 0; index < commandBuffers.size(); index++)
+					count += static_cast<size_t>(IsBufferAvailable(index));
 				return count;
 			}
 
 			/// @brief Reserves a VkCommandBuffer for use and returns the VkCommandBuffer and it's ID (used for returning to the pool).
+			/// Retired buffers are reused once their submission completes, the CPU only waits (on the oldest retired submission) when every buffer is in flight.
 			std::pair<VkCommandBuffer,int32_t> LeaseBuffer(bool resetCmdBuffer = false) {
-				size_t index = 0;
-				for(auto& cmdBuffer : commandBuffers)
-					if (!cmdBuffer.second) {
+				int32_t oldestRetired = -1;
+				for(size_t index = 0; index < commandBuffers.size(); index++) {
+					auto& cmdBuffer = commandBuffers[index];
+					TinyVkTimelinePoint& retirement = bufferRetirements[index];
+					if (cmdBuffer.second && retirement.timeline != VK_NULL_HANDLE && !retirement.IsComplete()) {
+						if (oldestRetired < 0 || retirement.value < bufferRetirements[oldestRetired].value) oldestRetired = static_cast<int32_t>(index);
+						continue;
+					}
+
+					if (!cmdBuffer.second || retirement.timeline != VK_NULL_HANDLE) {
+						if (cmdBuffer.second) resetCmdBuffer = true;
 						cmdBuffer.second = true;
+						retirement = TinyVkTimelinePoint();
 						if (resetCmdBuffer) vkResetCommandBuffer(cmdBuffer.first, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
-						return std::pair(cmdBuffer.first, index++);
+						return std::pair(cmdBuffer.first, static_cast<int32_t>(index));
 					}
+				}
+
+				if (oldestRetired >= 0) {
+					if (bufferRetirements[oldestRetired].Wait(UINT64_MAX, "TinyVkCommandPool::LeaseBuffer") != VK_SUCCESS)
+						throw TinyVkRuntimeError("TinyVulkan: Timed out waiting on a retired command buffer of TinyVkCommandPool!");
+
+					bufferRetirements[oldestRetired] = TinyVkTimelinePoint();
+					vkResetCommandBuffer(commandBuffers[oldestRetired].first, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
+					return std::pair(commandBuffers[oldestRetired].first, oldestRetired);
+				}
 				
 				throw TinyVkRuntimeError("TinyVulkan: VKCommandPool is full and cannot lease any more VkCommandBuffers! MaxSize: " + std::to_string(bufferCount));
 				return std::pair<VkCommandBuffer,int32_t>(VK_NULL_HANDLE,-1);
 			}
 
+			/// @brief Returns the leased command buffers which are being recorded (leased and not retired to a submission).
+			std::vector<VkCommandBuffer> GetRecordingBuffers() {
+				std::vector<VkCommandBuffer> recording;
+				for(size_t index = 0; index < commandBuffers.size(); index++)
+					if (commandBuffers[index].second && bufferRetirements[index].timeline == VK_NULL_HANDLE) recording.push_back(commandBuffers[index].first);
+				return recording;
+			}
+
+			/// @brief Retires a leased command buffer to the submission it was recorded for, LeaseBuffer() reuses it once the submission completes (no CPU wait).
+			void RetireBuffer(std::pair<VkCommandBuffer, int32_t> bufferIndexPair, TinyVkTimelinePoint submission) {
+				if (bufferIndexPair.second < 0 || bufferIndexPair.second >= commandBuffers.size() || !commandBuffers[bufferIndexPair.second].second)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to retire command buffer!");
+
+				bufferRetirements[bufferIndexPair.second] = submission;
+				lastUse = submission;
+			}
+
+			/// @brief Retires every command buffer returned by GetRecordingBuffers() to the submission they were recorded for (see RetireBuffer()).
+			void RetireRecordingBuffers(TinyVkTimelinePoint submission) {
+				for(size_t index = 0; index < commandBuffers.size(); index++)
+					if (commandBuffers[index].second && bufferRetirements[index].timeline == VK_NULL_HANDLE) bufferRetirements[index] = submission;
+				lastUse = submission;
+			}
+
 			/// @brief Free's up the VkCommandBuffer that was previously rented for re-use.
 			void ReturnBuffer(std::pair<VkCommandBuffer, int32_t> bufferIndexPair) {
 				if (bufferIndexPair.second < 0 || bufferIndexPair .second >= commandBuffers.size())
 					throw TinyVkRuntimeError("TinyVulkan: Failed to return command buffer!");
 
 				commandBuffers[bufferIndexPair.second].second = false;
+				bufferRetirements[bufferIndexPair.second] = TinyVkTimelinePoint();
 			}
 
-			/// @brief Sets all of the command buffers to available--optionally resets their recorded commands.
+			/// @brief Sets all of the command buffers to available--optionally resets their recorded commands (waits on the pool's last use).
 			void ReturnAllBuffers() {
+				if (lastUse.Wait(UINT64_MAX, "TinyVkCommandPool::ReturnAllBuffers") != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Timed out waiting on the last use of TinyVkCommandPool!");
 				vkResetCommandPool(vkdevice.GetLogicalDevice(), commandPool, VK_COMMAND_POOL_RESET_RELEASE_RESOURCES_BIT);
 				
 				for(auto& cmdBuffer : commandBuffers)
 					cmdBuffer.second = false;
+				for(TinyVkTimelinePoint& retirement : bufferRetirements)
+					retirement = TinyVkTimelinePoint();
 			}
 			
 			#pragma endregion
@@ -4,23 +4,18 @@
 	#include "./TinyVulkan.hpp"
 
 	namespace TINYVULKAN_NAMESPACE {
+		class TinyVkShaderWatcher;
+
 		/// @brief Vulkan Compute Pipeline & Renderer using Storage Buffers/Images and Push Descriptors/Constants.
 		class TinyVkComputeRenderer : public TinyVkDisposable {
         private:
-			VkShaderModule CreateShaderModule(std::vector<char> shaderCode) {
-				VkShaderModuleCreateInfo createInfo{};
-				createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-				createInfo.pNext = VK_NULL_HANDLE;
-				createInfo.flags = 0;
-				createInfo.codeSize = shaderCode.size();
-				createInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
-
-				VkShaderModule shaderModule;
-				if (vkCreateShaderModule(vkdevice.GetLogicalDevice(), &createInfo, VK_NULL_HANDLE, &shaderModule) != VK_SUCCESS)
-					throw TinyVkRuntimeError("TinyVulkan: Failed to create shader module!");
-
-				return shaderModule;
-			}
+			friend class TinyVkShaderWatcher;
+			std::string computeShader;
+			std::atomic<VkPipeline> reloadedPipeline = VK_NULL_HANDLE; /// Rebuilt by a shader reload, swapped in by ApplyShaderReloads().
+			std::timed_mutex reload_lock;
+			std::vector<TinyVkPipelineHandle> pendingReloads;
+			std::function<void()> shaderWatcherDetach; /// Set by the TinyVkShaderWatcher watching this renderer (guarded by detach_lock).
+			std::timed_mutex detach_lock;
 
 			VkPipelineShaderStageCreateInfo CreateShaderInfo(const std::string& path, VkShaderModule shaderModule, VkShaderStageFlagBits stageFlagBits) {
 				VkPipelineShaderStageCreateInfo shaderStageInfo{};
@@ -36,29 +31,7 @@
 				return shaderStageInfo;
 			}
 
-			std::vector<char> ReadFile(const std::string& path) {
-				std::ifstream file(path, std::ios::ate | std::ios::binary);
-
-				if (!file.is_open())
-					throw TinyVkRuntimeError("TinyVulkan: Failed to Read File: " + path);
-
-				size_t fsize = static_cast<size_t>(file.tellg());
-				std::vector<char> buffer(fsize);
-				file.seekg(0);
-				file.read(buffer.data(), fsize);
-				file.close();
-				return buffer;
-			}
-			
-            void CreateComputePipeline(const std::string shader) {
-				VkPipelineShaderStageCreateInfo shaderPipelineCreateInfo;
-				VkShaderModule shaderModule;
-				auto shaderCode = ReadFile(shader);
-				shaderModule = CreateShaderModule(shaderCode);
-				shaderPipelineCreateInfo = CreateShaderInfo(shader, shaderModule, VK_SHADER_STAGE_COMPUTE_BIT);
-
-				///////////////////////////////////////////////////////////////////////////////////////////////////////
-				///////////////////////////////////////////////////////////////////////////////////////////////////////
+            void CreateComputePipelineLayout() {
 				VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 				pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 				
@@ -85,35 +58,53 @@
 
 				if (vkCreatePipelineLayout(vkdevice.GetLogicalDevice(), &pipelineLayoutInfo, VK_NULL_HANDLE, &computePipelineLayout) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to create graphics pipeline layout!");
-				
-				///////////////////////////////////////////////////////////////////////////////////////////////////////
-				///////////////////////////////////////////////////////////////////////////////////////////////////////
 
-                VkComputePipelineCreateInfo pipelineInfo;
+				if (descriptorBindings.size() > 0)
+					descriptorTemplate = TinyVkGraphicsPipeline::CreatePushDescriptorTemplate(vkdevice.GetLogicalDevice(), VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout, descriptorBindings);
+			}
+
+			/// @brief Creates the compute pipeline from the shader's cached module (thread-safe, runs on a TinyVkPipelineCompiler thread when compiled in the background).
+			VkPipeline CreateComputePipeline(const std::string& shader) {
+				VkShaderModule shaderModule = vkdevice.GetShaderCache().GetShaderModule(shader);
+				VkPipelineShaderStageCreateInfo shaderPipelineCreateInfo = CreateShaderInfo(shader, shaderModule, VK_SHADER_STAGE_COMPUTE_BIT);
+
+                VkComputePipelineCreateInfo pipelineInfo{};
                 pipelineInfo.sType = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO;
-                pipelineInfo.flags = VK_PIPELINE_CREATE_COLOR_ATTACHMENT_FEEDBACK_LOOP_BIT_EXT;
                 pipelineInfo.stage = shaderPipelineCreateInfo;
                 pipelineInfo.layout = computePipelineLayout;
-                pipelineInfo.basePipelineHandle;
-                pipelineInfo.basePipelineIndex;
+                pipelineInfo.basePipelineHandle = VK_NULL_HANDLE;
+                pipelineInfo.basePipelineIndex = -1;
                 
-                if (vkCreateComputePipelines(vkdevice.GetLogicalDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, VK_NULL_HANDLE, &computePipeline) != VK_SUCCESS)
+                VkPipeline pipeline = VK_NULL_HANDLE;
+                VkResult result = vkCreateComputePipelines(vkdevice.GetLogicalDevice(), vkdevice.GetPipelineCache(), 1, &pipelineInfo, VK_NULL_HANDLE, &pipeline);
+
+                if (result != VK_SUCCESS)
                     throw TinyVkRuntimeError("TinyVulkan: Failed to create compute pipeline!");
-                
-                vkDestroyShaderModule(vkdevice.GetLogicalDevice(), shaderModule, VK_NULL_HANDLE);
-				QueryPhysicalDeviceLimits(vkdevice.GetPhysicalDevice());
+                return pipeline;
             }
 
+			TinyVkComputeRenderer(TinyVkVulkanDevice& vkdevice, TinyVkCommandPool& commandPool, const TinyVkShaderReflection& reflection, const std::string shader, TinyVkPipelineCompiler* pipelineCompiler)
+			: TinyVkComputeRenderer(vkdevice, commandPool, TinyVkVertexDescription({}, {}), shader, reflection.GetPushDescriptorBindings(), reflection.pushConstantRanges, pipelineCompiler) {
+				localSize = reflection.localSize;
+			}
+
         public:
             TinyVkVulkanDevice& vkdevice;
 			TinyVkCommandPool& commandPool;
-			VkDescriptorSetLayout descriptorLayout;
+			VkDescriptorSetLayout descriptorLayout = VK_NULL_HANDLE;
 			std::vector<VkDescriptorSetLayoutBinding> descriptorBindings;
 			std::vector<VkPushConstantRange> pushConstantRanges;
-			VkPipelineLayout computePipelineLayout;
-			VkPipeline computePipeline;
+			VkPipelineLayout computePipelineLayout = VK_NULL_HANDLE;
+			TinyVkDescriptorTemplate descriptorTemplate {};
+			VkPipeline computePipeline = VK_NULL_HANDLE;
+			TinyVkPipelineHandle pipelineHandle; /// Ready once the compute pipeline is compiled (immediately unless a TinyVkPipelineCompiler was given).
 			VkQueue computeQueue;
 			uint32_t maxWorkGroups[3], maxSizeOfWorkGroups[3];
+			std::array<uint32_t,3> localSize = { 0, 0, 0 }; /// Work-group size of the compute shader (only known when created from the shader alone).
+			TinyVkGpuProfiler* gpuProfiler = nullptr; /// Optional GPU profiler for recorded command buffers and dispatches.
+			TinyVkPipelineQueries* pipelineQueries = nullptr; /// Optional pipeline statistics queries for recorded command buffers.
+			std::string gpuScopeName = "TinyVkComputeRenderer"; /// Name of the renderer's GPU profiler scopes, pipeline statistics and debug labels.
+			TinyVkRenderStats renderStats { "TinyVkComputeRenderer" }; /// Per-frame counters (active while ComputeExecute runs, one frame per ComputeExecute).
 
             /// Invokable Render Events: (executed in TinyVkComputeRenderer::RenderExecute()
 			TinyVkInvokable<TinyVkCommandPool&> onRenderEvents;
@@ -122,21 +113,70 @@
 			~TinyVkComputeRenderer() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
+				std::function<void()> detach;
+				{
+					timed_guard<false> detachLock(detach_lock);
+					detach = shaderWatcherDetach;
+				}
+				if (detach) detach();
+				pipelineHandle.Wait();
+				WaitPendingReloads();
 				if (waitIdle) vkdevice.DeviceWaitIdle();
 
+				vkDestroyDescriptorUpdateTemplate(vkdevice.GetLogicalDevice(), descriptorTemplate.updateTemplate, VK_NULL_HANDLE);
 				vkDestroyDescriptorSetLayout(vkdevice.GetLogicalDevice(), descriptorLayout, VK_NULL_HANDLE);
 				vkDestroyPipeline(vkdevice.GetLogicalDevice(), computePipeline, VK_NULL_HANDLE);
+				vkDestroyPipeline(vkdevice.GetLogicalDevice(), reloadedPipeline.exchange(VK_NULL_HANDLE), VK_NULL_HANDLE);
 				vkDestroyPipelineLayout(vkdevice.GetLogicalDevice(), computePipelineLayout, VK_NULL_HANDLE);
 			}
             
-            TinyVkComputeRenderer(TinyVkVulkanDevice& vkdevice, TinyVkCommandPool& commandPool, TinyVkVertexDescription vertexDescription, const std::string shader, const std::vector<VkDescriptorSetLayoutBinding>& descriptorBindings, const std::vector<VkPushConstantRange>& pushConstantRanges)
-            : vkdevice(vkdevice), commandPool(commandPool) {
-                CreateComputePipeline(shader);
+			/// @brief Creates the compute renderer, if a pipelineCompiler is given the shader is read and its pipeline compiled in the background (see IsPipelineReady()).
+            TinyVkComputeRenderer(TinyVkVulkanDevice& vkdevice, TinyVkCommandPool& commandPool, TinyVkVertexDescription vertexDescription, const std::string shader, const std::vector<VkDescriptorSetLayoutBinding>& descriptorBindings, const std::vector<VkPushConstantRange>& pushConstantRanges, TinyVkPipelineCompiler* pipelineCompiler = nullptr)
+            : computeShader(shader), vkdevice(vkdevice), commandPool(commandPool), descriptorBindings(descriptorBindings), pushConstantRanges(pushConstantRanges) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+				QueryPhysicalDeviceLimits(vkdevice.GetPhysicalDevice());
+                CreateComputePipelineLayout();
+
+				if (pipelineCompiler == nullptr) {
+					computePipeline = CreateComputePipeline(shader);
+					pipelineHandle = TinyVkPipelineHandle::Ready(computePipeline);
+				} else {
+					TinyVkPipelineHandle handle = TinyVkPipelineHandle::Pending();
+					pipelineHandle = handle;
+					pipelineCompiler->Enqueue([this, shader, handle]() {
+						TINYVK_TRACE_SCOPE_CATEGORY("TinyVkComputeRenderer::CreateComputePipeline", "tinyvk");
+						try {
+							computePipeline = CreateComputePipeline(shader);
+							#if TVK_DEBUG_UTILS
+								TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_PIPELINE, computePipeline, gpuScopeName);
+							#endif
+							handle.Resolve(computePipeline);
+						} catch (const std::exception& exception) { handle.Fail(exception.what()); }
+					});
+				}
+				SetDebugName(gpuScopeName);
 				
-				TinyVkQueueFamily indices = vkdevice.FindQueueFamilies();
-				vkGetDeviceQueue(vkdevice.GetLogicalDevice(), indices.computeFamily, 0, &computeQueue);
+				computeQueue = vkdevice.GetComputeTimeline().GetQueue();
             }
 
+			/// @brief Creates the compute renderer from its shader alone: push descriptor bindings, push constant range and work-group size are reflected from the SPIR-V (see ABOUT SHADER REFLECTION).
+			/// The pipeline layout needs the reflected bindings, so the shader is read and reflected on the calling thread even with a pipelineCompiler (only the pipeline is compiled in the background).
+			TinyVkComputeRenderer(TinyVkVulkanDevice& vkdevice, TinyVkCommandPool& commandPool, const std::string shader, TinyVkPipelineCompiler* pipelineCompiler = nullptr)
+			: TinyVkComputeRenderer(vkdevice, commandPool, TinyVkShaderReflection::FromFile(shader, VK_SHADER_STAGE_COMPUTE_BIT), shader, pipelineCompiler) {}
+
+			/// @brief Names the compute pipeline, its layout and descriptor set layout (VK_EXT_debug_utils, compiled out in release).
+			void SetDebugName(const std::string& name) {
+				#if TVK_DEBUG_UTILS
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_PIPELINE, pipelineHandle.Get(), name);
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_PIPELINE_LAYOUT, computePipelineLayout, name + "::PipelineLayout");
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, descriptorLayout, name + "::DescriptorSetLayout");
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, descriptorTemplate.updateTemplate, name + "::DescriptorUpdateTemplate");
+				#endif
+			}
+
+			/// @brief Returns true once the compute pipeline is compiled (always true unless created with a TinyVkPipelineCompiler).
+			bool IsPipelineReady() { return pipelineHandle.IsReady(); }
+
 			void QueryPhysicalDeviceLimits(VkPhysicalDevice device) {
 				VkPhysicalDeviceLimits deviceLimits {};
 				VkPhysicalDeviceProperties2 properties {};
@@ -144,17 +184,85 @@
 				vkGetPhysicalDeviceProperties2(device, &properties);
 
 				maxWorkGroups[0] = properties.properties.limits.maxComputeWorkGroupCount[0];
-				maxWorkGroups[2] = properties.properties.limits.maxComputeWorkGroupCount[1];
-				maxWorkGroups[3] = properties.properties.limits.maxComputeWorkGroupCount[2];
+				maxWorkGroups[1] = properties.properties.limits.maxComputeWorkGroupCount[1];
+				maxWorkGroups[2] = properties.properties.limits.maxComputeWorkGroupCount[2];
 				maxSizeOfWorkGroups[0] = properties.properties.limits.maxComputeWorkGroupSize[0];
-				maxSizeOfWorkGroups[2] = properties.properties.limits.maxComputeWorkGroupSize[1];
-				maxSizeOfWorkGroups[3] = properties.properties.limits.maxComputeWorkGroupSize[2];
+				maxSizeOfWorkGroups[1] = properties.properties.limits.maxComputeWorkGroupSize[1];
+				maxSizeOfWorkGroups[2] = properties.properties.limits.maxComputeWorkGroupSize[2];
 			}
 			
+			#pragma region SHADER_HOT_RELOAD
+
+			/// @brief Returns the SPIR-V file of the compute shader.
+			const std::string& GetShaderPath() { return computeShader; }
+			TinyVkDescriptorTemplate GetDescriptorTemplate() { return descriptorTemplate; }
+
+			/// @brief Rebuilds the compute pipeline if its shader is one of the changed SPIR-V files on a compiler thread (the calling thread if compiler is nullptr), swapped in by the next ComputeExecute().
+			bool ReloadShaders(const std::vector<std::string>& changedPaths, TinyVkPipelineCompiler* compiler) {
+				if (pipelineHandle.IsPending() || std::find(changedPaths.begin(), changedPaths.end(), computeShader) == changedPaths.end()) return false;
+
+				TinyVkPipelineHandle handle = TinyVkPipelineHandle::Pending();
+				{
+					timed_guard<false> reloadLock(reload_lock);
+					std::erase_if(pendingReloads, [](TinyVkPipelineHandle& reload) { return !reload.IsPending(); });
+					pendingReloads.push_back(handle);
+				}
+
+				auto reload = [this, handle]() {
+					TINYVK_TRACE_SCOPE_CATEGORY("TinyVkComputeRenderer::ReloadShaders", "tinyvk");
+					VkPipeline pipeline = VK_NULL_HANDLE;
+					std::string error;
+					try {
+						std::vector<uint32_t> shaderCode = TinyVkShaderCache::ReadShaderFile(computeShader);
+						if (!TinyVkShaderReflection::FromCode(shaderCode.data(), shaderCode.size(), VK_SHADER_STAGE_COMPUTE_BIT).IsLayoutCompatible(descriptorBindings, pushConstantRanges))
+							throw TinyVkRuntimeError("TinyVulkan: Reloaded shader " + computeShader + " does not match the pipeline layout (restart to change descriptor/push constant layouts)!");
+						vkdevice.GetShaderCache().UpdateShaderModule(computeShader, shaderCode.data(), shaderCode.size());
+						pipeline = CreateComputePipeline(computeShader);
+					} catch (const std::exception& exception) { error = exception.what(); }
+
+					if (pipeline != VK_NULL_HANDLE) {
+						vkDestroyPipeline(vkdevice.GetLogicalDevice(), reloadedPipeline.exchange(pipeline), VK_NULL_HANDLE);
+					} else TinyVkDebugUtils::SubmitMessage(vkdevice.GetInstance(), "TinyVulkan: Shader reload failed, keeping the previous pipeline: " + error);
+
+					// Completed last: a disposing renderer waits on this handle and must not be touched afterwards.
+					if (pipeline != VK_NULL_HANDLE) { handle.Resolve(pipeline); } else handle.Fail(error);
+				};
+
+				if (compiler != nullptr) { compiler->Enqueue(reload); } else reload();
+				return true;
+			}
+
+			/// @brief Swaps in a compute pipeline rebuilt by a shader reload (ComputeExecute() calls this before recording), the replaced pipeline is retired once the compute queue's submissions so far complete.
+			bool ApplyShaderReloads() {
+				VkPipeline pipeline = reloadedPipeline.exchange(VK_NULL_HANDLE);
+				if (pipeline == VK_NULL_HANDLE) return false;
+
+				VkDevice device = vkdevice.GetLogicalDevice();
+				VkPipeline retired = computePipeline;
+				vkdevice.RetireResource(vkdevice.GetComputeTimeline().GetSubmittedPoint(), [device, retired]() { vkDestroyPipeline(device, retired, VK_NULL_HANDLE); });
+				computePipeline = pipeline;
+				pipelineHandle = TinyVkPipelineHandle::Ready(pipeline);
+				#if TVK_DEBUG_UTILS
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_PIPELINE, computePipeline, gpuScopeName);
+				#endif
+				return true;
+			}
+
+			/// @brief Blocks until every shader reload queued on a TinyVkPipelineCompiler has finished rebuilding (not yet applied).
+			void WaitPendingReloads() {
+				std::vector<TinyVkPipelineHandle> pending;
+				{
+					timed_guard<false> reloadLock(reload_lock);
+					pending = pendingReloads;
+				}
+				for(TinyVkPipelineHandle& handle : pending) handle.Wait();
+			}
+
+			#pragma endregion
 			#pragma region RENDERING_COMMAND_RECORDING
 
 			/// @brief Begins recording render commands to the provided command buffer.
-			void BeginRecordCmdBuffer(VkCommandBuffer commandBuffer, std::vector<TinyVkBuffer*> syncStorageBuffers, std::vector<TinyVkImage*> syncStorageImages, const VkClearValue clearColor = { 0.0f, 0.0f, 0.0f, 1.0f }, const VkClearValue depthStencil = { .depthStencil = { 1.0f, 0 } }) {
+			void BeginRecordCmdBuffer(VkCommandBuffer commandBuffer, const std::vector<TinyVkBuffer*>& syncStorageBuffers, const std::vector<TinyVkImage*>& syncStorageImages, const VkClearValue clearColor = { 0.0f, 0.0f, 0.0f, 1.0f }, const VkClearValue depthStencil = { .depthStencil = { 1.0f, 0 } }) {
 				VkCommandBufferBeginInfo beginInfo{};
 				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_SIMULTANEOUS_USE_BIT;
@@ -162,24 +270,34 @@
 
 				if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to record [begin] to command buffer!");
+				TinyVkDebugUtils::BeginLabel(commandBuffer, gpuScopeName);
+				if (gpuProfiler != nullptr) gpuProfiler->BeginScope(commandBuffer, gpuScopeName, commandPool.useAsComputeCommandPool);
+				if (pipelineQueries != nullptr) pipelineQueries->BeginStatistics(commandBuffer, gpuScopeName, true);
 				
+				TinyVkBarrierBatch barrierBatch;
 				for(TinyVkBuffer* buffer : syncStorageBuffers)
-					buffer->MemoryPipelineBarrier(commandBuffer, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN);
+					buffer->MemoryPipelineBarrier(barrierBatch, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN);
 				
 				for(TinyVkImage* image : syncStorageImages)
-					image->TransitionLayoutBarrier(commandBuffer, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN, TinyVkImageLayout::TINYVK_GENERAL);
+					image->TransitionLayoutBarrier(barrierBatch, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN, TinyVkImageLayout::TINYVK_GENERAL);
+				barrierBatch.Flush(commandBuffer);
 
 				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipeline);
 			}
 
 			/// @brief Ends recording render commands to the provided command buffer.
-			void EndRecordCmdBuffer(VkCommandBuffer commandBuffer, std::vector<TinyVkBuffer*> syncStorageBuffers, std::vector<TinyVkImage*> syncStorageImages, const VkClearValue clearColor = { 0.0f, 0.0f, 0.0f, 1.0f }, const VkClearValue depthStencil = { .depthStencil = { 1.0f, 0 } }) {
+			void EndRecordCmdBuffer(VkCommandBuffer commandBuffer, const std::vector<TinyVkBuffer*>& syncStorageBuffers, const std::vector<TinyVkImage*>& syncStorageImages, const VkClearValue clearColor = { 0.0f, 0.0f, 0.0f, 1.0f }, const VkClearValue depthStencil = { .depthStencil = { 1.0f, 0 } }) {
+				TinyVkBarrierBatch barrierBatch;
 				for(TinyVkBuffer* buffer : syncStorageBuffers)
-					buffer->MemoryPipelineBarrier(commandBuffer, TinyVkCmdBufferSubmitStage::TINYVK_END);
+					buffer->MemoryPipelineBarrier(barrierBatch, TinyVkCmdBufferSubmitStage::TINYVK_END);
 				
 				for(TinyVkImage* image : syncStorageImages)
-					image->TransitionLayoutBarrier(commandBuffer, TinyVkCmdBufferSubmitStage::TINYVK_END, TinyVkImageLayout::TINYVK_GENERAL);
+					image->TransitionLayoutBarrier(barrierBatch, TinyVkCmdBufferSubmitStage::TINYVK_END, TinyVkImageLayout::TINYVK_GENERAL);
+				barrierBatch.Flush(commandBuffer);
 				
+				if (pipelineQueries != nullptr) pipelineQueries->EndStatistics(commandBuffer, true);
+				if (gpuProfiler != nullptr) gpuProfiler->EndScope(commandBuffer);
+				TinyVkDebugUtils::EndLabel(commandBuffer);
 				if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to record [end] to command buffer!");
 			}
@@ -188,14 +306,40 @@
 			#pragma region PIPELINE_DESCRIPTORS
 
 			/// @brief Records Push Descriptors to the command buffer.
-			VkResult PushDescriptorSet(VkCommandBuffer cmdBuffer, std::vector<VkWriteDescriptorSet> writeDescriptorSets) {
+			VkResult PushDescriptorSet(VkCommandBuffer cmdBuffer, const std::vector<VkWriteDescriptorSet>& writeDescriptorSets) {
 				return vkCmdPushDescriptorSetEKHR(vkdevice.GetInstance(), cmdBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, computePipelineLayout,
 					0, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data());
 			}
 
+			/// @brief Records Push Descriptors to the command buffer from packed descriptor infos through the renderer's descriptor update template (see ABOUT PUSH DESCRIPTOR TEMPLATES).
+			VkResult PushDescriptorTemplate(VkCommandBuffer cmdBuffer, const void* pData) {
+				return vkCmdPushDescriptorSetWithTemplateEKHR(vkdevice.GetInstance(), cmdBuffer, descriptorTemplate.updateTemplate, computePipelineLayout, 0, pData, descriptorTemplate.entryCount);
+			}
+
+			/// @brief Records Push Descriptors to the command buffer from a struct of descriptor infos in binding order (see ABOUT PUSH DESCRIPTOR TEMPLATES).
+			template<typename T>
+			VkResult PushDescriptorTemplate(VkCommandBuffer cmdBuffer, const T& descriptors) {
+				static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>, "TinyVulkan: Push descriptor template data must be a plain struct of descriptor infos!");
+				#if TVK_VALIDATION_LAYERS
+					if (sizeof(T) != descriptorTemplate.dataSize)
+						throw TinyVkRuntimeError("TinyVulkan: Push descriptor template data size does not match the renderer's descriptor bindings!");
+				#endif
+				return PushDescriptorTemplate(cmdBuffer, static_cast<const void*>(&descriptors));
+			}
+
 			/// @brief Records Push Constants to the command buffer.
-			void PushConstants(VkCommandBuffer cmdBuffer, VkShaderStageFlagBits shaderFlags, uint32_t byteSize, const void* pValues) {
-				vkCmdPushConstants(cmdBuffer, computePipelineLayout, VK_PIPELINE_BIND_POINT_COMPUTE, 0, byteSize, pValues);
+			void PushConstants(VkCommandBuffer cmdBuffer, VkShaderStageFlags shaderFlags, uint32_t byteSize, const void* pValues, uint32_t offset = 0) {
+				vkCmdPushConstants(cmdBuffer, computePipelineLayout, shaderFlags, offset, byteSize, pValues);
+			}
+
+			/// @brief Records a typed push constant block (TinyVkPushBlock) to the command buffer, its stages, offset and size come from the block type.
+			template<typename Block>
+			void PushConstants(VkCommandBuffer cmdBuffer, const typename Block::BlockType& value) {
+				#if TVK_VALIDATION_LAYERS
+					if (!Block::IsDeclaredIn(pushConstantRanges))
+						throw TinyVkRuntimeError("TinyVulkan: Push constant block is not declared by the compute renderer's push constant ranges!");
+				#endif
+				Block::CmdPush(cmdBuffer, computePipelineLayout, value);
 			}
 			
 			#pragma endregion
@@ -210,46 +354,70 @@
 					throw tinyvk::TinyVkRuntimeError(error.str());
 				}
 				
+				// The scope name is only built when something reads it (debug labels or the profiler), release dispatches never allocate.
+				const std::string dispatchName = (TVK_DEBUG_UTILS || gpuProfiler != nullptr)? gpuScopeName + "::Dispatch" : std::string();
+				TinyVkDebugLabel dispatchLabel(commandBuffer, dispatchName, { 1.0f, 0.5f, 0.25f, 1.0f });
+				TinyVkGpuScope dispatchScope(gpuProfiler, commandBuffer, dispatchName, commandPool.useAsComputeCommandPool);
+				TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_DISPATCHES);
 				vkCmdDispatchBase(commandBuffer, wgroups[0], wgroups[1], wgroups[2], basewg[0], basewg[1], basewg[2]);
 			}
+
+			/// @brief Dispatches enough work-groups to cover X*Y*Z threads (requires the renderer to be created from its shader alone for the reflected work-group size).
+			void CmdDispatchThreads(VkCommandBuffer commandBuffer, std::array<uint32_t,3> threads) {
+				if (localSize[0] == 0 || localSize[1] == 0 || localSize[2] == 0)
+					throw TinyVkRuntimeError("TinyVulkan: Tried to dispatch threads with an unknown work-group size (create the TinyVkComputeRenderer from its shader alone)!");
+				
+				std::array<uint32_t,3> wgroups;
+				for(size_t i = 0; i < 3; i++) wgroups[i] = (threads[i] + localSize[i] - 1) / localSize[i];
+				CmdispatchGroups(commandBuffer, wgroups, { 0, 0, 0 });
+			}
 			
 			#pragma endregion
 			#pragma region RENDERING_SUBMISSION_AND_EXECUTION
 			
 			/// @brief Executes the registered onRenderEvents and renders them to the target storage buffer.
-			VkResult ComputeExecute(bool waitFences = true, std::vector<TinyVkBuffer*> storageBuffers = {}, std::vector<TinyVkImage*> storageImages = {}) {
-				std::vector<VkFence> fences;
-				if (waitFences) {
-					for(TinyVkBuffer* buffer : storageBuffers)
-						fences.push_back(buffer->bufferWaitable);
-					
-					for(TinyVkImage* image : storageImages)
-						fences.push_back(image->imageWaitable);
-					
-					vkWaitForFences(vkdevice.GetLogicalDevice(), fences.size(), fences.data(), VK_TRUE, UINT64_MAX);
+			/// @param waitLastUse Waits on the CPU for the storage resources' last use, otherwise the compute queue waits on the GPU (cross-queue timeline wait).
+			/// Command buffers of earlier dispatches are reused once their submission completes, the CPU only waits if every command buffer of the pool is in flight.
+			/// @return VK_NOT_READY (nothing recorded or submitted) while the compute pipeline is still compiling in the background.
+			VkResult ComputeExecute(bool waitLastUse = true, std::vector<TinyVkBuffer*> storageBuffers = {}, std::vector<TinyVkImage*> storageImages = {}) {
+				if (pipelineHandle.IsPending()) return VK_NOT_READY;
+				if (pipelineHandle.IsFailed()) throw TinyVkRuntimeError(pipelineHandle.GetError());
+				ApplyShaderReloads();
+
+				TinyVkRenderStatsScope statsScope(renderStats, true);
+				TinyVkTimeline& computeTimeline = vkdevice.GetComputeTimeline();
+				std::vector<TinyVkTimelinePoint> lastUses;
+				for(TinyVkBuffer* buffer : storageBuffers) lastUses.push_back(buffer->lastUse);
+				for(TinyVkImage* image : storageImages) lastUses.push_back(image->lastUse);
+
+				std::vector<TinyVkSemaphoreWait> timelineWaits;
+				for(TinyVkTimelinePoint& lastUse : lastUses) {
+					if (waitLastUse) {
+						VkResult result = lastUse.Wait(UINT64_MAX, "TinyVkComputeRenderer::ComputeExecute");
+						if (result != VK_SUCCESS) return result;
+						continue;
+					}
+					if (lastUse.timeline == &computeTimeline || lastUse.IsComplete()) continue;
+
+					auto waitInfo = std::find_if(timelineWaits.begin(), timelineWaits.end(), [&lastUse](TinyVkSemaphoreWait& wait) { return wait.semaphore == lastUse.timeline->GetSemaphore(); });
+					if (waitInfo == timelineWaits.end()) {
+						timelineWaits.push_back({ lastUse.timeline->GetSemaphore(), lastUse.value, VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT });
+					} else waitInfo->value = std::max(waitInfo->value, lastUse.value);
 				}
 				
 				//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-				commandPool.ReturnAllBuffers();
-                onRenderEvents.invoke(commandPool);
+				{
+					TINYVK_TRACE_SCOPE_CATEGORY("TinyVkComputeRenderer::onRenderEvents", "tinyvk");
+					onRenderEvents.invoke(commandPool);
+				}
 				//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
                 
-				std::vector<VkCommandBuffer> commandBuffers;
-				auto buffers = commandPool.GetBuffers();
-				std::for_each(buffers.begin(), buffers.end(),
-					[&commandBuffers](std::pair<VkCommandBuffer, VkBool32> cmdBuffer){
-						if (cmdBuffer.second) commandBuffers.push_back(cmdBuffer.first);
-				});
-
-				VkSubmitInfo submitInfo{};
-				submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-				submitInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
-				submitInfo.pCommandBuffers = commandBuffers.data();
-				VkResult result = vkQueueSubmit(computeQueue, 1, &submitInfo, fences[0]);
-
-				if (result != VK_SUCCESS)
-					throw TinyVkRuntimeError("TinyVulkan: Failed to submit compute command buffer to compute queue!");
-				return result;
+				std::vector<VkCommandBuffer> commandBuffers = commandPool.GetRecordingBuffers();
+				TinyVkTimelinePoint submission = computeTimeline.Submit(commandBuffers, timelineWaits);
+				commandPool.RetireRecordingBuffers(submission);
+				for(TinyVkBuffer* buffer : storageBuffers) buffer->lastUse = submission;
+				for(TinyVkImage* image : storageImages) image->lastUse = submission;
+				return VK_SUCCESS;
 			}
 
 			#pragma endregion
@@ -0,0 +1,681 @@
+#pragma once
+#ifndef TINYVK_TINYVKFRAMEGRAPH
+#define TINYVK_TINYVKFRAMEGRAPH
+	#include "./TinyVulkan.hpp"
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT THE FRAME GRAPH:
+				A TinyVkFrameGraph is a list of passes (callbacks which record commands) that declare which resources
+				they read and write. Barriers between passes are derived from those declarations, so passes never
+				call TransitionLayoutBarrier or vkCmdPipelineBarrier themselves.
+
+				Resources are either imported (existing TinyVkImage/TinyVkBuffer objects which outlive the graph) or
+				transient images which only exist for the duration of a frame. Transients whose lifetimes (first to
+				last pass using them) do not overlap share the same VkDeviceMemory allocation.
+
+				Compile() (called on the first Execute()):
+					1. Culls passes which contribute nothing to an output: a pass is kept if it writes an imported
+					   resource, a resource marked with MarkOutput() or calls SideEffects(), along with every pass
+					   it (transitively) depends on.
+					2. Passes run in declaration order: a pass depends on the most recent earlier writer of each
+					   resource it reads or writes.
+					3. Transient images are created and aliased into as few memory allocations as possible.
+
+				Execute(commandPool):
+					Records every pass into one command buffer with one vkCmdPipelineBarrier2 (TinyVkBarrierBatch) per pass and submits it
+					on the graphics timeline. Passes which write color/depth attachments are wrapped in dynamic
+					rendering (clear if a clear value was given, DONT_CARE on a transient's first use, otherwise LOAD).
+					Imported resources last used on another timeline are waited on by the graphics queue (cross-queue timeline
+					wait). The leased command buffer is retired to the submission (RetireBuffer) and reused once it completes,
+					so Execute only blocks the CPU when every command buffer of the pool is still in flight.
+
+				Rebuilding the graph: call Reset() and declare the passes again (the transients are retired to the
+				TinyVkVulkanDevice after the last execution completes).
+		*/
+
+		/// @brief Handle to a resource imported into or created by a TinyVkFrameGraph.
+		typedef uint32_t TinyVkGraphResource;
+
+		/// @brief How a frame graph pass uses a resource (determines the pipeline stage, access and image layout).
+		enum class TinyVkGraphUsage {
+			TINYVK_GRAPH_COLOR_ATTACHMENT,  /// Image rendered to via dynamic rendering color attachment.
+			TINYVK_GRAPH_DEPTH_ATTACHMENT,  /// Image rendered to via dynamic rendering depth/stencil attachment.
+			TINYVK_GRAPH_SAMPLED,           /// Image read through a sampler in vertex/fragment/compute shaders.
+			TINYVK_GRAPH_STORAGE,           /// Storage image/buffer read or written in vertex/fragment/compute shaders.
+			TINYVK_GRAPH_TRANSFER_SRC,      /// Source of a copy/blit command.
+			TINYVK_GRAPH_TRANSFER_DST,      /// Destination of a copy/blit/clear command.
+			TINYVK_GRAPH_VERTEX,            /// Vertex buffer.
+			TINYVK_GRAPH_INDEX,             /// Index buffer.
+			TINYVK_GRAPH_UNIFORM,           /// Uniform buffer.
+			TINYVK_GRAPH_INDIRECT           /// Indirect draw/dispatch argument buffer.
+		};
+
+		/// @brief Pipeline stage, access and image layout of a single resource use within a frame graph pass.
+		struct TinyVkGraphAccess {
+			TinyVkGraphResource resource;
+			TinyVkGraphUsage usage;
+			bool write;
+			bool hasClear;
+			VkClearValue clearValue;
+
+			VkPipelineStageFlags2 stageMask;
+			VkAccessFlags2 accessMask;
+			VkImageLayout layout;
+
+			/// @brief Creates the resource access and resolves its stage/access/layout from its usage.
+			TinyVkGraphAccess(TinyVkGraphResource resource, TinyVkGraphUsage usage, bool write, bool hasClear = false, VkClearValue clearValue = {})
+			: resource(resource), usage(usage), write(write), hasClear(hasClear), clearValue(clearValue) {
+				const VkPipelineStageFlags2 shaderStages = VK_PIPELINE_STAGE_2_VERTEX_SHADER_BIT | VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+
+				switch(usage) {
+					case TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT:
+						stageMask = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+						accessMask = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT | ((write)? VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT : VK_ACCESS_2_NONE);
+						layout = VK_IMAGE_LAYOUT_COLOR_ATTACHMENT_OPTIMAL;
+					break;
+					case TinyVkGraphUsage::TINYVK_GRAPH_DEPTH_ATTACHMENT:
+						stageMask = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT | VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+						accessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | ((write)? VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT : VK_ACCESS_2_NONE);
+						layout = VK_IMAGE_LAYOUT_DEPTH_STENCIL_ATTACHMENT_OPTIMAL;
+					break;
+					case TinyVkGraphUsage::TINYVK_GRAPH_SAMPLED:
+						stageMask = shaderStages;
+						accessMask = VK_ACCESS_2_SHADER_SAMPLED_READ_BIT;
+						layout = VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL;
+					break;
+					case TinyVkGraphUsage::TINYVK_GRAPH_STORAGE:
+						stageMask = shaderStages;
+						accessMask = VK_ACCESS_2_SHADER_STORAGE_READ_BIT | ((write)? VK_ACCESS_2_SHADER_STORAGE_WRITE_BIT : VK_ACCESS_2_NONE);
+						layout = VK_IMAGE_LAYOUT_GENERAL;
+					break;
+					case TinyVkGraphUsage::TINYVK_GRAPH_TRANSFER_SRC:
+						stageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+						accessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+						layout = VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL;
+					break;
+					case TinyVkGraphUsage::TINYVK_GRAPH_TRANSFER_DST:
+						stageMask = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+						accessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+						layout = VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL;
+					break;
+					case TinyVkGraphUsage::TINYVK_GRAPH_VERTEX:
+						stageMask = VK_PIPELINE_STAGE_2_VERTEX_ATTRIBUTE_INPUT_BIT;
+						accessMask = VK_ACCESS_2_VERTEX_ATTRIBUTE_READ_BIT;
+						layout = VK_IMAGE_LAYOUT_UNDEFINED;
+					break;
+					case TinyVkGraphUsage::TINYVK_GRAPH_INDEX:
+						stageMask = VK_PIPELINE_STAGE_2_INDEX_INPUT_BIT;
+						accessMask = VK_ACCESS_2_INDEX_READ_BIT;
+						layout = VK_IMAGE_LAYOUT_UNDEFINED;
+					break;
+					case TinyVkGraphUsage::TINYVK_GRAPH_UNIFORM:
+						stageMask = shaderStages;
+						accessMask = VK_ACCESS_2_UNIFORM_READ_BIT;
+						layout = VK_IMAGE_LAYOUT_UNDEFINED;
+					break;
+					case TinyVkGraphUsage::TINYVK_GRAPH_INDIRECT:
+					default:
+						stageMask = VK_PIPELINE_STAGE_2_DRAW_INDIRECT_BIT;
+						accessMask = VK_ACCESS_2_INDIRECT_COMMAND_READ_BIT;
+						layout = VK_IMAGE_LAYOUT_UNDEFINED;
+					break;
+				}
+			}
+
+			/// @brief Returns true if this access is a dynamic rendering attachment.
+			bool IsAttachment() const { return usage == TinyVkGraphUsage::TINYVK_GRAPH_COLOR_ATTACHMENT || usage == TinyVkGraphUsage::TINYVK_GRAPH_DEPTH_ATTACHMENT; }
+		};
+
+		/// @brief A single frame graph pass: declared resource accesses and the callback that records its commands.
+		class TinyVkGraphPass {
+		public:
+			const std::string name;
+			std::vector<TinyVkGraphAccess> accesses;
+			bool sideEffects = false;
+			bool culled = false;
+
+			/// @brief Invoked with the frame graph command buffer when the pass executes (after its barriers, inside dynamic rendering for attachment passes).
+			TinyVkInvokable<VkCommandBuffer> onExecute;
+
+			/// @brief Deleted copy constructor (dynamic objects are not copyable).
+			TinyVkGraphPass operator=(const TinyVkGraphPass& pass) = delete;
+
+			TinyVkGraphPass(const std::string& name) : name(name) {}
+
+			/// @brief Declares that this pass reads the resource.
+			TinyVkGraphPass& Read(TinyVkGraphResource resource, TinyVkGraphUsage usage) {
+				accesses.push_back(TinyVkGraphAccess(resource, usage, false));
+				return (*this);
+			}
+
+			/// @brief Declares that this pass writes the resource (attachments are loaded unless they are transient on first use).
+			TinyVkGraphPass& Write(TinyVkGraphResource resource, TinyVkGraphUsage usage) {
+				accesses.push_back(TinyVkGraphAccess(resource, usage, true));
+				return (*this);
+			}
+
+			/// @brief Declares that this pass writes the attachment and clears it to clearValue first.
+			TinyVkGraphPass& Write(TinyVkGraphResource resource, TinyVkGraphUsage usage, VkClearValue clearValue) {
+				accesses.push_back(TinyVkGraphAccess(resource, usage, true, true, clearValue));
+				return (*this);
+			}
+
+			/// @brief Marks this pass as having effects outside of the graph (never culled).
+			TinyVkGraphPass& SideEffects() {
+				sideEffects = true;
+				return (*this);
+			}
+		};
+
+		/// @brief Frame graph which derives barriers from per-pass resource declarations, culls unused passes and aliases transient image memory.
+		class TinyVkFrameGraph : public TinyVkDisposable {
+		private:
+			/// Tracked synchronization state of a resource while recording.
+			struct TinyVkGraphState {
+				VkImageLayout layout = VK_IMAGE_LAYOUT_UNDEFINED;
+				VkPipelineStageFlags2 writeStages = VK_PIPELINE_STAGE_2_NONE;
+				VkAccessFlags2 writeAccess = VK_ACCESS_2_NONE;
+				VkPipelineStageFlags2 readStages = VK_PIPELINE_STAGE_2_NONE;
+				VkPipelineStageFlags2 visibleStages = VK_PIPELINE_STAGE_2_NONE;
+			};
+
+			struct TinyVkGraphResourceEntry {
+				TinyVkImage* image = nullptr;
+				TinyVkBuffer* buffer = nullptr;
+				bool transient = false;
+				bool output = false;
+				VkImageLayout finalLayout = VK_IMAGE_LAYOUT_UNDEFINED;
+
+				TinyVkImageType transientType;
+				VkFormat transientFormat;
+				VkDeviceSize width, height;
+
+				int32_t firstPass = -1, lastPass = -1;
+				int32_t memorySlot = -1;
+				bool touched = false;
+				TinyVkGraphState state;
+			};
+
+			/// Transient memory allocation shared by transients with non-overlapping lifetimes.
+			struct TinyVkGraphMemorySlot {
+				VmaAllocation memory = VK_NULL_HANDLE;
+				VkMemoryRequirements requirements {};
+				int32_t lastPass = -1;
+				VkPipelineStageFlags2 lastStages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+			};
+
+			std::vector<TinyVkGraphPass*> passes;
+			std::vector<TinyVkGraphResourceEntry> resources;
+			std::vector<TinyVkGraphMemorySlot> memorySlots;
+			TinyVkTimelinePoint lastExecution;
+			bool compiled = false;
+
+			VkImage CreateTransientVkImage(const TinyVkGraphResourceEntry& entry) {
+				VkImageCreateInfo imgCreateInfo = {
+					.sType = VK_STRUCTURE_TYPE_IMAGE_CREATE_INFO,
+					.extent.width = static_cast<uint32_t>(entry.width), .extent.height = static_cast<uint32_t>(entry.height),
+					.extent.depth = 1, .mipLevels = 1, .arrayLayers = 1,
+					.format = entry.transientFormat, .initialLayout = VK_IMAGE_LAYOUT_UNDEFINED, .imageType = VK_IMAGE_TYPE_2D,
+					.tiling = VK_IMAGE_TILING_OPTIMAL, .samples = VK_SAMPLE_COUNT_1_BIT,
+					.usage = VK_IMAGE_USAGE_SAMPLED_BIT | VK_IMAGE_USAGE_TRANSFER_DST_BIT | VK_IMAGE_USAGE_TRANSFER_SRC_BIT
+				};
+
+				if (entry.transientType == TinyVkImageType::TINYVK_IMAGE_TYPE_DEPTHSTENCIL) {
+					imgCreateInfo.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
+				} else imgCreateInfo.usage |= VK_IMAGE_USAGE_STORAGE_BIT | VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
+
+				VkImage image;
+				if (vkCreateImage(renderContext.vkdevice.GetLogicalDevice(), &imgCreateInfo, VK_NULL_HANDLE, &image) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Could not create transient frame graph image!");
+				return image;
+			}
+
+			/// @brief Flags passes which do not (transitively) contribute to an imported/output resource as culled.
+			void CullPasses() {
+				std::vector<bool> outputs(resources.size(), false);
+				for(size_t i = 0; i < resources.size(); i++)
+					outputs[i] = !resources[i].transient || resources[i].output;
+				CullPasses(passes, outputs);
+			}
+
+			/// @brief Creates the transient images used by non-culled passes and aliases them into shared memory slots.
+			void AllocateTransients() {
+				for(int32_t p = 0; p < static_cast<int32_t>(passes.size()); p++) {
+					if (passes[p]->culled) continue;
+
+					for(const TinyVkGraphAccess& access : passes[p]->accesses) {
+						TinyVkGraphResourceEntry& entry = resources[access.resource];
+						if (entry.firstPass < 0) entry.firstPass = p;
+						entry.lastPass = p;
+					}
+				}
+
+				std::vector<TinyVkGraphResource> transients;
+				for(TinyVkGraphResource r = 0; r < resources.size(); r++)
+					if (resources[r].transient && resources[r].firstPass >= 0) transients.push_back(r);
+
+				std::sort(transients.begin(), transients.end(), [this](TinyVkGraphResource a, TinyVkGraphResource b) { return resources[a].firstPass < resources[b].firstPass; });
+
+				VkDevice logicalDevice = renderContext.vkdevice.GetLogicalDevice();
+				std::vector<VkImage> images;
+				for(TinyVkGraphResource r : transients) {
+					TinyVkGraphResourceEntry& entry = resources[r];
+					images.push_back(CreateTransientVkImage(entry));
+
+					VkMemoryRequirements requirements;
+					vkGetImageMemoryRequirements(logicalDevice, images.back(), &requirements);
+
+					for(size_t s = 0; s < memorySlots.size() && entry.memorySlot < 0; s++) {
+						TinyVkGraphMemorySlot& slot = memorySlots[s];
+						if (slot.lastPass >= entry.firstPass || (slot.requirements.memoryTypeBits & requirements.memoryTypeBits) == 0) continue;
+
+						slot.requirements.size = std::max(slot.requirements.size, requirements.size);
+						slot.requirements.alignment = std::max(slot.requirements.alignment, requirements.alignment);
+						slot.requirements.memoryTypeBits &= requirements.memoryTypeBits;
+						slot.lastPass = entry.lastPass;
+						entry.memorySlot = static_cast<int32_t>(s);
+					}
+
+					if (entry.memorySlot < 0) {
+						TinyVkGraphMemorySlot slot;
+						slot.requirements = requirements;
+						slot.lastPass = entry.lastPass;
+						memorySlots.push_back(slot);
+						entry.memorySlot = static_cast<int32_t>(memorySlots.size() - 1);
+					}
+				}
+
+				VmaAllocationCreateInfo allocCreateInfo {};
+				allocCreateInfo.preferredFlags = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT;
+				allocCreateInfo.priority = 1.0f;
+
+				for(TinyVkGraphMemorySlot& slot : memorySlots)
+					if (vmaAllocateMemory(renderContext.vkdevice.GetAllocator(), &slot.requirements, &allocCreateInfo, &slot.memory, VK_NULL_HANDLE) != VK_SUCCESS)
+						throw TinyVkRuntimeError("TinyVulkan: Could not allocate transient frame graph memory!");
+
+				// Images must be bound before TinyVkImage creates their views.
+				for(size_t i = 0; i < transients.size(); i++) {
+					TinyVkGraphResourceEntry& entry = resources[transients[i]];
+					if (vmaBindImageMemory(renderContext.vkdevice.GetAllocator(), memorySlots[entry.memorySlot].memory, images[i]) != VK_SUCCESS)
+						throw TinyVkRuntimeError("TinyVulkan: Could not bind transient frame graph memory!");
+
+					entry.image = new TinyVkImage(renderContext, entry.transientType, entry.width, entry.height, images[i], VK_NULL_HANDLE, VK_NULL_HANDLE, entry.transientFormat);
+				}
+			}
+
+			/// @brief Appends the barrier (if any) required before the access and updates the resource's tracked state.
+			void BarrierAccess(const TinyVkGraphAccess& access, TinyVkBarrierBatch& barrierBatch) {
+				TinyVkGraphResourceEntry& entry = resources[access.resource];
+				TinyVkGraphState& state = entry.state;
+				VkImageLayout layout = (entry.image != nullptr)? access.layout : VK_IMAGE_LAYOUT_UNDEFINED;
+
+				if (!entry.touched) {
+					entry.touched = true;
+					state = TinyVkGraphState();
+					state.writeAccess = VK_ACCESS_2_MEMORY_WRITE_BIT;
+
+					// Transients start undefined after the previous user of their memory, imported resources after any earlier submission.
+					if (entry.transient) {
+						state.writeStages = memorySlots[entry.memorySlot].lastStages;
+					} else {
+						state.writeStages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+						if (entry.image != nullptr) state.layout = (VkImageLayout) entry.image->imageLayout;
+					}
+				}
+
+				VkImageLayout oldLayout = state.layout;
+				VkPipelineStageFlags2 srcStages = VK_PIPELINE_STAGE_2_NONE;
+				VkAccessFlags2 srcAccess = VK_ACCESS_2_NONE;
+				bool barrier = false;
+
+				if (layout != state.layout || access.write) {
+					// Layout transitions/writes wait on all earlier reads (WAR) and make earlier writes available (RAW/WAW).
+					barrier = layout != state.layout || state.writeStages != VK_PIPELINE_STAGE_2_NONE || state.readStages != VK_PIPELINE_STAGE_2_NONE;
+					srcStages = state.writeStages | state.readStages;
+					srcAccess = state.writeAccess;
+
+					state.layout = layout;
+					state.writeStages = access.stageMask;
+					state.writeAccess = (access.write)? access.accessMask : VK_ACCESS_2_NONE;
+					state.readStages = (access.write)? VK_PIPELINE_STAGE_2_NONE : access.stageMask;
+					state.visibleStages = access.stageMask;
+				} else {
+					// Read-after-read in the same layout only needs the last write made visible to the new stages.
+					barrier = state.writeStages != VK_PIPELINE_STAGE_2_NONE && (access.stageMask & ~state.visibleStages) != 0;
+					srcStages = state.writeStages;
+					srcAccess = state.writeAccess;
+
+					state.readStages |= access.stageMask;
+					state.visibleStages |= access.stageMask;
+				}
+
+				if (entry.transient)
+					memorySlots[entry.memorySlot].lastStages = state.writeStages | state.readStages;
+
+				if (!barrier) return;
+
+				if (entry.image != nullptr) {
+					barrierBatch.Add(VkImageMemoryBarrier2 {
+						.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
+						.srcStageMask = srcStages, .srcAccessMask = srcAccess,
+						.dstStageMask = access.stageMask, .dstAccessMask = access.accessMask,
+						.oldLayout = oldLayout, .newLayout = layout,
+						.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED, .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+						.image = entry.image->image,
+						.subresourceRange = { .aspectMask = entry.image->aspectFlags, .baseMipLevel = 0, .levelCount = 1, .baseArrayLayer = 0, .layerCount = 1 }
+					});
+				} else {
+					barrierBatch.Add(VkBufferMemoryBarrier2 {
+						.sType = VK_STRUCTURE_TYPE_BUFFER_MEMORY_BARRIER_2,
+						.srcStageMask = srcStages, .srcAccessMask = srcAccess,
+						.dstStageMask = access.stageMask, .dstAccessMask = access.accessMask,
+						.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED, .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
+						.buffer = entry.buffer->buffer, .offset = 0, .size = VK_WHOLE_SIZE
+					});
+				}
+			}
+
+			/// @brief Records a single pass: one batched barrier, optional dynamic rendering scope and the pass callbacks.
+			void RecordPass(VkCommandBuffer commandBuffer, int32_t passIndex) {
+				TinyVkGraphPass* pass = passes[passIndex];
+				TinyVkDebugLabel passLabel(commandBuffer, pass->name);
+				TinyVkBarrierBatch barrierBatch;
+				std::vector<VkAttachmentLoadOp> loadOps;
+
+				for(const TinyVkGraphAccess& access : pass->accesses) {
+					TinyVkGraphResourceEntry& entry = resources[access.resource];
+					bool firstUse = entry.transient && !entry.touched;
+					loadOps.push_back((access.hasClear)? VK_ATTACHMENT_LOAD_OP_CLEAR : ((firstUse)? VK_ATTACHMENT_LOAD_OP_DONT_CARE : VK_ATTACHMENT_LOAD_OP_LOAD));
+					BarrierAccess(access, barrierBatch);
+				}
+				barrierBatch.Flush(commandBuffer);
+
+				std::vector<VkRenderingAttachmentInfoKHR> colorAttachments;
+				VkRenderingAttachmentInfoKHR depthAttachment {};
+				VkRect2D renderArea {};
+				bool hasDepth = false;
+
+				for(size_t i = 0; i < pass->accesses.size(); i++) {
+					const TinyVkGraphAccess& access = pass->accesses[i];
+					if (!access.IsAttachment()) continue;
+
+					TinyVkGraphResourceEntry& entry = resources[access.resource];
+					if (entry.image == nullptr)
+						throw TinyVkRuntimeError("TinyVulkan: Frame graph pass [" + pass->name + "] uses a buffer as an attachment!");
+
+					VkRenderingAttachmentInfoKHR attachmentInfo {};
+					attachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
+					attachmentInfo.imageView = entry.image->imageView;
+					attachmentInfo.imageLayout = access.layout;
+					attachmentInfo.loadOp = loadOps[i];
+					attachmentInfo.storeOp = (entry.transient && !entry.output && entry.lastPass == passIndex)? VK_ATTACHMENT_STORE_OP_DONT_CARE : VK_ATTACHMENT_STORE_OP_STORE;
+					attachmentInfo.clearValue = access.clearValue;
+					renderArea.extent = { static_cast<uint32_t>(entry.image->width), static_cast<uint32_t>(entry.image->height) };
+
+					if (access.usage == TinyVkGraphUsage::TINYVK_GRAPH_DEPTH_ATTACHMENT) {
+						depthAttachment = attachmentInfo;
+						hasDepth = true;
+					} else colorAttachments.push_back(attachmentInfo);
+				}
+
+				if (colorAttachments.size() == 0 && !hasDepth) {
+					pass->onExecute.invoke(commandBuffer);
+					return;
+				}
+
+				VkRenderingInfoKHR dynamicRenderInfo{};
+				dynamicRenderInfo.sType = VK_STRUCTURE_TYPE_RENDERING_INFO_KHR;
+				dynamicRenderInfo.renderArea = renderArea;
+				dynamicRenderInfo.layerCount = 1;
+				dynamicRenderInfo.colorAttachmentCount = static_cast<uint32_t>(colorAttachments.size());
+				dynamicRenderInfo.pColorAttachments = colorAttachments.data();
+				if (hasDepth) dynamicRenderInfo.pDepthAttachment = &depthAttachment;
+
+				VkViewport dynamicViewportKHR{};
+				dynamicViewportKHR.x = 0;
+				dynamicViewportKHR.y = 0;
+				dynamicViewportKHR.width = static_cast<float>(renderArea.extent.width);
+				dynamicViewportKHR.height = static_cast<float>(renderArea.extent.height);
+				dynamicViewportKHR.minDepth = 0.0f;
+				dynamicViewportKHR.maxDepth = 1.0f;
+				vkCmdSetViewport(commandBuffer, 0, 1, &dynamicViewportKHR);
+				vkCmdSetScissor(commandBuffer, 0, 1, &renderArea);
+
+				if (vkCmdBeginRenderingEKHR(renderContext.vkdevice.GetInstance(), commandBuffer, &dynamicRenderInfo) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to begin rendering frame graph pass [" + pass->name + "]!");
+
+				pass->onExecute.invoke(commandBuffer);
+
+				if (vkCmdEndRenderingEKHR(renderContext.vkdevice.GetInstance(), commandBuffer) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to end rendering frame graph pass [" + pass->name + "]!");
+			}
+
+			/// @brief Transitions output images to their requested final layouts.
+			void RecordFinalLayouts(VkCommandBuffer commandBuffer) {
+				TinyVkBarrierBatch barrierBatch;
+
+				for(TinyVkGraphResourceEntry& entry : resources) {
+					if (entry.image == nullptr || entry.finalLayout == VK_IMAGE_LAYOUT_UNDEFINED || !entry.touched || entry.state.layout == entry.finalLayout) continue;
+
+					barrierBatch.Image(entry.image->image, entry.image->aspectFlags, entry.state.layout, entry.finalLayout,
+						entry.state.writeStages | entry.state.readStages, entry.state.writeAccess, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT);
+					entry.state.layout = entry.finalLayout;
+				}
+
+				barrierBatch.Flush(commandBuffer);
+			}
+
+		public:
+			TinyVkRenderContext& renderContext;
+
+			/// @brief Deleted copy constructor (dynamic objects are not copyable).
+			TinyVkFrameGraph operator=(const TinyVkFrameGraph& frameGraph) = delete;
+
+			~TinyVkFrameGraph() { this->Dispose(); }
+
+			/// @brief Retires the transient resources after the last execution and deletes all passes.
+			void Disposable(bool waitIdle) {
+				if (waitIdle) lastExecution.Wait(UINT64_MAX, "TinyVkFrameGraph::Disposable");
+				Reset();
+			}
+
+			/// @brief Creates an empty frame graph (images created by the graph use the render context's device).
+			TinyVkFrameGraph(TinyVkRenderContext& renderContext) : renderContext(renderContext) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+			}
+
+			#pragma region GRAPH_DECLARATION
+
+			/// @brief Imports an existing image: its layout is tracked from (and written back to) image.imageLayout.
+			TinyVkGraphResource ImportImage(TinyVkImage& image) {
+				TinyVkGraphResourceEntry entry;
+				entry.image = &image;
+				resources.push_back(entry);
+				compiled = false;
+				return static_cast<TinyVkGraphResource>(resources.size() - 1);
+			}
+
+			/// @brief Imports an existing buffer.
+			TinyVkGraphResource ImportBuffer(TinyVkBuffer& buffer) {
+				TinyVkGraphResourceEntry entry;
+				entry.buffer = &buffer;
+				resources.push_back(entry);
+				compiled = false;
+				return static_cast<TinyVkGraphResource>(resources.size() - 1);
+			}
+
+			/// @brief Declares a transient image which only lives for the duration of a frame (contents are undefined on its first use).
+			TinyVkGraphResource CreateTransientImage(TinyVkImageType type, VkDeviceSize width, VkDeviceSize height, VkFormat format = VK_FORMAT_R16G16B16A16_UNORM) {
+				if (type == TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN)
+					throw TinyVkRuntimeError("TinyVulkan: Frame graph transient images cannot be swapchain images!");
+
+				TinyVkGraphResourceEntry entry;
+				entry.transient = true;
+				entry.transientType = type;
+				entry.transientFormat = format;
+				entry.width = width;
+				entry.height = height;
+				resources.push_back(entry);
+				compiled = false;
+				return static_cast<TinyVkGraphResource>(resources.size() - 1);
+			}
+
+			/// @brief Marks a resource as a graph output (its writers are never culled), optionally transitioning it to finalLayout after the last pass.
+			void MarkOutput(TinyVkGraphResource resource, TinyVkImageLayout finalLayout = TinyVkImageLayout::TINYVK_UNDEFINED) {
+				resources.at(resource).output = true;
+				resources.at(resource).finalLayout = (VkImageLayout) finalLayout;
+				compiled = false;
+			}
+
+			/// @brief Adds a pass which records its commands via the callback (declare its accesses with Read/Write on the returned pass).
+			TinyVkGraphPass& AddPass(const std::string& name, TinyVkCallback<VkCommandBuffer> callback) {
+				TinyVkGraphPass* pass = new TinyVkGraphPass(name);
+				pass->onExecute.hook(callback);
+				passes.push_back(pass);
+				compiled = false;
+				return (*pass);
+			}
+
+			/// @brief Returns the image of a resource (transient images are only available after Compile()).
+			TinyVkImage* GetImage(TinyVkGraphResource resource) { return resources.at(resource).image; }
+
+			/// @brief Returns the buffer of a resource.
+			TinyVkBuffer* GetBuffer(TinyVkGraphResource resource) { return resources.at(resource).buffer; }
+
+			/// @brief Returns true if the pass was culled by the last Compile().
+			bool IsCulled(const TinyVkGraphPass& pass) { return pass.culled; }
+
+			/// @brief Returns the number of memory allocations backing the transient images (after Compile()).
+			size_t GetTransientAllocationCount() { return memorySlots.size(); }
+
+			/// @brief Flags passes which do not (transitively) contribute to an output resource (outputs[resource], imported or MarkOutput()) as culled.
+			/// Passes run in declaration order, so a kept pass keeps the most recent earlier writer of every resource it reads or loads.
+			static void CullPasses(const std::vector<TinyVkGraphPass*>& passes, const std::vector<bool>& outputs) {
+				std::vector<bool> needed = outputs;
+
+				for(int32_t p = static_cast<int32_t>(passes.size()) - 1; p >= 0; p--) {
+					TinyVkGraphPass* pass = passes[p];
+					pass->culled = !pass->sideEffects;
+
+					for(const TinyVkGraphAccess& access : pass->accesses)
+						if (access.write && needed[access.resource]) pass->culled = false;
+
+					if (pass->culled) continue;
+
+					// Cleared writes do not depend on earlier writers: every other access does.
+					for(const TinyVkGraphAccess& access : pass->accesses)
+						if (access.write && access.hasClear && !outputs[access.resource])
+							needed[access.resource] = false;
+					for(const TinyVkGraphAccess& access : pass->accesses)
+						if (!(access.write && access.hasClear)) needed[access.resource] = true;
+				}
+			}
+
+			#pragma endregion
+			#pragma region GRAPH_COMPILATION_AND_EXECUTION
+
+			/// @brief Culls unused passes and creates/aliases the transient images (called automatically by Execute()).
+			void Compile() {
+				if (compiled) return;
+
+				for(TinyVkGraphPass* pass : passes)
+					for(const TinyVkGraphAccess& access : pass->accesses)
+						if (access.resource >= resources.size())
+							throw TinyVkRuntimeError("TinyVulkan: Frame graph pass [" + pass->name + "] uses an unknown resource!");
+
+				ReleaseTransients();
+				CullPasses();
+				AllocateTransients();
+				compiled = true;
+			}
+
+			/// @brief Records all passes into one command buffer leased from commandPool and submits it on the graphics timeline.
+			/// Imported resources last used on another timeline (e.g. by a TinyVkComputeRenderer) are waited on by the GPU, not the CPU.
+			TinyVkTimelinePoint Execute(TinyVkCommandPool& commandPool, const std::vector<TinyVkSemaphoreWait>& waits = {}) {
+				Compile();
+
+				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = commandPool.LeaseBuffer();
+				VkCommandBuffer commandBuffer = bufferIndexPair.first;
+
+				VkCommandBufferBeginInfo beginInfo{};
+				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+				if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to record frame graph command buffer!");
+
+				for(TinyVkGraphResourceEntry& entry : resources) entry.touched = false;
+				for(TinyVkGraphMemorySlot& slot : memorySlots) slot.lastStages = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+
+				for(int32_t p = 0; p < static_cast<int32_t>(passes.size()); p++)
+					if (!passes[p]->culled) RecordPass(commandBuffer, p);
+				RecordFinalLayouts(commandBuffer);
+
+				if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to record frame graph command buffer!");
+
+				TinyVkTimeline& graphicsTimeline = renderContext.vkdevice.GetGraphicsTimeline();
+				std::vector<TinyVkSemaphoreWait> timelineWaits = waits;
+				for(TinyVkGraphResourceEntry& entry : resources) {
+					if (!entry.touched || entry.transient) continue;
+
+					TinyVkTimelinePoint lastUse = (entry.image != nullptr)? entry.image->lastUse : entry.buffer->lastUse;
+					if (lastUse.timeline == &graphicsTimeline || lastUse.IsComplete()) continue;
+
+					auto waitInfo = std::find_if(timelineWaits.begin(), timelineWaits.end(), [&lastUse](TinyVkSemaphoreWait& wait) { return wait.semaphore == lastUse.timeline->GetSemaphore(); });
+					if (waitInfo == timelineWaits.end()) {
+						timelineWaits.push_back({ lastUse.timeline->GetSemaphore(), lastUse.value, VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT });
+					} else waitInfo->value = std::max(waitInfo->value, lastUse.value);
+				}
+
+				lastExecution = graphicsTimeline.Submit({ commandBuffer }, timelineWaits);
+				commandPool.RetireBuffer(bufferIndexPair, lastExecution);
+
+				for(TinyVkGraphResourceEntry& entry : resources) {
+					if (!entry.touched) continue;
+
+					if (entry.image != nullptr) {
+						entry.image->lastUse = lastExecution;
+						entry.image->imageLayout = (TinyVkImageLayout) entry.state.layout;
+					} else entry.buffer->lastUse = lastExecution;
+				}
+
+				return lastExecution;
+			}
+
+			/// @brief Retires the transient images/memory to the TinyVkVulkanDevice (destroyed once the last execution completes).
+			void ReleaseTransients() {
+				TinyVkVulkanDevice& vkdevice = renderContext.vkdevice;
+				VmaAllocator allocator = vkdevice.GetAllocator();
+
+				for(TinyVkGraphResourceEntry& entry : resources) {
+					entry.firstPass = entry.lastPass = entry.memorySlot = -1;
+					if (!entry.transient || entry.image == nullptr) continue;
+
+					TinyVkImage* image = entry.image;
+					vkdevice.RetireResource(lastExecution, [image]() { delete image; });
+					entry.image = nullptr;
+				}
+
+				for(TinyVkGraphMemorySlot& slot : memorySlots) {
+					VmaAllocation memory = slot.memory;
+					if (memory != VK_NULL_HANDLE) vkdevice.RetireResource(lastExecution, [allocator, memory]() { vmaFreeMemory(allocator, memory); });
+				}
+
+				memorySlots.clear();
+				compiled = false;
+			}
+
+			/// @brief Removes all passes and resources (retiring the transients) so the graph can be declared again.
+			void Reset() {
+				ReleaseTransients();
+
+				for(TinyVkGraphPass* pass : passes) delete pass;
+				passes.clear();
+				resources.clear();
+			}
+
+			#pragma endregion
+		};
+	}
+#endif
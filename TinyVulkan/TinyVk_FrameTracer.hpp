@@ -0,0 +1,254 @@
+#pragma once
+#ifndef TINYVK_TINYVKFRAMETRACER
+#define TINYVK_TINYVKFRAMETRACER
+	#include "./TinyVulkan.hpp"
+	#include <chrono>
+	#include <memory>
+	#include <mutex>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT THE FRAME TRACER:
+				Records CPU begin/end scopes into a fixed size ring buffer owned by the recording thread (no locks or
+				allocations once a thread's buffer exists, old events are overwritten when the buffer wraps around).
+				ExportChromeTrace() / SaveChromeTrace() write every thread's buffer as Chrome trace JSON which can be
+				opened in Perfetto (ui.perfetto.dev) or chrome://tracing.
+
+				The library's own scopes (swapchain image acquisition and frame reuse waits, onRenderEvents, TinyVkInvokable
+				dispatch, blocking timeline waits, transfer waits and presentation) and the TINYVK_TRACE_* macros are only
+				compiled in when TINYVK_FRAME_TRACING is defined before including TinyVulkan.hpp, otherwise they expand to nothing.
+				Tracing can also be toggled at runtime with TinyVkFrameTracer::Instance().SetEnabled(...).
+
+				Scope/category names are stored as pointers and must outlive the export (string literals).
+		*/
+
+		/// @brief A single recorded CPU scope ('X') or instant marker ('i') in nanoseconds since the tracer's epoch.
+		struct TinyVkTraceEvent {
+			const char* name;
+			const char* category;
+			uint64_t beginNs;
+			uint64_t endNs;
+			char phase;
+		};
+
+		/// @brief Per-thread ring buffer of trace events (single writer: the owning thread).
+		class TinyVkTraceBuffer {
+		public:
+			std::vector<TinyVkTraceEvent> events;
+			std::atomic<uint64_t> head;
+			std::atomic<uint64_t> tail;
+			uint32_t threadId;
+			std::string threadName;
+
+			TinyVkTraceBuffer(uint32_t threadId, size_t capacity) : events(std::max<size_t>(capacity, 1)), head(0), tail(0), threadId(threadId) {}
+
+			/// @brief Writes an event into the next slot (overwriting the oldest event when full).
+			inline void Push(const TinyVkTraceEvent& event) {
+				uint64_t index = head.load(std::memory_order_relaxed);
+				events[index % events.size()] = event;
+				head.store(index + 1, std::memory_order_release);
+			}
+		};
+
+		/// @brief Process-wide CPU tracer that owns the per-thread trace buffers and exports them as Chrome trace JSON.
+		class TinyVkFrameTracer {
+		private:
+			std::timed_mutex registry_lock;
+			std::vector<std::shared_ptr<TinyVkTraceBuffer>> buffers;
+			std::atomic_bool enabled;
+			std::atomic<size_t> bufferCapacity;
+			std::atomic<uint64_t> frameCount;
+			std::chrono::steady_clock::time_point epoch;
+
+			TinyVkFrameTracer() : enabled(true), bufferCapacity(16384), frameCount(0), epoch(std::chrono::steady_clock::now()) {}
+
+			/// @brief Escapes a string for a JSON string literal.
+			static std::string EscapeJson(const char* text) {
+				std::string escaped;
+				for(const char* c = (text != nullptr)? text : ""; *c != '\0'; c++) {
+					switch(*c) {
+						case '"': escaped += "\\\""; break;
+						case '\\': escaped += "\\\\"; break;
+						case '\n': escaped += "\\n"; break;
+						case '\t': escaped += "\\t"; break;
+						default:
+							if (static_cast<unsigned char>(*c) < 0x20) continue;
+							escaped += *c;
+					}
+				}
+				return escaped;
+			}
+
+			/// @brief Copies the live events of a buffer, discarding slots the owning thread overwrote during the copy.
+			static std::vector<TinyVkTraceEvent> CopyEvents(TinyVkTraceBuffer& buffer) {
+				const uint64_t capacity = buffer.events.size();
+				uint64_t head = buffer.head.load(std::memory_order_acquire);
+				uint64_t first = std::max(buffer.tail.load(), (head > capacity)? head - capacity : 0);
+
+				std::vector<TinyVkTraceEvent> copied;
+				for(uint64_t i = first; i < head; i++) copied.push_back(buffer.events[i % capacity]);
+
+				uint64_t overwritten = buffer.head.load(std::memory_order_acquire);
+				overwritten = (overwritten > capacity)? overwritten - capacity : 0;
+				if (overwritten > first) copied.erase(copied.begin(), copied.begin() + std::min<uint64_t>(overwritten - first, copied.size()));
+				return copied;
+			}
+
+		public:
+			TinyVkFrameTracer(const TinyVkFrameTracer&) = delete;
+			TinyVkFrameTracer operator=(const TinyVkFrameTracer&) = delete;
+
+			/// @brief Returns the process-wide tracer.
+			static TinyVkFrameTracer& Instance() {
+				static TinyVkFrameTracer tracer;
+				return tracer;
+			}
+
+			/// @brief Returns the current time in nanoseconds since the tracer's epoch.
+			inline uint64_t NowNs() {
+				return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - epoch).count());
+			}
+
+			/// @brief Returns the calling thread's trace buffer (registered on first use).
+			TinyVkTraceBuffer& ThreadBuffer() {
+				thread_local std::shared_ptr<TinyVkTraceBuffer> threadBuffer;
+				if (!threadBuffer) {
+					timed_guard<false> registryLock(registry_lock);
+					threadBuffer = std::make_shared<TinyVkTraceBuffer>(static_cast<uint32_t>(buffers.size() + 1), bufferCapacity.load());
+					buffers.push_back(threadBuffer);
+				}
+				return *threadBuffer;
+			}
+
+			/// @brief Enables/disables recording at runtime (scopes check this once when opened).
+			void SetEnabled(bool enable) { enabled.store(enable, std::memory_order_relaxed); }
+
+			/// @brief Returns true if events are currently being recorded.
+			inline bool IsEnabled() { return enabled.load(std::memory_order_relaxed); }
+
+			/// @brief Sets the event capacity of trace buffers created after this call (threads which have not recorded yet).
+			void SetBufferCapacity(size_t capacity) { bufferCapacity.store(std::max<size_t>(capacity, 1)); }
+
+			/// @brief Names the calling thread in the exported trace.
+			void SetThreadName(const std::string& name) {
+				TinyVkTraceBuffer& buffer = ThreadBuffer();
+				timed_guard<false> registryLock(registry_lock);
+				buffer.threadName = name;
+			}
+
+			/// @brief Records a completed scope on the calling thread.
+			inline void Record(const char* name, const char* category, uint64_t beginNs, uint64_t endNs) {
+				if (!IsEnabled()) return;
+				ThreadBuffer().Push({ name, category, beginNs, endNs, 'X' });
+			}
+
+			/// @brief Records an instant marker on the calling thread.
+			inline void Mark(const char* name, const char* category = "tinyvk") {
+				if (!IsEnabled()) return;
+				uint64_t now = NowNs();
+				ThreadBuffer().Push({ name, category, now, now, 'i' });
+			}
+
+			/// @brief Records a frame boundary marker and returns the frame number.
+			uint64_t MarkFrame() {
+				Mark("Frame", "frame");
+				return frameCount.fetch_add(1) + 1;
+			}
+
+			/// @brief Returns the number of frame markers recorded.
+			uint64_t GetFrameCount() { return frameCount.load(); }
+
+			/// @brief Drops every recorded event (threads keep their buffers).
+			void Clear() {
+				timed_guard<false> registryLock(registry_lock);
+				for(std::shared_ptr<TinyVkTraceBuffer>& buffer : buffers)
+					buffer->tail.store(buffer->head.load(std::memory_order_acquire));
+			}
+
+			/// @brief Returns the recorded events of every thread as Chrome trace JSON (trace event format, microsecond timestamps).
+			std::string ExportChromeTrace() {
+				std::vector<std::shared_ptr<TinyVkTraceBuffer>> snapshot;
+				std::vector<std::string> threadNames;
+				{
+					timed_guard<false> registryLock(registry_lock);
+					snapshot = buffers;
+					for(std::shared_ptr<TinyVkTraceBuffer>& buffer : buffers) threadNames.push_back(buffer->threadName);
+				}
+
+				std::ostringstream json;
+				json.setf(std::ios::fixed);
+				json.precision(3);
+				json << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[";
+				json << "{\"name\":\"process_name\",\"ph\":\"M\",\"pid\":1,\"tid\":0,\"args\":{\"name\":\"" << TVK_RENDERER_NAME << "\"}}";
+
+				for(size_t i = 0; i < snapshot.size(); i++) {
+					uint32_t tid = snapshot[i]->threadId;
+					std::string threadName = (threadNames[i].empty())? "Thread " + std::to_string(tid) : threadNames[i];
+					json << ",\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":" << tid << ",\"args\":{\"name\":\"" << EscapeJson(threadName.c_str()) << "\"}}";
+
+					for(const TinyVkTraceEvent& event : CopyEvents(*snapshot[i])) {
+						json << ",\n{\"name\":\"" << EscapeJson(event.name) << "\",\"cat\":\"" << EscapeJson(event.category)
+							<< "\",\"ph\":\"" << event.phase << "\",\"pid\":1,\"tid\":" << tid << ",\"ts\":" << (event.beginNs / 1000.0);
+
+						if (event.phase == 'X') {
+							json << ",\"dur\":" << ((event.endNs - event.beginNs) / 1000.0);
+						} else json << ",\"s\":\"t\"";
+						json << "}";
+					}
+				}
+
+				json << "\n]}\n";
+				return json.str();
+			}
+
+			/// @brief Writes the Chrome trace JSON to a file, returns false if the file could not be written.
+			bool SaveChromeTrace(const std::string& path) {
+				std::ofstream file(path, std::ios::out | std::ios::trunc);
+				if (!file.is_open()) return false;
+				file << ExportChromeTrace();
+				return file.good();
+			}
+		};
+
+		/// @brief Scoped CPU trace event: records the time between construction and destruction on the calling thread.
+		class TinyVkTraceScope {
+		private:
+			const char* name;
+			const char* category;
+			uint64_t beginNs;
+
+		public:
+			TinyVkTraceScope(const char* name, const char* category = "user") : name(name), category(category), beginNs(0) {
+				TinyVkFrameTracer& tracer = TinyVkFrameTracer::Instance();
+				if (tracer.IsEnabled()) { beginNs = tracer.NowNs(); } else this->name = nullptr;
+			}
+
+			~TinyVkTraceScope() {
+				if (name == nullptr) return;
+				TinyVkFrameTracer& tracer = TinyVkFrameTracer::Instance();
+				tracer.Record(name, category, beginNs, tracer.NowNs());
+			}
+
+			TinyVkTraceScope(const TinyVkTraceScope&) = delete;
+			TinyVkTraceScope operator=(const TinyVkTraceScope&) = delete;
+		};
+	}
+
+	#define TINYVK_TRACE_CONCAT_INNER(a, b) a##b
+	#define TINYVK_TRACE_CONCAT(a, b) TINYVK_TRACE_CONCAT_INNER(a, b)
+	#ifdef TINYVK_FRAME_TRACING
+		/// Opens a traced CPU scope (category "user") until the end of the enclosing block.
+		#define TINYVK_TRACE_SCOPE(name) TINYVULKAN_NAMESPACE::TinyVkTraceScope TINYVK_TRACE_CONCAT(tinyvkTraceScope, __LINE__)(name)
+		/// Opens a traced CPU scope with a category until the end of the enclosing block.
+		#define TINYVK_TRACE_SCOPE_CATEGORY(name, category) TINYVULKAN_NAMESPACE::TinyVkTraceScope TINYVK_TRACE_CONCAT(tinyvkTraceScope, __LINE__)(name, category)
+		/// Records an instant marker.
+		#define TINYVK_TRACE_MARK(name) TINYVULKAN_NAMESPACE::TinyVkFrameTracer::Instance().Mark(name, "user")
+		/// Records a frame boundary marker.
+		#define TINYVK_TRACE_FRAME() TINYVULKAN_NAMESPACE::TinyVkFrameTracer::Instance().MarkFrame()
+	#else
+		#define TINYVK_TRACE_SCOPE(name) ((void)0)
+		#define TINYVK_TRACE_SCOPE_CATEGORY(name, category) ((void)0)
+		#define TINYVK_TRACE_MARK(name) ((void)0)
+		#define TINYVK_TRACE_FRAME() ((void)0)
+	#endif
+#endif
@@ -0,0 +1,292 @@
+#pragma once
+#ifndef TINYVK_TINYVKGPUPROFILER
+#define TINYVK_TINYVKGPUPROFILER
+	#include "./TinyVulkan.hpp"
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT THE GPU PROFILER:
+				The TinyVkGpuProfiler measures GPU time of named scopes with vkCmdWriteTimestamp2 pairs (TOP_OF_PIPE at
+				BeginScope, BOTTOM_OF_PIPE at EndScope) written into a timestamp VkQueryPool. The query pool is split
+				into frameLatency ranges (one per profiled frame) which are read back asynchronously:
+
+					profiler.BeginFrame();		// Collects every completed frame, selects the next query range.
+					...record & submit...		// Scopes recorded by the renderers, transfers or TinyVkGpuScope.
+					profiler.EndFrame();		// Marks the frame's submissions (graphics/compute timelines).
+
+				A frame is read back (vkGetQueryPoolResults without WAIT) once the timeline values submitted before its
+				EndFrame() have completed, then its queries are reset from the host (hostQueryReset). If the range of
+				a frame is still in flight when it comes up for reuse the frame is skipped (GetDroppedFrames()) instead
+				of stalling. Timestamps are masked to the valid bits of the queue family the scope was recorded for
+				(graphics or compute, scopes on a family without timestamps are skipped), converted to nanoseconds
+				with the device's timestampPeriod and aggregated per scope name (min/avg/max/last). Scopes must be recorded into command buffers submitted before EndFrame().
+
+				Renderers record their own scopes when given a profiler: TinyVkRenderContext.gpuProfiler (graphics,
+				swapchain and image/buffer transfers) and TinyVkComputeRenderer.gpuProfiler (records and dispatches).
+		*/
+
+		/// @brief Aggregated GPU time of a named profiler scope (nanoseconds).
+		struct TinyVkGpuScopeStats {
+			std::string name;
+			size_t count = 0;
+			double lastNs = 0.0, minNs = 0.0, maxNs = 0.0, totalNs = 0.0;
+
+			/// @brief Returns the average GPU time of the scope in nanoseconds.
+			double AverageNs() const { return (count > 0)? totalNs / static_cast<double>(count) : 0.0; }
+
+			/// @brief Adds a single GPU time measurement to the scope statistics.
+			void Record(double ns) {
+				minNs = (count == 0)? ns : std::min(minNs, ns);
+				maxNs = (count == 0)? ns : std::max(maxNs, ns);
+				lastNs = ns;
+				totalNs += ns;
+				count ++;
+			}
+		};
+
+		/// @brief Query pool based GPU timestamp profiler with asynchronous (non-stalling) readback.
+		class TinyVkGpuProfiler : public TinyVkDisposable {
+		private:
+			struct TinyVkGpuProfilerScope {
+				std::string name;
+				uint32_t query;
+				uint64_t timestampMask; /// Valid timestamp bits of the queue family the scope was recorded for.
+			};
+
+			struct TinyVkGpuProfilerFrame {
+				uint32_t firstQuery = 0;
+				uint32_t queryCount = 0;
+				bool pending = false;
+				std::vector<TinyVkGpuProfilerScope> scopes;
+				std::vector<TinyVkTimelinePoint> submissions;
+			};
+
+			/// Open scope: command buffer, frame it was opened in and scope index (UINT32_MAX if dropped).
+			struct TinyVkGpuOpenScope {
+				VkCommandBuffer commandBuffer;
+				size_t frame;
+				uint32_t scope;
+			};
+
+			std::timed_mutex profiler_lock;
+			VkQueryPool queryPool = VK_NULL_HANDLE;
+			std::vector<TinyVkGpuProfilerFrame> frames;
+			std::vector<TinyVkGpuOpenScope> openScopes;
+			std::vector<TinyVkGpuScopeStats> scopeStats;
+			uint32_t queriesPerFrame;
+			size_t currentFrame = 0;
+			bool recording = false;
+			bool supported = false;
+			double timestampPeriod = 1.0;
+			uint64_t graphicsTimestampMask = 0, computeTimestampMask = 0; /// Valid timestamp bits of the graphics/compute queue families (0 if unsupported).
+			size_t droppedFrames = 0, droppedScopes = 0;
+
+			/// @brief Reads back and resets a frame's queries if all of its submissions completed (profiler_lock must be held).
+			bool CollectFrame(TinyVkGpuProfilerFrame& frame) {
+				if (!frame.pending) return true;
+
+				for(TinyVkTimelinePoint& submission : frame.submissions)
+					if (!submission.IsComplete()) return false;
+
+				// Pairs of [timestamp, availability]: scopes recorded into never submitted command buffers stay unavailable.
+				std::vector<uint64_t> results(static_cast<size_t>(frame.queryCount) * 2, 0);
+				vkGetQueryPoolResults(vkdevice.GetLogicalDevice(), queryPool, frame.firstQuery, frame.queryCount, results.size() * sizeof(uint64_t), results.data(),
+					sizeof(uint64_t) * 2, VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+				for(TinyVkGpuProfilerScope& scope : frame.scopes) {
+					size_t begin = static_cast<size_t>(scope.query - frame.firstQuery) * 2, end = begin + 2;
+					if (results[begin + 1] == 0 || results[end + 1] == 0) { droppedScopes ++; continue; }
+
+					double ns = static_cast<double>((results[end] - results[begin]) & scope.timestampMask) * timestampPeriod;
+					auto stats = std::find_if(scopeStats.begin(), scopeStats.end(), [&scope](TinyVkGpuScopeStats& s) { return s.name == scope.name; });
+					if (stats == scopeStats.end()) {
+						scopeStats.push_back(TinyVkGpuScopeStats { .name = scope.name });
+						stats = scopeStats.end() - 1;
+					}
+					stats->Record(ns);
+				}
+
+				vkResetQueryPool(vkdevice.GetLogicalDevice(), queryPool, frame.firstQuery, queriesPerFrame);
+				frame.queryCount = 0;
+				frame.pending = false;
+				frame.scopes.clear();
+				frame.submissions.clear();
+				return true;
+			}
+
+		public:
+			TinyVkVulkanDevice& vkdevice;
+
+			/// @brief Deleted copy constructor (dynamic objects are not copyable).
+			TinyVkGpuProfiler operator=(const TinyVkGpuProfiler& profiler) = delete;
+
+			~TinyVkGpuProfiler() { this->Dispose(); }
+
+			/// @brief Waits on the submissions of frames still in flight (their queries are written by the GPU) and destroys the query pool.
+			void Disposable(bool waitIdle) {
+				for(TinyVkGpuProfilerFrame& frame : frames)
+					for(TinyVkTimelinePoint& submission : frame.submissions) submission.Wait(UINT64_MAX, "TinyVkGpuProfiler::Disposable");
+
+				if (queryPool != VK_NULL_HANDLE)
+					vkDestroyQueryPool(vkdevice.GetLogicalDevice(), queryPool, VK_NULL_HANDLE);
+			}
+
+			/// @brief Creates the timestamp query pool for frameLatency in-flight profiled frames of up to maxScopesPerFrame scopes each.
+			TinyVkGpuProfiler(TinyVkVulkanDevice& vkdevice, size_t frameLatency = 4, uint32_t maxScopesPerFrame = 256)
+			: vkdevice(vkdevice), queriesPerFrame(maxScopesPerFrame * 2) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				VkPhysicalDeviceProperties properties {};
+				vkGetPhysicalDeviceProperties(vkdevice.GetPhysicalDevice(), &properties);
+				timestampPeriod = static_cast<double>(properties.limits.timestampPeriod);
+
+				uint32_t queueFamilyCount = 0;
+				vkGetPhysicalDeviceQueueFamilyProperties(vkdevice.GetPhysicalDevice(), &queueFamilyCount, VK_NULL_HANDLE);
+				std::vector<VkQueueFamilyProperties> queueFamilies(queueFamilyCount);
+				vkGetPhysicalDeviceQueueFamilyProperties(vkdevice.GetPhysicalDevice(), &queueFamilyCount, queueFamilies.data());
+
+				auto familyMask = [&queueFamilies](uint32_t family) {
+					uint32_t validBits = queueFamilies[family].timestampValidBits;
+					return (validBits >= 64)? ~0ULL : ((1ULL << validBits) - 1ULL);
+				};
+				graphicsTimestampMask = familyMask(vkdevice.GetQueueFamilies().graphicsFamily);
+				computeTimestampMask = (vkdevice.GetQueueFamilies().HasComputeFamily())? familyMask(vkdevice.GetQueueFamilies().computeFamily) : graphicsTimestampMask;
+				supported = (graphicsTimestampMask != 0 || computeTimestampMask != 0) && properties.limits.timestampPeriod > 0.0f;
+
+				#if TVK_VALIDATION_LAYERS
+				if (!supported) std::cout << "TinyVulkan: GPU timestamps are not supported on the graphics/compute queues, TinyVkGpuProfiler is disabled." << std::endl;
+				else if (graphicsTimestampMask == 0 || computeTimestampMask == 0)
+					std::cout << "TinyVulkan: GPU timestamps are not supported on the " << ((graphicsTimestampMask == 0)? "graphics" : "compute") << " queue, its TinyVkGpuProfiler scopes are skipped." << std::endl;
+				#endif
+
+				if (!supported) return;
+
+				frames.resize(std::max(frameLatency, static_cast<size_t>(1)));
+				for(size_t i = 0; i < frames.size(); i++) frames[i].firstQuery = static_cast<uint32_t>(i) * queriesPerFrame;
+
+				VkQueryPoolCreateInfo queryPoolInfo {};
+				queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+				queryPoolInfo.queryType = VK_QUERY_TYPE_TIMESTAMP;
+				queryPoolInfo.queryCount = queriesPerFrame * static_cast<uint32_t>(frames.size());
+
+				if (vkCreateQueryPool(vkdevice.GetLogicalDevice(), &queryPoolInfo, VK_NULL_HANDLE, &queryPool) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to create GPU profiler timestamp query pool!");
+				vkResetQueryPool(vkdevice.GetLogicalDevice(), queryPool, 0, queryPoolInfo.queryCount);
+			}
+
+			#pragma region FRAME_PROFILING
+
+			/// @brief Collects the results of completed frames and starts profiling a new frame (skipped if its query range is still in flight).
+			void BeginFrame() {
+				timed_guard<false> profilerLock(profiler_lock);
+				if (!supported) return;
+
+				for(TinyVkGpuProfilerFrame& frame : frames) CollectFrame(frame);
+
+				recording = !frames[currentFrame % frames.size()].pending;
+				if (!recording) droppedFrames ++;
+				openScopes.clear();
+			}
+
+			/// @brief Ends the profiled frame: its results are read back once the graphics/compute submissions made so far complete.
+			void EndFrame() {
+				timed_guard<false> profilerLock(profiler_lock);
+				if (!supported) return;
+
+				if (recording) {
+					TinyVkGpuProfilerFrame& frame = frames[currentFrame % frames.size()];
+					frame.pending = frame.queryCount > 0;
+					frame.submissions = { vkdevice.GetGraphicsTimeline().GetSubmittedPoint() };
+					if (&vkdevice.GetComputeTimeline() != &vkdevice.GetGraphicsTimeline())
+						frame.submissions.push_back(vkdevice.GetComputeTimeline().GetSubmittedPoint());
+				}
+
+				recording = false;
+				currentFrame ++;
+			}
+
+			/// @brief Writes the begin timestamp of a named scope to the command buffer (scopes nest per command buffer), computeQueue if it is submitted to the compute queue.
+			/// Scopes on a queue family without timestamp support (0 valid bits) are skipped.
+			void BeginScope(VkCommandBuffer commandBuffer, const std::string& name, bool computeQueue = false) {
+				if (!supported) return;
+				timed_guard<false> profilerLock(profiler_lock);
+				TinyVkGpuOpenScope openScope { commandBuffer, currentFrame, UINT32_MAX };
+				uint64_t timestampMask = (computeQueue)? computeTimestampMask : graphicsTimestampMask;
+
+				if (recording && timestampMask != 0) {
+					TinyVkGpuProfilerFrame& frame = frames[currentFrame % frames.size()];
+					if (frame.queryCount + 2 <= queriesPerFrame) {
+						uint32_t query = frame.firstQuery + frame.queryCount;
+						frame.queryCount += 2;
+						openScope.scope = static_cast<uint32_t>(frame.scopes.size());
+						frame.scopes.push_back({ name, query, timestampMask });
+						vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_TOP_OF_PIPE_BIT, queryPool, query);
+					} else droppedScopes ++;
+				}
+
+				openScopes.push_back(openScope);
+			}
+
+			/// @brief Writes the end timestamp of the innermost open scope of the command buffer.
+			void EndScope(VkCommandBuffer commandBuffer) {
+				if (!supported) return;
+				timed_guard<false> profilerLock(profiler_lock);
+				auto openScope = std::find_if(openScopes.rbegin(), openScopes.rend(), [commandBuffer](TinyVkGpuOpenScope& scope) { return scope.commandBuffer == commandBuffer; });
+				if (openScope == openScopes.rend()) return;
+
+				TinyVkGpuOpenScope scope = *openScope;
+				openScopes.erase(std::next(openScope).base());
+
+				if (!recording || scope.frame != currentFrame || scope.scope == UINT32_MAX) return;
+				TinyVkGpuProfilerFrame& frame = frames[currentFrame % frames.size()];
+				vkCmdWriteTimestamp2(commandBuffer, VK_PIPELINE_STAGE_2_BOTTOM_OF_PIPE_BIT, queryPool, frame.scopes[scope.scope].query + 1);
+			}
+
+			#pragma endregion
+			#pragma region PROFILER_RESULTS
+
+			/// @brief Returns the aggregated statistics of every scope read back so far.
+			std::vector<TinyVkGpuScopeStats> GetScopeStats() {
+				timed_guard<false> profilerLock(profiler_lock);
+				return scopeStats;
+			}
+
+			/// @brief Clears the aggregated scope statistics and dropped frame/scope counters.
+			void ResetStats() {
+				timed_guard<false> profilerLock(profiler_lock);
+				scopeStats.clear();
+				droppedFrames = droppedScopes = 0;
+			}
+
+			/// @brief Returns the number of frames skipped because their query range was still in flight.
+			size_t GetDroppedFrames() { return droppedFrames; }
+
+			/// @brief Returns the number of scopes without results (query range full or never submitted).
+			size_t GetDroppedScopes() { return droppedScopes; }
+
+			/// @brief Returns true if the graphics or compute queue supports timestamps (otherwise all profiler calls are no-ops).
+			bool IsSupported() { return supported; }
+
+			/// @brief Returns the number of nanoseconds per timestamp tick.
+			double GetTimestampPeriod() { return timestampPeriod; }
+
+			#pragma endregion
+		};
+
+		/// @brief Scoped GPU profiler marker: BeginScope on construction, EndScope on destruction (no-op for a nullptr profiler).
+		class TinyVkGpuScope {
+		private:
+			TinyVkGpuProfiler* profiler;
+			VkCommandBuffer commandBuffer;
+
+		public:
+			TinyVkGpuScope(TinyVkGpuProfiler* profiler, VkCommandBuffer commandBuffer, const std::string& name, bool computeQueue = false) : profiler(profiler), commandBuffer(commandBuffer) {
+				if (profiler != nullptr) profiler->BeginScope(commandBuffer, name, computeQueue);
+			}
+
+			~TinyVkGpuScope() {
+				if (profiler != nullptr) profiler->EndScope(commandBuffer);
+			}
+		};
+	}
+#endif
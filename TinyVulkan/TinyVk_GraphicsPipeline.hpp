@@ -2,6 +2,7 @@
 #ifndef TINYVK_TINYVGRAPHICSPIPELINE
 #define TINYVK_TINYVGRAPHICSPIPELINE
 	#include "./TinyVulkan.hpp"
+	#include <unordered_map>
 
 	namespace TINYVULKAN_NAMESPACE {
 		#define VKCOMP_RGBA VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT
@@ -14,6 +15,13 @@
 			TINYVK_DESCRIPTOR_STORAGE_BUFFER = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER
 		};
 
+		/// @brief Push descriptor update template of a pipeline layout and the packed descriptor data it reads (see ABOUT PUSH DESCRIPTOR TEMPLATES).
+		struct TinyVkDescriptorTemplate {
+			VkDescriptorUpdateTemplate updateTemplate = VK_NULL_HANDLE;
+			size_t dataSize = 0; /// Byte size of the packed descriptor infos pushed with the template.
+			uint32_t entryCount = 0; /// Number of bindings written by the template.
+		};
+
 		/// @brief Represents the Vertex shader layout data passing through the graphics pipeline.
 		struct TinyVkVertexDescription {
 			const VkVertexInputBindingDescription binding;
@@ -22,16 +30,142 @@
 			TinyVkVertexDescription(VkVertexInputBindingDescription binding, const std::vector<VkVertexInputAttributeDescription> attributes) : binding(binding), attributes(attributes) {}
 		};
 
+		/*
+			ABOUT PIPELINE VARIANTS:
+				A TinyVkGraphicsPipeline owns one pipeline layout (push descriptor set layout + push constant ranges) and a cache
+				of VkPipeline variants keyed by TinyVkPipelineVariant: shaders, vertex layout, blend, depth and raster state and
+				attachment formats. Variants are created on demand (GetVariant / TinyVkGraphicsRenderer::CmdBindPipelineVariant),
+				deduplicated by their state, share the pipeline layout (push descriptors/constants stay valid across variants)
+				and are destroyed with the pipeline. Shader modules are loaded once per file and kept until the pipeline is disposed.
+				RequestVariant(variant, &compiler) compiles a variant on a TinyVkPipelineCompiler thread instead, concurrent
+				requests of the same state share one TinyVkPipelineHandle and GetVariant() waits on a pending compile.
+
+				Empty shaders/vertex attributes in a variant use the pipeline's own (variant attributes require variant bindings),
+				the constructor's state is GetBaseVariant(). Variants which enable depth testing must be rendered by a renderer with
+				a depth image (base pipeline created with enableDepthTesting, otherwise variants have no depth attachment format). Pipelines created with a TinyVkBindlessTable add its descriptor set as set 1 of the layout
+				(see ABOUT BINDLESS TEXTURES in TinyVk_BindlessTable.hpp).
+
+			ABOUT EXTENDED DYNAMIC STATE:
+				State the device can set per draw (TinyVkVulkanDevice::GetDynamicStateSupport(), extended dynamic state 1/2 core in
+				Vulkan 1.3 and the supported VK_EXT_extended_dynamic_state3 features) is created dynamic in every variant and
+				removed from the variant key (NormalizeVariant()), so variants which only differ in cull mode, front face, topology
+				(within its point/line/triangle/patch class), depth test/write/compare, primitive restart, polygon mode or blending
+				share one VkPipeline. CmdBindVariant() binds the variant's pipeline and records its dynamic state, anything that
+				binds a pipeline of this family directly must call CmdSetDynamicState() before drawing. On devices without
+				support (or with TINYVK_DISABLE_DYNAMIC_STATE) the same calls fall back to one pipeline variant per state.
+
+		ABOUT PUSH DESCRIPTOR TEMPLATES:
+			Pipelines (and compute renderers) with push descriptor bindings create one VkDescriptorUpdateTemplate for their
+			layout, PushDescriptorTemplate(cmd, data) then pushes every binding with one vkCmdPushDescriptorSetWithTemplateKHR
+			from packed descriptor infos instead of building VkWriteDescriptorSets per draw. The data holds each binding's infos
+			in binding number order, back to back: VkDescriptorImageInfo for samplers/images, VkDescriptorBufferInfo for
+			uniform/storage buffers, VkBufferView for texel buffers (all 8 byte aligned, so a plain struct of these members in
+			binding order matches), e.g. for binding 0 = uniform buffer, binding 1 = combined image sampler:
+				struct SpriteDescriptors { VkDescriptorBufferInfo camera; VkDescriptorImageInfo texture; };
+		*/
+
+		/// @brief Render state key of a graphics pipeline variant (hashable, compared by value).
+		struct TinyVkPipelineVariant {
+			std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders; /// Empty = the pipeline's shaders.
+			std::vector<VkVertexInputBindingDescription> vertexBindings; /// Empty = the pipeline's vertex description.
+			std::vector<VkVertexInputAttributeDescription> vertexAttributes;
+
+			VkPrimitiveTopology topology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+			VkPolygonMode polygonMode = VK_POLYGON_MODE_FILL;
+			VkCullModeFlags cullMode = VK_CULL_MODE_BACK_BIT;
+			VkFrontFace frontFace = VK_FRONT_FACE_CLOCKWISE;
+			VkPipelineColorBlendAttachmentState blendState = {
+				VK_TRUE, VK_BLEND_FACTOR_SRC_ALPHA, VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA, VK_BLEND_OP_ADD,
+				VK_BLEND_FACTOR_ONE, VK_BLEND_FACTOR_ONE_MINUS_SRC_ALPHA, VK_BLEND_OP_ADD,
+				VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT
+			};
+			VkBool32 primitiveRestart = VK_FALSE;
+			VkBool32 depthTest = VK_FALSE;
+			VkBool32 depthWrite = VK_FALSE;
+			VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS;
+			VkFormat colorFormat = VK_FORMAT_B8G8R8A8_UNORM;
+			VkFormat depthFormat = VK_FORMAT_UNDEFINED; /// UNDEFINED = TinyVkGraphicsPipeline::QueryDepthFormat().
+
+			/// @brief Combines a value into a hash (boost::hash_combine).
+			template<typename T>
+			inline static void HashCombine(size_t& hash, const T& value) { hash ^= std::hash<T>{}(value) + 0x9e3779b97f4a7c15ULL + (hash << 6) + (hash >> 2); }
+
+			size_t Hash() const {
+				size_t hash = 0;
+				for(const auto& shader : shaders) { HashCombine(hash, static_cast<uint32_t>(std::get<0>(shader))); HashCombine(hash, std::get<1>(shader)); }
+				for(const auto& binding : vertexBindings) { HashCombine(hash, binding.binding); HashCombine(hash, binding.stride); HashCombine(hash, static_cast<uint32_t>(binding.inputRate)); }
+				for(const auto& attribute : vertexAttributes) { HashCombine(hash, attribute.location); HashCombine(hash, attribute.binding); HashCombine(hash, static_cast<uint32_t>(attribute.format)); HashCombine(hash, attribute.offset); }
+				for(uint32_t value : { static_cast<uint32_t>(topology), static_cast<uint32_t>(polygonMode), static_cast<uint32_t>(cullMode), static_cast<uint32_t>(frontFace),
+					blendState.blendEnable, static_cast<uint32_t>(blendState.srcColorBlendFactor), static_cast<uint32_t>(blendState.dstColorBlendFactor), static_cast<uint32_t>(blendState.colorBlendOp),
+					static_cast<uint32_t>(blendState.srcAlphaBlendFactor), static_cast<uint32_t>(blendState.dstAlphaBlendFactor), static_cast<uint32_t>(blendState.alphaBlendOp), blendState.colorWriteMask,
+					primitiveRestart, depthTest, depthWrite, static_cast<uint32_t>(depthCompareOp), static_cast<uint32_t>(colorFormat), static_cast<uint32_t>(depthFormat) })
+					HashCombine(hash, value);
+				return hash;
+			}
+
+			bool operator==(const TinyVkPipelineVariant& other) const {
+				auto sameBinding = [](const VkVertexInputBindingDescription& a, const VkVertexInputBindingDescription& b) { return a.binding == b.binding && a.stride == b.stride && a.inputRate == b.inputRate; };
+				auto sameAttribute = [](const VkVertexInputAttributeDescription& a, const VkVertexInputAttributeDescription& b) { return a.location == b.location && a.binding == b.binding && a.format == b.format && a.offset == b.offset; };
+				auto sameBlend = [](const VkPipelineColorBlendAttachmentState& a, const VkPipelineColorBlendAttachmentState& b) {
+					return a.blendEnable == b.blendEnable && a.srcColorBlendFactor == b.srcColorBlendFactor && a.dstColorBlendFactor == b.dstColorBlendFactor && a.colorBlendOp == b.colorBlendOp
+						&& a.srcAlphaBlendFactor == b.srcAlphaBlendFactor && a.dstAlphaBlendFactor == b.dstAlphaBlendFactor && a.alphaBlendOp == b.alphaBlendOp && a.colorWriteMask == b.colorWriteMask;
+				};
+				return shaders == other.shaders
+					&& std::equal(vertexBindings.begin(), vertexBindings.end(), other.vertexBindings.begin(), other.vertexBindings.end(), sameBinding)
+					&& std::equal(vertexAttributes.begin(), vertexAttributes.end(), other.vertexAttributes.begin(), other.vertexAttributes.end(), sameAttribute)
+					&& topology == other.topology && primitiveRestart == other.primitiveRestart && polygonMode == other.polygonMode && cullMode == other.cullMode && frontFace == other.frontFace
+					&& sameBlend(blendState, other.blendState)
+					&& depthTest == other.depthTest && depthWrite == other.depthWrite && depthCompareOp == other.depthCompareOp
+					&& colorFormat == other.colorFormat && depthFormat == other.depthFormat;
+			}
+		};
+
+		/// @brief std::unordered_map hasher for TinyVkPipelineVariant.
+		struct TinyVkPipelineVariantHash {
+			size_t operator()(const TinyVkPipelineVariant& variant) const { return variant.Hash(); }
+		};
+
+		class TinyVkShaderWatcher;
+
+		class TinyVkGraphicsRenderer;
+
 		/// @brief Vulkan Graphics Pipeline using Dynamic Viewports/Scissors, Push Descriptors/Constants.
 		class TinyVkGraphicsPipeline : public TinyVkDisposable {
 		private:
-			VkDescriptorSetLayout descriptorLayout;
+			friend class TinyVkShaderWatcher;
+
+			VkDescriptorSetLayout descriptorLayout = VK_NULL_HANDLE;
 			std::vector<VkDescriptorSetLayoutBinding> descriptorBindings;
 			std::vector<VkPushConstantRange> pushConstantRanges;
 
-			VkPipelineDynamicStateCreateInfo dynamicState;
-			VkPipelineLayout pipelineLayout;
-			VkPipeline graphicsPipeline;
+			VkPipelineLayout pipelineLayout = VK_NULL_HANDLE;
+			TinyVkDescriptorTemplate descriptorTemplate {};
+			TinyVkBindlessTable* bindlessTable = nullptr;
+			std::atomic<VkPipeline> graphicsPipeline = VK_NULL_HANDLE; /// Swapped by ApplyShaderReloads() while other threads may read it.
+
+			std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders;
+			std::timed_mutex variant_lock;
+			std::unordered_map<TinyVkPipelineVariant, VkPipeline, TinyVkPipelineVariantHash> variants;
+			std::unordered_map<TinyVkPipelineVariant, TinyVkPipelineHandle, TinyVkPipelineVariantHash> pendingVariants;
+			std::unordered_map<TinyVkPipelineVariant, VkPipeline, TinyVkPipelineVariantHash> reloadedVariants; /// Rebuilt by shader reloads, swapped in by ApplyShaderReloads().
+			std::vector<TinyVkPipelineHandle> pendingReloads;
+			std::atomic<bool> reloadsStaged = false;
+			std::vector<TinyVkGraphicsRenderer*> recorders; /// Renderers recording with this pipeline (AddRecorder()), guarded by variant_lock.
+
+			/// Pipeline replaced by a shader reload, retired once every recorder registered at the swap passed a frame boundary.
+			struct TinyVkDeferredRetirement {
+				VkPipeline pipeline;
+				std::vector<TinyVkGraphicsRenderer*> recorders;
+			};
+			std::vector<TinyVkDeferredRetirement> deferredRetirements;
+			std::atomic<bool> retirementsDeferred = false;
+			std::atomic<uint32_t> reloadCount = 0;
+			std::function<void()> shaderWatcherDetach; /// Set by the TinyVkShaderWatcher watching this pipeline (guarded by detach_lock).
+			std::timed_mutex detach_lock;
+			std::atomic<uint32_t> variantNameIndex = 0;
+			std::string debugName;
+			TinyVkDynamicStateSupport dynamicStateSupport;
+			VkShaderStageFlags pushConstantStages = 0;
 			
 			VkFormat imageFormat;
 			VkColorComponentFlags colorComponentFlags = VK_COLOR_COMPONENT_R_BIT | VK_COLOR_COMPONENT_G_BIT | VK_COLOR_COMPONENT_B_BIT | VK_COLOR_COMPONENT_A_BIT;
@@ -46,21 +180,6 @@
 			VkQueue graphicsQueue;
 			VkQueue presentQueue;
 			
-			VkShaderModule CreateShaderModule(std::vector<char> shaderCode) {
-				VkShaderModuleCreateInfo createInfo{};
-				createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
-				createInfo.pNext = VK_NULL_HANDLE;
-				createInfo.flags = 0;
-				createInfo.codeSize = shaderCode.size();
-				createInfo.pCode = reinterpret_cast<const uint32_t*>(shaderCode.data());
-
-				VkShaderModule shaderModule;
-				if (vkCreateShaderModule(vkdevice.GetLogicalDevice(), &createInfo, VK_NULL_HANDLE, &shaderModule) != VK_SUCCESS)
-					throw TinyVkRuntimeError("TinyVulkan: Failed to create shader module!");
-
-				return shaderModule;
-			}
-
 			VkPipelineShaderStageCreateInfo CreateShaderInfo(const std::string& path, VkShaderModule shaderModule, VkShaderStageFlagBits stageFlagBits) {
 				VkPipelineShaderStageCreateInfo shaderStageInfo{};
 				shaderStageInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO;
@@ -75,35 +194,16 @@
 				return shaderStageInfo;
 			}
 
-			std::vector<char> ReadShaderFile(const std::string& path) {
-				std::ifstream file(path, std::ios::ate | std::ios::binary);
-
-				if (!file.is_open())
-					throw TinyVkRuntimeError("TinyVulkan: Failed to Read File: " + path);
-
-				size_t fsize = static_cast<size_t>(file.tellg());
-				std::vector<char> buffer(fsize);
-				file.seekg(0);
-				file.read(buffer.data(), fsize);
-				file.close();
-				return buffer;
+			/// @brief Points the device's shader cache at the SPIR-V file's current contents (throws if it uses bindings/push constants the pipeline layout does not declare).
+			void ReloadShaderModule(const std::string& path) {
+				std::vector<uint32_t> shaderCode = TinyVkShaderCache::ReadShaderFile(path);
+				if (!TinyVkShaderReflection::FromCode(shaderCode.data(), shaderCode.size()).IsLayoutCompatible(descriptorBindings, pushConstantRanges, bindlessTable != nullptr))
+					throw TinyVkRuntimeError("TinyVulkan: Reloaded shader " + path + " does not match the pipeline layout (restart to change descriptor/push constant layouts)!");
+				vkdevice.GetShaderCache().UpdateShaderModule(path, shaderCode.data(), shaderCode.size());
 			}
-			
-			void CreateGraphicsPipeline(const std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders) {
-				///////////////////////////////////////////////////////////////////////////////////////////////////////
-				/////////// This section specifies that TinyVkVertex provides the vertex layout description ///////////
-				const VkVertexInputBindingDescription bindingDescription = vertexDescription.binding;
-				const std::vector<VkVertexInputAttributeDescription>& attributeDescriptions = vertexDescription.attributes;
 
-				VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
-				vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
-				vertexInputInfo.vertexBindingDescriptionCount = 1;
-				vertexInputInfo.pVertexBindingDescriptions = &bindingDescription;
-				vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
-				vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
-				
-				///////////////////////////////////////////////////////////////////////////////////////////////////////
-				///////////////////////////////////////////////////////////////////////////////////////////////////////
+			/// @brief Creates the push descriptor set layout and pipeline layout shared by every variant (+ the bindless table's set 1).
+			void CreatePipelineLayout() {
 				VkPipelineLayoutCreateInfo pipelineLayoutInfo{};
 				pipelineLayoutInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_LAYOUT_CREATE_INFO;
 				
@@ -114,7 +214,7 @@
 					pipelineLayoutInfo.pPushConstantRanges = pushConstantRanges.data();
 				}
 
-				if (descriptorBindings.size() > 0) {
+				if (descriptorBindings.size() > 0 || bindlessTable != nullptr) {
 					VkDescriptorSetLayoutCreateInfo descriptorCreateInfo{};
 					descriptorCreateInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_SET_LAYOUT_CREATE_INFO;
 					descriptorCreateInfo.flags = VK_DESCRIPTOR_SET_LAYOUT_CREATE_PUSH_DESCRIPTOR_BIT_KHR;
@@ -128,15 +228,41 @@
 					pipelineLayoutInfo.pSetLayouts = &descriptorLayout;
 				}
 
+				std::array<VkDescriptorSetLayout, 2> setLayouts = { descriptorLayout, VK_NULL_HANDLE };
+				if (bindlessTable != nullptr) {
+					setLayouts[TinyVkBindlessTable::descriptorSetIndex] = bindlessTable->GetDescriptorLayout();
+					pipelineLayoutInfo.setLayoutCount = static_cast<uint32_t>(setLayouts.size());
+					pipelineLayoutInfo.pSetLayouts = setLayouts.data();
+				}
+
 				if (vkCreatePipelineLayout(vkdevice.GetLogicalDevice(), &pipelineLayoutInfo, VK_NULL_HANDLE, &pipelineLayout) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to create graphics pipeline layout!");
+
+				if (descriptorBindings.size() > 0)
+					descriptorTemplate = CreatePushDescriptorTemplate(vkdevice.GetLogicalDevice(), VK_PIPELINE_BIND_POINT_GRAPHICS, pipelineLayout, descriptorBindings);
+			}
+			
+			/// @brief Creates the VkPipeline of a variant with the shared pipeline layout (thread-safe, called without variant_lock held).
+			VkPipeline CreatePipelineVariant(const TinyVkPipelineVariant& variant) {
+				///////////////////////////////////////////////////////////////////////////////////////////////////////
+				/////////// This section specifies that TinyVkVertex provides the vertex layout description ///////////
+				const VkVertexInputBindingDescription bindingDescription = vertexDescription.binding;
+				const bool useVariantVertices = !variant.vertexAttributes.empty();
+				const std::vector<VkVertexInputAttributeDescription>& attributeDescriptions = (useVariantVertices)? variant.vertexAttributes : vertexDescription.attributes;
+
+				VkPipelineVertexInputStateCreateInfo vertexInputInfo{};
+				vertexInputInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_VERTEX_INPUT_STATE_CREATE_INFO;
+				vertexInputInfo.vertexBindingDescriptionCount = (useVariantVertices)? static_cast<uint32_t>(variant.vertexBindings.size()) : 1;
+				vertexInputInfo.pVertexBindingDescriptions = (useVariantVertices)? variant.vertexBindings.data() : &bindingDescription;
+				vertexInputInfo.vertexAttributeDescriptionCount = static_cast<uint32_t>(attributeDescriptions.size());
+				vertexInputInfo.pVertexAttributeDescriptions = attributeDescriptions.data();
 				
 				///////////////////////////////////////////////////////////////////////////////////////////////////////
 				///////////////////////////////////////////////////////////////////////////////////////////////////////
 				VkPipelineInputAssemblyStateCreateInfo inputAssembly{};
 				inputAssembly.sType = VK_STRUCTURE_TYPE_PIPELINE_INPUT_ASSEMBLY_STATE_CREATE_INFO;
-				inputAssembly.topology = vertexTopology;
-				inputAssembly.primitiveRestartEnable = VK_FALSE;
+				inputAssembly.topology = variant.topology;
+				inputAssembly.primitiveRestartEnable = variant.primitiveRestart;
 
 				VkPipelineViewportStateCreateInfo viewportState{};
 				viewportState.sType = VK_STRUCTURE_TYPE_PIPELINE_VIEWPORT_STATE_CREATE_INFO;
@@ -148,10 +274,10 @@
 				rasterizer.sType = VK_STRUCTURE_TYPE_PIPELINE_RASTERIZATION_STATE_CREATE_INFO;
 				rasterizer.depthClampEnable = VK_FALSE;
 				rasterizer.rasterizerDiscardEnable = VK_FALSE;
-				rasterizer.polygonMode = polgyonTopology;
+				rasterizer.polygonMode = variant.polygonMode;
 				rasterizer.lineWidth = 1.0f;
-				rasterizer.cullMode = VK_CULL_MODE_BACK_BIT;
-				rasterizer.frontFace = VK_FRONT_FACE_CLOCKWISE;
+				rasterizer.cullMode = variant.cullMode;
+				rasterizer.frontFace = variant.frontFace;
 				rasterizer.depthBiasEnable = VK_FALSE;
 
 				VkPipelineMultisampleStateCreateInfo multisampling{};
@@ -165,31 +291,43 @@
 				colorBlending.logicOp = VK_LOGIC_OP_COPY;
 				colorBlending.attachmentCount = 1;
 
-				VkPipelineColorBlendAttachmentState blendDescription = colorBlendState;
+				VkPipelineColorBlendAttachmentState blendDescription = variant.blendState;
 				colorBlending.pAttachments = &blendDescription;
 				colorBlending.blendConstants[0] = 0.0f;
 				colorBlending.blendConstants[1] = 0.0f;
 				colorBlending.blendConstants[2] = 0.0f;
 				colorBlending.blendConstants[3] = 0.0f;
 
-				const std::array<VkDynamicState, 2> dynamicStateEnables = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+				std::vector<VkDynamicState> dynamicStateEnables = { VK_DYNAMIC_STATE_VIEWPORT, VK_DYNAMIC_STATE_SCISSOR };
+				if (dynamicStateSupport.extendedDynamicState)
+					dynamicStateEnables.insert(dynamicStateEnables.end(), { VK_DYNAMIC_STATE_CULL_MODE, VK_DYNAMIC_STATE_FRONT_FACE, VK_DYNAMIC_STATE_PRIMITIVE_TOPOLOGY,
+						VK_DYNAMIC_STATE_DEPTH_TEST_ENABLE, VK_DYNAMIC_STATE_DEPTH_WRITE_ENABLE, VK_DYNAMIC_STATE_DEPTH_COMPARE_OP });
+				if (dynamicStateSupport.extendedDynamicState2) dynamicStateEnables.push_back(VK_DYNAMIC_STATE_PRIMITIVE_RESTART_ENABLE);
+				if (dynamicStateSupport.polygonMode) dynamicStateEnables.push_back(VK_DYNAMIC_STATE_POLYGON_MODE_EXT);
+				if (dynamicStateSupport.colorBlendEnable) dynamicStateEnables.push_back(VK_DYNAMIC_STATE_COLOR_BLEND_ENABLE_EXT);
+				if (dynamicStateSupport.colorBlendEquation) dynamicStateEnables.push_back(VK_DYNAMIC_STATE_COLOR_BLEND_EQUATION_EXT);
+				if (dynamicStateSupport.colorWriteMask) dynamicStateEnables.push_back(VK_DYNAMIC_STATE_COLOR_WRITE_MASK_EXT);
+
+				VkPipelineDynamicStateCreateInfo dynamicState{};
 				dynamicState.sType = VK_STRUCTURE_TYPE_PIPELINE_DYNAMIC_STATE_CREATE_INFO;
 				dynamicState.flags = 0;
 				dynamicState.pDynamicStates = dynamicStateEnables.data();
 				dynamicState.dynamicStateCount = static_cast<uint32_t>(dynamicStateEnables.size());
 				dynamicState.pNext = VK_NULL_HANDLE;
 
+				VkFormat colorFormat = variant.colorFormat;
 				VkPipelineRenderingCreateInfoKHR renderingCreateInfo{};
 				renderingCreateInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_RENDERING_CREATE_INFO_KHR;
 				renderingCreateInfo.colorAttachmentCount = 1;
-				renderingCreateInfo.pColorAttachmentFormats = &imageFormat;
-				renderingCreateInfo.depthAttachmentFormat = QueryDepthFormat();
+				renderingCreateInfo.pColorAttachmentFormats = &colorFormat;
+				// Renderers only attach a depth image when the pipeline was created with depth testing.
+				renderingCreateInfo.depthAttachmentFormat = (variant.depthFormat != VK_FORMAT_UNDEFINED)? variant.depthFormat : (enableDepthTesting)? QueryDepthFormat() : VK_FORMAT_UNDEFINED;
 
 				VkPipelineDepthStencilStateCreateInfo depthStencilInfo{};
 				depthStencilInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_DEPTH_STENCIL_STATE_CREATE_INFO;
-				depthStencilInfo.depthTestEnable = enableDepthTesting;
-				depthStencilInfo.depthWriteEnable = enableDepthTesting;
-				depthStencilInfo.depthCompareOp = VK_COMPARE_OP_LESS;
+				depthStencilInfo.depthTestEnable = variant.depthTest;
+				depthStencilInfo.depthWriteEnable = variant.depthWrite;
+				depthStencilInfo.depthCompareOp = variant.depthCompareOp;
 				depthStencilInfo.depthBoundsTestEnable = VK_FALSE;
 				depthStencilInfo.minDepthBounds = 0.0f; // Optional
 				depthStencilInfo.maxDepthBounds = 1.0f; // Optional
@@ -199,13 +337,11 @@
 
 				///////////////////////////////////////////////////////////////////////////////////////////////////////
 				///////////////////////////////////////////////////////////////////////////////////////////////////////
+				const std::vector<std::tuple<VkShaderStageFlagBits, std::string>>& variantShaders = (variant.shaders.empty())? shaders : variant.shaders;
 				std::vector<VkPipelineShaderStageCreateInfo> shaderPipelineCreateInfo;
-				std::vector<VkShaderModule> shaderModules;
-				for (size_t i = 0; i < shaders.size(); i++) {
-					auto shaderCode = ReadShaderFile(std::get<1>(shaders[i]));
-					auto shaderModule = CreateShaderModule(shaderCode);
-					shaderModules.push_back(shaderModule);
-					shaderPipelineCreateInfo.push_back(CreateShaderInfo(std::get<1>(shaders[i]), shaderModule, std::get<0>(shaders[i])));
+				for (size_t i = 0; i < variantShaders.size(); i++) {
+					const std::string& path = std::get<1>(variantShaders[i]);
+					shaderPipelineCreateInfo.push_back(CreateShaderInfo(path, vkdevice.GetShaderCache().GetShaderModule(path), std::get<0>(variantShaders[i])));
 				}
 				
 				VkGraphicsPipelineCreateInfo pipelineInfo{};
@@ -229,11 +365,19 @@
 				pipelineInfo.basePipelineHandle = VK_NULL_HANDLE; // Optional
 				pipelineInfo.basePipelineIndex = -1; // Optional
 
-				if (vkCreateGraphicsPipelines(vkdevice.GetLogicalDevice(), VK_NULL_HANDLE, 1, &pipelineInfo, VK_NULL_HANDLE, &graphicsPipeline) != VK_SUCCESS)
+				VkPipeline pipeline = VK_NULL_HANDLE;
+				if (vkCreateGraphicsPipelines(vkdevice.GetLogicalDevice(), vkdevice.GetPipelineCache(), 1, &pipelineInfo, VK_NULL_HANDLE, &pipeline) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to create graphics pipeline!");
-				
-				for(auto shaderModule : shaderModules)
-					vkDestroyShaderModule(vkdevice.GetLogicalDevice(), shaderModule, VK_NULL_HANDLE);
+
+				#if TVK_DEBUG_UTILS
+					if (!debugName.empty()) TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_PIPELINE, pipeline, debugName + "::Variant[" + std::to_string(variantNameIndex++) + "]");
+				#endif
+				return pipeline;
+			}
+
+			TinyVkGraphicsPipeline(TinyVkVulkanDevice& vkdevice, const TinyVkShaderReflection& reflection, const std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders, bool enableDepthTesting, VkFormat imageFormat, VkColorComponentFlags colorComponentFlags, VkPipelineColorBlendAttachmentState colorBlendState, VkPrimitiveTopology vertexTopology, VkPolygonMode polgyonTopology, TinyVkBindlessTable* bindlessTable)
+			: TinyVkGraphicsPipeline(vkdevice, TinyVkVertexDescription(reflection.GetVertexBinding(), reflection.vertexAttributes), shaders, reflection.GetPushDescriptorBindings(bindlessTable != nullptr), reflection.pushConstantRanges, enableDepthTesting, imageFormat, colorComponentFlags, colorBlendState, vertexTopology, polgyonTopology, bindlessTable) {
+				pushConstantStages = reflection.GetPushConstantStages();
 			}
 			
 		public:
@@ -244,19 +388,34 @@
 			~TinyVkGraphicsPipeline() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
+				std::function<void()> detach;
+				{
+					timed_guard<false> detachLock(detach_lock);
+					detach = shaderWatcherDetach;
+				}
+				if (detach) detach();
+				WaitPendingVariants();
+				WaitPendingReloads();
 				if (waitIdle) vkdevice.DeviceWaitIdle();
 
+				vkDestroyDescriptorUpdateTemplate(vkdevice.GetLogicalDevice(), descriptorTemplate.updateTemplate, VK_NULL_HANDLE);
 				vkDestroyDescriptorSetLayout(vkdevice.GetLogicalDevice(), descriptorLayout, VK_NULL_HANDLE);
-				vkDestroyPipeline(vkdevice.GetLogicalDevice(), graphicsPipeline, VK_NULL_HANDLE);
+				for(auto& variant : variants)
+					vkDestroyPipeline(vkdevice.GetLogicalDevice(), variant.second, VK_NULL_HANDLE);
+				for(auto& variant : reloadedVariants)
+					vkDestroyPipeline(vkdevice.GetLogicalDevice(), variant.second, VK_NULL_HANDLE);
+				for(auto& deferred : deferredRetirements)
+					vkDestroyPipeline(vkdevice.GetLogicalDevice(), deferred.pipeline, VK_NULL_HANDLE);
 				vkDestroyPipelineLayout(vkdevice.GetLogicalDevice(), pipelineLayout, VK_NULL_HANDLE);
 			}
 
-			TinyVkGraphicsPipeline(TinyVkVulkanDevice& vkdevice, TinyVkVertexDescription vertexDescription, const std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders, const std::vector<VkDescriptorSetLayoutBinding>& descriptorBindings, const std::vector<VkPushConstantRange>& pushConstantRanges, bool enableDepthTesting, VkFormat imageFormat = VK_FORMAT_B8G8R8A8_UNORM, VkColorComponentFlags colorComponentFlags = VKCOMP_RGBA, VkPipelineColorBlendAttachmentState colorBlendState = GetBlendDescription(true), VkPrimitiveTopology vertexTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VkPolygonMode polgyonTopology = VK_POLYGON_MODE_FILL)
-			: vkdevice(vkdevice), imageFormat(imageFormat), vertexDescription(vertexDescription), descriptorBindings(descriptorBindings), pushConstantRanges(pushConstantRanges), colorComponentFlags(colorComponentFlags), colorBlendState(colorBlendState), vertexTopology(vertexTopology), polgyonTopology(polgyonTopology) {
+			TinyVkGraphicsPipeline(TinyVkVulkanDevice& vkdevice, TinyVkVertexDescription vertexDescription, const std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders, const std::vector<VkDescriptorSetLayoutBinding>& descriptorBindings, const std::vector<VkPushConstantRange>& pushConstantRanges, bool enableDepthTesting, VkFormat imageFormat = VK_FORMAT_B8G8R8A8_UNORM, VkColorComponentFlags colorComponentFlags = VKCOMP_RGBA, VkPipelineColorBlendAttachmentState colorBlendState = GetBlendDescription(true), VkPrimitiveTopology vertexTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VkPolygonMode polgyonTopology = VK_POLYGON_MODE_FILL, TinyVkBindlessTable* bindlessTable = nullptr)
+			: vkdevice(vkdevice), imageFormat(imageFormat), vertexDescription(vertexDescription), shaders(shaders), descriptorBindings(descriptorBindings), pushConstantRanges(pushConstantRanges), colorComponentFlags(colorComponentFlags), colorBlendState(colorBlendState), vertexTopology(vertexTopology), polgyonTopology(polgyonTopology), bindlessTable(bindlessTable) {
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
 
 				this->enableBlending = colorBlendState.blendEnable;
 				this->enableDepthTesting = enableDepthTesting;
+				this->dynamicStateSupport = vkdevice.GetDynamicStateSupport();
 
 				TinyVkQueueFamily indices = vkdevice.FindQueueFamilies();
 				if (!indices.HasGraphicsFamily() && !indices.HasPresentFamily())
@@ -267,17 +426,338 @@
 				if (vkdevice.GetPresentSurface() != VK_NULL_HANDLE)
 					vkGetDeviceQueue(vkdevice.GetLogicalDevice(), indices.presentFamily, 0, &presentQueue);
 
-				CreateGraphicsPipeline(shaders);
+				for(const VkPushConstantRange& range : pushConstantRanges) pushConstantStages |= range.stageFlags;
+				CreatePipelineLayout();
+				graphicsPipeline = GetVariant(GetBaseVariant());
+				SetDebugName("TinyVkGraphicsPipeline");
+			}
+
+			/// @brief Creates a graphics pipeline from its shaders alone: vertex input (binding 0, tightly packed in location order), push descriptor bindings and push constant range are reflected from the SPIR-V (see ABOUT SHADER REFLECTION).
+			TinyVkGraphicsPipeline(TinyVkVulkanDevice& vkdevice, const std::vector<std::tuple<VkShaderStageFlagBits, std::string>> shaders, bool enableDepthTesting, VkFormat imageFormat = VK_FORMAT_B8G8R8A8_UNORM, VkColorComponentFlags colorComponentFlags = VKCOMP_RGBA, VkPipelineColorBlendAttachmentState colorBlendState = GetBlendDescription(true), VkPrimitiveTopology vertexTopology = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST, VkPolygonMode polgyonTopology = VK_POLYGON_MODE_FILL, TinyVkBindlessTable* bindlessTable = nullptr)
+			: TinyVkGraphicsPipeline(vkdevice, TinyVkShaderReflection::FromShaders(shaders), shaders, enableDepthTesting, imageFormat, colorComponentFlags, colorBlendState, vertexTopology, polgyonTopology, bindlessTable) {}
+
+			/// @brief Returns the variant key of the state this pipeline was constructed with (GetGraphicsPipeline()).
+			TinyVkPipelineVariant GetBaseVariant() {
+				TinyVkPipelineVariant variant;
+				variant.topology = vertexTopology;
+				variant.polygonMode = polgyonTopology;
+				variant.blendState = colorBlendState;
+				variant.blendState.colorWriteMask = colorComponentFlags;
+				variant.depthTest = enableDepthTesting;
+				variant.depthWrite = enableDepthTesting;
+				variant.colorFormat = imageFormat;
+				return variant;
+			}
+
+			/// @brief Returns the VkPipeline of a render state variant, created on first use and deduplicated by state (thread-safe, waits on a pending RequestVariant()).
+			VkPipeline GetVariant(const TinyVkPipelineVariant& variant) {
+				TinyVkPipelineHandle handle = RequestVariant(variant, nullptr);
+				VkPipeline pipeline = handle.Wait();
+				if (handle.IsFailed())
+					throw TinyVkRuntimeError(handle.GetError());
+				return pipeline;
+			}
+
+			/// @brief Returns a handle to a render state variant, compiled on a compiler thread if not yet created (compiled on the calling thread if compiler is nullptr).
+			TinyVkPipelineHandle RequestVariant(const TinyVkPipelineVariant& state, TinyVkPipelineCompiler* compiler) {
+				if (!state.vertexAttributes.empty() && state.vertexBindings.empty())
+					throw TinyVkRuntimeError("TinyVulkan: TinyVkPipelineVariant has vertexAttributes but no vertexBindings!");
+
+				const TinyVkPipelineVariant variant = NormalizeVariant(state);
+				TinyVkPipelineHandle handle;
+				{
+					timed_guard<false> variantLock(variant_lock);
+					auto cached = variants.find(variant);
+					if (cached != variants.end()) return TinyVkPipelineHandle::Ready(cached->second);
+
+					auto pending = pendingVariants.find(variant);
+					if (pending != pendingVariants.end()) return pending->second;
+
+					handle = TinyVkPipelineHandle::Pending();
+					pendingVariants.emplace(variant, handle);
+				}
+
+				auto compile = [this, variant, handle]() {
+					TINYVK_TRACE_SCOPE_CATEGORY("TinyVkGraphicsPipeline::CreatePipelineVariant", "tinyvk");
+					VkPipeline pipeline = VK_NULL_HANDLE;
+					std::string error;
+					try { pipeline = CreatePipelineVariant(variant); }
+					catch (const std::exception& exception) { error = exception.what(); }
+
+					{
+						timed_guard<false> variantLock(variant_lock);
+						if (pipeline != VK_NULL_HANDLE) variants.emplace(variant, pipeline);
+						pendingVariants.erase(variant);
+					}
+
+					// Completed last: a disposing pipeline waits on this handle and must not be touched afterwards.
+					if (pipeline != VK_NULL_HANDLE) { handle.Resolve(pipeline); } else handle.Fail(error);
+				};
+
+				if (compiler != nullptr) { compiler->Enqueue(compile); } else compile();
+				return handle;
+			}
+
+			/// @brief Returns the pipeline key of a render state: state which is dynamic on this device is reset to its default (variants differing only in dynamic state share one VkPipeline).
+			TinyVkPipelineVariant NormalizeVariant(const TinyVkPipelineVariant& state) {
+				const TinyVkPipelineVariant defaults;
+				TinyVkPipelineVariant variant = state;
+
+				if (dynamicStateSupport.extendedDynamicState) {
+					variant.cullMode = defaults.cullMode;
+					variant.frontFace = defaults.frontFace;
+					variant.topology = GetTopologyClass(state.topology);
+					variant.depthTest = defaults.depthTest;
+					variant.depthWrite = defaults.depthWrite;
+					variant.depthCompareOp = defaults.depthCompareOp;
+				}
+
+				if (dynamicStateSupport.extendedDynamicState2) variant.primitiveRestart = defaults.primitiveRestart;
+				if (dynamicStateSupport.polygonMode) variant.polygonMode = defaults.polygonMode;
+				if (dynamicStateSupport.colorBlendEnable) variant.blendState.blendEnable = defaults.blendState.blendEnable;
+				if (dynamicStateSupport.colorWriteMask) variant.blendState.colorWriteMask = defaults.blendState.colorWriteMask;
+				if (dynamicStateSupport.colorBlendEquation) {
+					variant.blendState.srcColorBlendFactor = defaults.blendState.srcColorBlendFactor;
+					variant.blendState.dstColorBlendFactor = defaults.blendState.dstColorBlendFactor;
+					variant.blendState.colorBlendOp = defaults.blendState.colorBlendOp;
+					variant.blendState.srcAlphaBlendFactor = defaults.blendState.srcAlphaBlendFactor;
+					variant.blendState.dstAlphaBlendFactor = defaults.blendState.dstAlphaBlendFactor;
+					variant.blendState.alphaBlendOp = defaults.blendState.alphaBlendOp;
+				}
+				return variant;
+			}
+
+			/// @brief Records the dynamic part of a render state (no-op for state baked into the pipeline variant), call after binding a pipeline of this family.
+			void CmdSetDynamicState(VkCommandBuffer cmdBuffer, const TinyVkPipelineVariant& state) {
+				if (dynamicStateSupport.extendedDynamicState) {
+					vkCmdSetCullMode(cmdBuffer, state.cullMode);
+					vkCmdSetFrontFace(cmdBuffer, state.frontFace);
+					vkCmdSetPrimitiveTopology(cmdBuffer, state.topology);
+					vkCmdSetDepthTestEnable(cmdBuffer, state.depthTest);
+					vkCmdSetDepthWriteEnable(cmdBuffer, state.depthWrite);
+					vkCmdSetDepthCompareOp(cmdBuffer, state.depthCompareOp);
+				}
+
+				if (dynamicStateSupport.extendedDynamicState2) vkCmdSetPrimitiveRestartEnable(cmdBuffer, state.primitiveRestart);
+				if (dynamicStateSupport.polygonMode) vkCmdSetPolygonModeEKHR(vkdevice.GetInstance(), cmdBuffer, state.polygonMode);
+				if (dynamicStateSupport.colorBlendEnable) vkCmdSetColorBlendEnableEKHR(vkdevice.GetInstance(), cmdBuffer, 0, 1, &state.blendState.blendEnable);
+				if (dynamicStateSupport.colorWriteMask) vkCmdSetColorWriteMaskEKHR(vkdevice.GetInstance(), cmdBuffer, 0, 1, &state.blendState.colorWriteMask);
+				if (dynamicStateSupport.colorBlendEquation) {
+					VkColorBlendEquationEXT blendEquation { state.blendState.srcColorBlendFactor, state.blendState.dstColorBlendFactor, state.blendState.colorBlendOp,
+						state.blendState.srcAlphaBlendFactor, state.blendState.dstAlphaBlendFactor, state.blendState.alphaBlendOp };
+					vkCmdSetColorBlendEquationEKHR(vkdevice.GetInstance(), cmdBuffer, 0, 1, &blendEquation);
+				}
+			}
+
+			/// @brief Binds the pipeline of a render state (created on first use) and records its dynamic state.
+			void CmdBindVariant(VkCommandBuffer cmdBuffer, const TinyVkPipelineVariant& state) {
+				vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, GetVariant(state));
+				CmdSetDynamicState(cmdBuffer, state);
+			}
+
+			/// @brief Returns the topology class a dynamic primitive topology may change within (the topology the pipeline is created with).
+			inline static VkPrimitiveTopology GetTopologyClass(VkPrimitiveTopology topology) {
+				switch(topology) {
+					case VK_PRIMITIVE_TOPOLOGY_LINE_LIST:
+					case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP:
+						return VK_PRIMITIVE_TOPOLOGY_LINE_LIST;
+					case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST:
+					case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP:
+					case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN:
+						return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST;
+					case VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY:
+					case VK_PRIMITIVE_TOPOLOGY_LINE_STRIP_WITH_ADJACENCY:
+						return VK_PRIMITIVE_TOPOLOGY_LINE_LIST_WITH_ADJACENCY;
+					case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_WITH_ADJACENCY:
+					case VK_PRIMITIVE_TOPOLOGY_TRIANGLE_STRIP_WITH_ADJACENCY:
+						return VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST_WITH_ADJACENCY;
+					default:
+						return topology;
+				}
+			}
+
+			/// @brief Blocks until every variant requested from a TinyVkPipelineCompiler has finished compiling.
+			void WaitPendingVariants() {
+				std::vector<TinyVkPipelineHandle> pending;
+				{
+					timed_guard<false> variantLock(variant_lock);
+					for(auto& variant : pendingVariants) pending.push_back(variant.second);
+				}
+				for(TinyVkPipelineHandle& handle : pending) handle.Wait();
+			}
+
+			#pragma region SHADER_HOT_RELOAD
+
+			/// @brief Returns every SPIR-V file used by this pipeline and its (created or pending) variants.
+			std::vector<std::string> GetShaderPaths() {
+				std::vector<std::string> paths;
+				auto addPaths = [&paths](const std::vector<std::tuple<VkShaderStageFlagBits, std::string>>& variantShaders) {
+					for(const auto& shader : variantShaders)
+						if (std::find(paths.begin(), paths.end(), std::get<1>(shader)) == paths.end()) paths.push_back(std::get<1>(shader));
+				};
+
+				timed_guard<false> variantLock(variant_lock);
+				addPaths(shaders);
+				for(auto& variant : variants) addPaths(variant.first.shaders);
+				for(auto& variant : pendingVariants) addPaths(variant.first.shaders);
+				return paths;
+			}
+
+			/// @brief Rebuilds every variant using one of the changed SPIR-V files on a compiler thread (the calling thread if compiler is nullptr), swapped in by the next ApplyShaderReloads(). Returns false if no variant uses them.
+			bool ReloadShaders(const std::vector<std::string>& changedPaths, TinyVkPipelineCompiler* compiler) {
+				std::vector<std::string> reloadPaths;
+				std::vector<TinyVkPipelineVariant> reloadVariants;
+				TinyVkPipelineHandle handle = TinyVkPipelineHandle::Pending();
+				{
+					timed_guard<false> variantLock(variant_lock);
+					for(auto& variant : variants) {
+						bool affected = false;
+						for(const auto& shader : (variant.first.shaders.empty())? shaders : variant.first.shaders) {
+							const std::string& path = std::get<1>(shader);
+							if (std::find(changedPaths.begin(), changedPaths.end(), path) == changedPaths.end()) continue;
+							if (std::find(reloadPaths.begin(), reloadPaths.end(), path) == reloadPaths.end()) reloadPaths.push_back(path);
+							affected = true;
+						}
+						if (affected) reloadVariants.push_back(variant.first);
+					}
+
+					if (reloadVariants.empty()) return false;
+					std::erase_if(pendingReloads, [](TinyVkPipelineHandle& reload) { return !reload.IsPending(); });
+					pendingReloads.push_back(handle);
+				}
+
+				auto reload = [this, reloadPaths, reloadVariants, handle]() {
+					TINYVK_TRACE_SCOPE_CATEGORY("TinyVkGraphicsPipeline::ReloadShaders", "tinyvk");
+					std::vector<std::pair<TinyVkPipelineVariant, VkPipeline>> rebuilt;
+					std::string error;
+					try {
+						for(const std::string& path : reloadPaths) ReloadShaderModule(path);
+						for(const TinyVkPipelineVariant& variant : reloadVariants) rebuilt.push_back({ variant, CreatePipelineVariant(variant) });
+					} catch (const std::exception& exception) {
+						error = exception.what();
+						for(auto& pipeline : rebuilt) vkDestroyPipeline(vkdevice.GetLogicalDevice(), pipeline.second, VK_NULL_HANDLE);
+						rebuilt.clear();
+					}
+
+					if (error.empty()) {
+						timed_guard<false> variantLock(variant_lock);
+						for(auto& pipeline : rebuilt) {
+							auto staged = reloadedVariants.find(pipeline.first);
+							if (staged != reloadedVariants.end()) {
+								vkDestroyPipeline(vkdevice.GetLogicalDevice(), staged->second, VK_NULL_HANDLE);
+								staged->second = pipeline.second;
+							} else reloadedVariants.emplace(pipeline.first, pipeline.second);
+						}
+						reloadsStaged.store(true, std::memory_order_release);
+					} else TinyVkDebugUtils::SubmitMessage(vkdevice.GetInstance(), "TinyVulkan: Shader reload failed, keeping the previous pipeline: " + error);
+
+					// Completed last: a disposing pipeline waits on this handle and must not be touched afterwards.
+					if (error.empty()) { handle.Resolve(VK_NULL_HANDLE); } else handle.Fail(error);
+				};
+
+				if (compiler != nullptr) { compiler->Enqueue(reload); } else reload();
+				return true;
+			}
+
+			/// @brief Releases the recorder's hold on replaced pipelines, those no recorder holds anymore are retired once the graphics queue's submissions so far complete (variant_lock must be held).
+			void ReleaseRetirementsNoLock(TinyVkGraphicsRenderer* recorder) {
+				VkDevice device = vkdevice.GetLogicalDevice();
+				TinyVkTimelinePoint lastUse = vkdevice.GetGraphicsTimeline().GetSubmittedPoint();
+				std::erase_if(deferredRetirements, [this, recorder, device, &lastUse](TinyVkDeferredRetirement& deferred) {
+					std::erase(deferred.recorders, recorder);
+					if (!deferred.recorders.empty()) return false;
+
+					VkPipeline retired = deferred.pipeline;
+					vkdevice.RetireResource(lastUse, [device, retired]() { vkDestroyPipeline(device, retired, VK_NULL_HANDLE); });
+					return true;
+				});
+				retirementsDeferred.store(!deferredRetirements.empty(), std::memory_order_release);
+			}
+
+			/// @brief Registers a renderer recording with this pipeline (TinyVkGraphicsRenderer does so on construction), pipelines replaced by a
+			/// shader reload are only retired after every registered renderer called ApplyShaderReloads() at its next frame boundary.
+			void AddRecorder(TinyVkGraphicsRenderer* recorder) {
+				timed_guard<false> variantLock(variant_lock);
+				recorders.push_back(recorder);
+			}
+
+			/// @brief Unregisters a renderer, releasing its hold on replaced pipelines.
+			void RemoveRecorder(TinyVkGraphicsRenderer* recorder) {
+				timed_guard<false> variantLock(variant_lock);
+				std::erase(recorders, recorder);
+				ReleaseRetirementsNoLock(recorder);
+			}
+
+			/// @brief Swaps in the variants rebuilt by shader reloads (call at a frame boundary, the renderers call this before recording with themselves
+			/// as recorder). A replaced pipeline is retired once the other registered recorders passed their next frame boundary (their recordings with it
+			/// are submitted by then) and the graphics queue's submissions up to that point complete.
+			bool ApplyShaderReloads(TinyVkGraphicsRenderer* recorder = nullptr) {
+				if (!reloadsStaged.load(std::memory_order_acquire) && !retirementsDeferred.load(std::memory_order_acquire)) return false;
+
+				timed_guard<false> variantLock(variant_lock);
+				bool applied = reloadsStaged.load(std::memory_order_acquire);
+				for(auto& reloaded : reloadedVariants) {
+					VkPipeline& current = variants[reloaded.first];
+					VkPipeline retired = current;
+					current = reloaded.second;
+					if (graphicsPipeline.load() == retired) graphicsPipeline.store(current);
+					if (retired != VK_NULL_HANDLE) deferredRetirements.push_back({ retired, recorders });
+				}
+
+				ReleaseRetirementsNoLock(recorder);
+				if (!applied) return false;
+
+				reloadedVariants.clear();
+				reloadsStaged.store(false, std::memory_order_release);
+				reloadCount ++;
+				return true;
+			}
+
+			/// @brief Blocks until every shader reload queued on a TinyVkPipelineCompiler has finished rebuilding (not yet applied).
+			void WaitPendingReloads() {
+				std::vector<TinyVkPipelineHandle> pending;
+				{
+					timed_guard<false> variantLock(variant_lock);
+					pending = pendingReloads;
+				}
+				for(TinyVkPipelineHandle& handle : pending) handle.Wait();
+			}
+
+			/// @brief Returns the number of shader reloads applied to this pipeline.
+			uint32_t GetReloadCount() { return reloadCount; }
+
+			#pragma endregion
+
+			/// @brief Returns the number of pipeline variants created (including the base pipeline, excluding pending compiles).
+			size_t GetVariantCount() {
+				timed_guard<false> variantLock(variant_lock);
+				return variants.size();
+			}
+
+			/// @brief Names the graphics pipeline, its layout and descriptor set layout (VK_EXT_debug_utils, compiled out in release).
+			void SetDebugName(const std::string& name) {
+				#if TVK_DEBUG_UTILS
+					debugName = name;
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_PIPELINE, graphicsPipeline.load(), name);
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_PIPELINE_LAYOUT, pipelineLayout, name + "::PipelineLayout");
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_DESCRIPTOR_SET_LAYOUT, descriptorLayout, name + "::DescriptorSetLayout");
+					TinyVkDebugUtils::SetObjectName(vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_DESCRIPTOR_UPDATE_TEMPLATE, descriptorTemplate.updateTemplate, name + "::DescriptorUpdateTemplate");
+				#endif
 			}
 
 			#pragma region REFERENCE_GETTERS
 
 			VkPipelineLayout GetPipelineLayout() { return pipelineLayout; }
-			VkPipeline GetGraphicsPipeline() { return graphicsPipeline; }
+			VkPipeline GetGraphicsPipeline() { return graphicsPipeline.load(); }
 			VkQueue GetGraphicsQueue() { return graphicsQueue; }
 			VkQueue GetPresentQueue() { return presentQueue; }
 			bool BlendingIsEnabled() { return enableBlending; }
 			bool DepthTestingIsEnabled() { return enableDepthTesting; }
+			TinyVkDynamicStateSupport GetDynamicStateSupport() { return dynamicStateSupport; }
+			VkShaderStageFlags GetPushConstantStages() { return pushConstantStages; }
+			const std::vector<VkPushConstantRange>& GetPushConstantRanges() { return pushConstantRanges; }
+			TinyVkBindlessTable* GetBindlessTable() { return bindlessTable; }
+			TinyVkDescriptorTemplate GetDescriptorTemplate() { return descriptorTemplate; }
 
 			#pragma endregion
 			#pragma region DEPTH_FORMATS
@@ -364,14 +844,14 @@
 				return writeDescriptorSets;
 			}
 
-			/// @brief Creates a write buffer descriptor (any of VK_DESCRIPTOR_TYPE_*_BUFFER) for passing buffers to the GPU (on myrenderer.PushDescriptorSet).
-			inline static VkWriteDescriptorSet SelectWriteBufferDescriptor(uint32_t binding, uint32_t descriptorCount, const VkDescriptorBufferInfo* bufferInfo) {
+			/// @brief Creates a write buffer descriptor (any of VK_DESCRIPTOR_TYPE_*_BUFFER, e.g. TinyVkBuffer::GetDescriptorType()) for passing buffers to the GPU (on myrenderer.PushDescriptorSet).
+			inline static VkWriteDescriptorSet SelectWriteBufferDescriptor(uint32_t binding, uint32_t descriptorCount, const VkDescriptorBufferInfo* bufferInfo, VkDescriptorType descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER) {
 				VkWriteDescriptorSet writeDescriptorSets{};
 				writeDescriptorSets.sType = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET;
 				writeDescriptorSets.dstSet = 0;
 				writeDescriptorSets.dstBinding = binding;
 				writeDescriptorSets.descriptorCount = descriptorCount;
-				writeDescriptorSets.descriptorType = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+				writeDescriptorSets.descriptorType = descriptorType;
 				writeDescriptorSets.pBufferInfo = bufferInfo;
 				return writeDescriptorSets;
 			}
@@ -400,6 +880,49 @@
 				return writeDescriptorSets;
 			}
 
+			/// @brief Returns the byte size of one descriptor's info in packed push descriptor template data.
+			inline static size_t GetDescriptorInfoSize(VkDescriptorType descriptorType) {
+				switch(descriptorType) {
+					case VK_DESCRIPTOR_TYPE_SAMPLER: case VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER: case VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE:
+					case VK_DESCRIPTOR_TYPE_STORAGE_IMAGE: case VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT:
+						return sizeof(VkDescriptorImageInfo);
+					case VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER: case VK_DESCRIPTOR_TYPE_STORAGE_BUFFER:
+						return sizeof(VkDescriptorBufferInfo);
+					case VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER: case VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER:
+						return sizeof(VkBufferView);
+					default:
+						throw TinyVkRuntimeError("TinyVulkan: Descriptor type " + std::to_string(descriptorType) + " can not be pushed with a descriptor update template!");
+				}
+			}
+
+			/// @brief Creates the push descriptor update template of set 0 of a pipeline layout (see ABOUT PUSH DESCRIPTOR TEMPLATES).
+			inline static TinyVkDescriptorTemplate CreatePushDescriptorTemplate(VkDevice logicalDevice, VkPipelineBindPoint bindPoint, VkPipelineLayout pipelineLayout, const std::vector<VkDescriptorSetLayoutBinding>& descriptorBindings) {
+				std::vector<VkDescriptorSetLayoutBinding> sortedBindings = descriptorBindings;
+				std::sort(sortedBindings.begin(), sortedBindings.end(), [](const VkDescriptorSetLayoutBinding& a, const VkDescriptorSetLayoutBinding& b) { return a.binding < b.binding; });
+
+				TinyVkDescriptorTemplate descriptorTemplate;
+				std::vector<VkDescriptorUpdateTemplateEntry> templateEntries;
+				for(const VkDescriptorSetLayoutBinding& binding : sortedBindings) {
+					size_t infoSize = GetDescriptorInfoSize(binding.descriptorType);
+					templateEntries.push_back({ binding.binding, 0, binding.descriptorCount, binding.descriptorType, descriptorTemplate.dataSize, infoSize });
+					descriptorTemplate.dataSize += infoSize * binding.descriptorCount;
+				}
+				descriptorTemplate.entryCount = static_cast<uint32_t>(templateEntries.size());
+
+				VkDescriptorUpdateTemplateCreateInfo createInfo{};
+				createInfo.sType = VK_STRUCTURE_TYPE_DESCRIPTOR_UPDATE_TEMPLATE_CREATE_INFO;
+				createInfo.descriptorUpdateEntryCount = descriptorTemplate.entryCount;
+				createInfo.pDescriptorUpdateEntries = templateEntries.data();
+				createInfo.templateType = VK_DESCRIPTOR_UPDATE_TEMPLATE_TYPE_PUSH_DESCRIPTORS_KHR;
+				createInfo.pipelineBindPoint = bindPoint;
+				createInfo.pipelineLayout = pipelineLayout;
+				createInfo.set = 0;
+
+				if (vkCreateDescriptorUpdateTemplate(logicalDevice, &createInfo, VK_NULL_HANDLE, &descriptorTemplate.updateTemplate) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to create push descriptor update template!");
+				return descriptorTemplate;
+			}
+
 			#pragma endregion
 		};
 	}
@@ -32,6 +32,51 @@
 			TinyVkImage* optionalDepthImage;
 			TinyVkImage* renderTarget;
 			TinyVkCommandPool* commandPool;
+			std::vector<TinyVkImage*> submitImages;
+			std::vector<TinyVkBuffer*> submitBuffers;
+
+			/// @brief Submits the recorded command buffers to the graphics queue timeline and returns the timeline point of the submission.
+			virtual TinyVkTimelinePoint SubmitRenderCommands(const std::vector<VkCommandBuffer>& commandBuffers) {
+				return renderContext.vkdevice.GetGraphicsTimeline().Submit(commandBuffers);
+			}
+
+			/// @brief Invokes the registered onRenderEvents on the current command pool and returns the recorded (leased) command buffers.
+			/// Command buffers of earlier frames are reused by LeaseBuffer() once their submission completes (no CPU wait on the previous frame).
+			std::vector<VkCommandBuffer> RecordRenderCommands() {
+				if (renderContext.graphicsPipeline.DepthTestingIsEnabled()) {
+                    if (optionalDepthImage == VK_NULL_HANDLE)
+                        throw TinyVkRuntimeError("TinyVulkan: Trying to render with TinyVkGraphicsRenderer without depth image [VK_NULL_HANDLE]! on depth testing enabled graphics pipeline!");
+                    
+                    if (optionalDepthImage->width != renderTarget->width || optionalDepthImage->height != renderTarget->height) {
+						optionalDepthImage->Disposable(false);
+						optionalDepthImage->ReCreateImage(optionalDepthImage->imageType, renderTarget->width, renderTarget->height, renderContext.graphicsPipeline.QueryDepthFormat(), VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
+					}
+				}
+				
+				{
+					TINYVK_TRACE_SCOPE_CATEGORY("TinyVkGraphicsRenderer::onRenderEvents", "tinyvk");
+					onRenderEvents.invoke(*commandPool);
+				}
+				return commandPool->GetRecordingBuffers();
+			}
+
+			/// @brief Records the submission's timeline point as the last use of every resource used by the recorded render commands.
+			void TrackRenderSubmission(TinyVkTimelinePoint submission) {
+				commandPool->RetireRecordingBuffers(submission);
+				renderTarget->lastUse = submission;
+				if (optionalDepthImage != VK_NULL_HANDLE) optionalDepthImage->lastUse = submission;
+				for(TinyVkImage* image : submitImages) image->lastUse = submission;
+				for(TinyVkBuffer* buffer : submitBuffers) buffer->lastUse = submission;
+				submitImages.clear();
+				submitBuffers.clear();
+			}
+
+			/// @brief Discards the resources tracked by recorded render commands that will never be submitted.
+			void DiscardRenderCommands() {
+				submitImages.clear();
+				submitBuffers.clear();
+				commandPool->ReturnAllBuffers();
+			}
 
 		public:
 			TinyVkRenderContext& renderContext;
@@ -39,6 +84,12 @@
             /// Invokable Render Events: (executed in TinyVkGraphicsRenderer::RenderExecute()
 			TinyVkInvokable<TinyVkCommandPool&> onRenderEvents;
 
+			/// GPU profiler/pipeline statistics scope name of command buffers recorded with Begin/EndRecordCmdBuffer (see TinyVkRenderContext.gpuProfiler/pipelineQueries).
+			std::string gpuScopeName = "TinyVkGraphicsRenderer";
+
+			/// Per-frame counters of this renderer (active while RenderExecute runs, one frame per RenderExecute).
+			TinyVkRenderStats renderStats { "TinyVkGraphicsRenderer" };
+
 			/// @brief Deletes the copy-constructor (dynamic resources cannot be copied).
 			TinyVkGraphicsRenderer operator=(const TinyVkGraphicsRenderer& renderer) = delete;
             
@@ -47,16 +98,18 @@
             : renderContext(renderContext), commandPool(cmdPool), renderTarget(renderTarget), optionalDepthImage(optionalDepthImage) {
                 if (renderContext.graphicsPipeline.DepthTestingIsEnabled() && optionalDepthImage == VK_NULL_HANDLE)
                     throw TinyVkRuntimeError("TinyVulkan: Trying to create TinyVkGraphicsRenderer without depth image [VK_NULL_HANDLE]! on depth testing enabled graphics pipeline!");
+				renderContext.graphicsPipeline.AddRecorder(this);
             }
 
+			/// @brief Unregisters the renderer from its graphics pipeline (dispose renderers before their pipeline).
+			virtual ~TinyVkGraphicsRenderer() { renderContext.graphicsPipeline.RemoveRecorder(this); }
+
 			#pragma region RENDER_TARGETING
 			
 			/// @brief Sets the target image/texture for the TinyVkImageRenderer.
 			void SetRenderTarget(TinyVkCommandPool* cmdPool, TinyVkImage* renderTarget, TinyVkImage* optionalDepthImage = VK_NULL_HANDLE, bool waitOldTarget = true) {
-				if (this->renderTarget != VK_NULL_HANDLE && waitOldTarget) {
-					vkWaitForFences(renderContext.vkdevice.GetLogicalDevice(), 1, &renderTarget->imageWaitable, VK_TRUE, UINT64_MAX);
-					vkResetFences(renderContext.vkdevice.GetLogicalDevice(), 1, &renderTarget->imageWaitable);
-				}
+				if (this->renderTarget != VK_NULL_HANDLE && waitOldTarget && this->renderTarget->lastUse.Wait(UINT64_MAX, "TinyVkGraphicsRenderer::SetRenderTarget") != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Timed out waiting on the previous render target of TinyVkGraphicsRenderer!");
 
                 if (renderContext.graphicsPipeline.DepthTestingIsEnabled() && optionalDepthImage == VK_NULL_HANDLE)
                     throw TinyVkRuntimeError("TinyVulkan: Trying to reset render target on TinyVkGraphicsRenderer without depth image on depth testing enabled graphics pipeline!");
@@ -70,15 +123,143 @@
 			#pragma region PIPELINE_DESCRIPTORS
 			
 			/// @brief Records Push Constants to the command buffer.
-			void PushConstants(VkCommandBuffer cmdBuffer, VkShaderStageFlagBits shaderFlags, uint32_t byteSize, const void* pValues) {
-				vkCmdPushConstants(cmdBuffer, renderContext.graphicsPipeline.GetPipelineLayout(), VK_SHADER_STAGE_VERTEX_BIT, 0, byteSize, pValues);
+			void PushConstants(VkCommandBuffer cmdBuffer, VkShaderStageFlags shaderFlags, uint32_t byteSize, const void* pValues, uint32_t offset = 0) {
+				vkCmdPushConstants(cmdBuffer, renderContext.graphicsPipeline.GetPipelineLayout(), shaderFlags, offset, byteSize, pValues);
+			}
+
+			/// @brief Records Push Constants to the command buffer for every stage of the pipeline's push constant ranges.
+			void PushConstants(VkCommandBuffer cmdBuffer, uint32_t byteSize, const void* pValues, uint32_t offset = 0) {
+				PushConstants(cmdBuffer, renderContext.graphicsPipeline.GetPushConstantStages(), byteSize, pValues, offset);
+			}
+
+			/// @brief Records a typed push constant block (TinyVkPushBlock) to the command buffer, its stages, offset and size come from the block type.
+			template<typename Block>
+			void PushConstants(VkCommandBuffer cmdBuffer, const typename Block::BlockType& value) {
+				#if TVK_VALIDATION_LAYERS
+					if (!Block::IsDeclaredIn(renderContext.graphicsPipeline.GetPushConstantRanges()))
+						throw TinyVkRuntimeError("TinyVulkan: Push constant block is not declared by the graphics pipeline's push constant ranges!");
+				#endif
+				Block::CmdPush(cmdBuffer, renderContext.graphicsPipeline.GetPipelineLayout(), value);
 			}
 
 			/// @brief Records Push Descriptors to the command buffer.
-			VkResult PushDescriptorSet(VkCommandBuffer cmdBuffer, std::vector<VkWriteDescriptorSet> writeDescriptorSets) {
+			VkResult PushDescriptorSet(VkCommandBuffer cmdBuffer, const std::vector<VkWriteDescriptorSet>& writeDescriptorSets) {
 				return vkCmdPushDescriptorSetEKHR(renderContext.vkdevice.GetInstance(), cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, renderContext.graphicsPipeline.GetPipelineLayout(),
 					0, static_cast<uint32_t>(writeDescriptorSets.size()), writeDescriptorSets.data());
 			}
+
+			/// @brief Records Push Descriptors to the command buffer from packed descriptor infos through the pipeline's descriptor update template (see ABOUT PUSH DESCRIPTOR TEMPLATES).
+			VkResult PushDescriptorTemplate(VkCommandBuffer cmdBuffer, const void* pData) {
+				TinyVkDescriptorTemplate descriptorTemplate = renderContext.graphicsPipeline.GetDescriptorTemplate();
+				return vkCmdPushDescriptorSetWithTemplateEKHR(renderContext.vkdevice.GetInstance(), cmdBuffer, descriptorTemplate.updateTemplate, renderContext.graphicsPipeline.GetPipelineLayout(),
+					0, pData, descriptorTemplate.entryCount);
+			}
+
+			/// @brief Records Push Descriptors to the command buffer from a struct of descriptor infos in binding order (see ABOUT PUSH DESCRIPTOR TEMPLATES).
+			template<typename T>
+			VkResult PushDescriptorTemplate(VkCommandBuffer cmdBuffer, const T& descriptors) {
+				static_assert(std::is_trivially_copyable_v<T> && !std::is_pointer_v<T>, "TinyVulkan: Push descriptor template data must be a plain struct of descriptor infos!");
+				#if TVK_VALIDATION_LAYERS
+					if (sizeof(T) != renderContext.graphicsPipeline.GetDescriptorTemplate().dataSize)
+						throw TinyVkRuntimeError("TinyVulkan: Push descriptor template data size does not match the pipeline's descriptor bindings!");
+				#endif
+				return PushDescriptorTemplate(cmdBuffer, static_cast<const void*>(&descriptors));
+			}
+
+			/// @brief Binds a render state variant of the render context's graphics pipeline (created on first use) and records its dynamic state, push descriptors/constants stay bound.
+			void CmdBindPipelineVariant(VkCommandBuffer cmdBuffer, const TinyVkPipelineVariant& variant) {
+				renderContext.graphicsPipeline.CmdBindVariant(cmdBuffer, variant);
+			}
+
+			/// @brief Binds a background compiled pipeline if ready, otherwise binds the fallback pipeline (if any). Returns false if the handle is not ready (skip draws when no fallback was given).
+			bool CmdBindPipelineHandle(VkCommandBuffer cmdBuffer, const TinyVkPipelineHandle& handle, VkPipeline fallback = VK_NULL_HANDLE) {
+				VkPipeline pipeline = handle.Get();
+				if (pipeline != VK_NULL_HANDLE) {
+					vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, pipeline);
+					return true;
+				}
+
+				if (fallback != VK_NULL_HANDLE) vkCmdBindPipeline(cmdBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, fallback);
+				return false;
+			}
+
+			/// @brief Binds a render state variant without blocking: queues its compile on the compiler on first use and binds the fallback pipeline (if any) until ready. Returns false while not ready.
+			bool CmdBindPipelineVariantAsync(VkCommandBuffer cmdBuffer, const TinyVkPipelineVariant& variant, TinyVkPipelineCompiler& compiler, VkPipeline fallback = VK_NULL_HANDLE) {
+				bool ready = CmdBindPipelineHandle(cmdBuffer, renderContext.graphicsPipeline.RequestVariant(variant, &compiler), fallback);
+				if (ready || fallback != VK_NULL_HANDLE) renderContext.graphicsPipeline.CmdSetDynamicState(cmdBuffer, variant);
+				return ready;
+			}
+            
+            #pragma endregion
+			#pragma region DYNAMIC_RENDER_STATE
+
+			/*
+				Per draw render state: pass the render state last bound (e.g. pipeline.GetBaseVariant() after BeginRecordCmdBuffer()),
+				each setter updates it and records the change as extended dynamic state if the device supports it, otherwise it
+				binds the pipeline variant of the updated state (see ABOUT EXTENDED DYNAMIC STATE in TinyVk_GraphicsPipeline.hpp).
+			*/
+
+			/// @brief Sets the cull mode of the following draws.
+			void CmdSetCullMode(VkCommandBuffer cmdBuffer, TinyVkPipelineVariant& state, VkCullModeFlags cullMode) {
+				state.cullMode = cullMode;
+				if (renderContext.graphicsPipeline.GetDynamicStateSupport().extendedDynamicState) {
+					vkCmdSetCullMode(cmdBuffer, cullMode);
+				} else CmdBindPipelineVariant(cmdBuffer, state);
+			}
+
+			/// @brief Sets the front face winding of the following draws.
+			void CmdSetFrontFace(VkCommandBuffer cmdBuffer, TinyVkPipelineVariant& state, VkFrontFace frontFace) {
+				state.frontFace = frontFace;
+				if (renderContext.graphicsPipeline.GetDynamicStateSupport().extendedDynamicState) {
+					vkCmdSetFrontFace(cmdBuffer, frontFace);
+				} else CmdBindPipelineVariant(cmdBuffer, state);
+			}
+
+			/// @brief Sets the primitive topology of the following draws (changing topology class, e.g. lines to triangles, binds another variant).
+			void CmdSetPrimitiveTopology(VkCommandBuffer cmdBuffer, TinyVkPipelineVariant& state, VkPrimitiveTopology topology) {
+				bool sameClass = TinyVkGraphicsPipeline::GetTopologyClass(state.topology) == TinyVkGraphicsPipeline::GetTopologyClass(topology);
+				state.topology = topology;
+				if (renderContext.graphicsPipeline.GetDynamicStateSupport().extendedDynamicState && sameClass) {
+					vkCmdSetPrimitiveTopology(cmdBuffer, topology);
+				} else CmdBindPipelineVariant(cmdBuffer, state);
+			}
+
+			/// @brief Sets depth testing of the following draws (renderer must have a depth image to depth test).
+			void CmdSetDepthState(VkCommandBuffer cmdBuffer, TinyVkPipelineVariant& state, VkBool32 depthTest, VkBool32 depthWrite, VkCompareOp depthCompareOp = VK_COMPARE_OP_LESS) {
+				state.depthTest = depthTest;
+				state.depthWrite = depthWrite;
+				state.depthCompareOp = depthCompareOp;
+				if (renderContext.graphicsPipeline.GetDynamicStateSupport().extendedDynamicState) {
+					vkCmdSetDepthTestEnable(cmdBuffer, depthTest);
+					vkCmdSetDepthWriteEnable(cmdBuffer, depthWrite);
+					vkCmdSetDepthCompareOp(cmdBuffer, depthCompareOp);
+				} else CmdBindPipelineVariant(cmdBuffer, state);
+			}
+
+			/// @brief Sets primitive restart (strip topologies with indexed draws) of the following draws.
+			void CmdSetPrimitiveRestart(VkCommandBuffer cmdBuffer, TinyVkPipelineVariant& state, VkBool32 primitiveRestart) {
+				state.primitiveRestart = primitiveRestart;
+				if (renderContext.graphicsPipeline.GetDynamicStateSupport().extendedDynamicState2) {
+					vkCmdSetPrimitiveRestartEnable(cmdBuffer, primitiveRestart);
+				} else CmdBindPipelineVariant(cmdBuffer, state);
+			}
+
+			/// @brief Sets the polygon mode of the following draws (non-solid modes require the fillModeNonSolid device feature).
+			void CmdSetPolygonMode(VkCommandBuffer cmdBuffer, TinyVkPipelineVariant& state, VkPolygonMode polygonMode) {
+				state.polygonMode = polygonMode;
+				if (renderContext.graphicsPipeline.GetDynamicStateSupport().polygonMode) {
+					vkCmdSetPolygonModeEKHR(renderContext.vkdevice.GetInstance(), cmdBuffer, polygonMode);
+				} else CmdBindPipelineVariant(cmdBuffer, state);
+			}
+
+			/// @brief Sets the blend state (blend enable, equation and color write mask) of the following draws.
+			void CmdSetBlendState(VkCommandBuffer cmdBuffer, TinyVkPipelineVariant& state, VkPipelineColorBlendAttachmentState blendState) {
+				state.blendState = blendState;
+				TinyVkDynamicStateSupport support = renderContext.graphicsPipeline.GetDynamicStateSupport();
+				if (support.colorBlendEnable && support.colorBlendEquation && support.colorWriteMask) {
+					renderContext.graphicsPipeline.CmdSetDynamicState(cmdBuffer, state);
+				} else CmdBindPipelineVariant(cmdBuffer, state);
+			}
             
             #pragma endregion
 			#pragma region RENDERING_COMMAND_RECORDING
@@ -92,8 +273,17 @@
 
 				if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to record [begin] to command buffer!");
+				TinyVkDebugUtils::BeginLabel(commandBuffer, gpuScopeName);
+				if (renderContext.gpuProfiler != nullptr) renderContext.gpuProfiler->BeginScope(commandBuffer, gpuScopeName);
+				if (renderContext.pipelineQueries != nullptr) renderContext.pipelineQueries->BeginStatistics(commandBuffer, gpuScopeName);
+				
+				submitImages.insert(submitImages.end(), syncImages.begin(), syncImages.end());
+				submitBuffers.insert(submitBuffers.end(), syncBuffers.begin(), syncBuffers.end());
                 
-                renderTarget->TransitionLayoutBarrier(commandBuffer, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN, TinyVkImageLayout::TINYVK_COLOR_ATTACHMENT);
+                TinyVkBarrierBatch barrierBatch;
+				if (renderTarget->imageType == TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN) { // Orders the transition after the acquire semaphore wait.
+					renderTarget->TransitionLayoutBarrier(barrierBatch, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN, TinyVkImageLayout::TINYVK_COLOR_ATTACHMENT, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT);
+				} else renderTarget->TransitionLayoutBarrier(barrierBatch, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN, TinyVkImageLayout::TINYVK_COLOR_ATTACHMENT);
 
 				VkRenderingAttachmentInfoKHR colorAttachmentInfo{};
 				colorAttachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
@@ -119,7 +309,7 @@
                     if (optionalDepthImage == VK_NULL_HANDLE)
                         throw TinyVkRuntimeError("TinyVulkan: Trying to render with TinyVkGraphicsRenderer without depth image [VK_NULL_HANDLE]! on depth testing enabled graphics pipeline!");
 					
-                    optionalDepthImage->TransitionLayoutBarrier(commandBuffer, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN, TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT);
+                    optionalDepthImage->TransitionLayoutBarrier(barrierBatch, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN, TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT);
 
                     depthStencilAttachmentInfo.sType = VK_STRUCTURE_TYPE_RENDERING_ATTACHMENT_INFO_KHR;
 					depthStencilAttachmentInfo.imageView = optionalDepthImage->imageView;
@@ -139,11 +329,15 @@
 				dynamicViewportKHR.maxDepth = 1.0f;
 				vkCmdSetViewport(commandBuffer, 0, 1, &dynamicViewportKHR);
 				vkCmdSetScissor(commandBuffer, 0, 1, &renderAreaKHR);
+				barrierBatch.Flush(commandBuffer);
                 
                 if (vkCmdBeginRenderingEKHR(renderContext.vkdevice.GetInstance(), commandBuffer, &dynamicRenderInfo) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to record [begin] to rendering!");
 				
 				vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, renderContext.graphicsPipeline.GetGraphicsPipeline());
+				renderContext.graphicsPipeline.CmdSetDynamicState(commandBuffer, renderContext.graphicsPipeline.GetBaseVariant());
+				if (renderContext.graphicsPipeline.GetBindlessTable() != nullptr)
+					renderContext.graphicsPipeline.GetBindlessTable()->CmdBindDescriptorSet(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, renderContext.graphicsPipeline.GetPipelineLayout());
 			}
 
 			/// @brief Ends recording render commands to the provided command buffer.
@@ -151,15 +345,20 @@
 				if (vkCmdEndRenderingEKHR(renderContext.vkdevice.GetInstance(), commandBuffer) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to record [end] to rendering!");
 
-				renderTarget->TransitionLayoutBarrier(commandBuffer, TinyVkCmdBufferSubmitStage::TINYVK_END, (renderTarget->imageType == TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN)? TinyVkImageLayout::TINYVK_PRESENT_SRC : TinyVkImageLayout::TINYVK_COLOR_ATTACHMENT);
+				TinyVkBarrierBatch barrierBatch;
+				renderTarget->TransitionLayoutBarrier(barrierBatch, TinyVkCmdBufferSubmitStage::TINYVK_END, (renderTarget->imageType == TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN)? TinyVkImageLayout::TINYVK_PRESENT_SRC : TinyVkImageLayout::TINYVK_COLOR_ATTACHMENT);
 
 				if (renderContext.graphicsPipeline.DepthTestingIsEnabled()) {
                     if (optionalDepthImage == VK_NULL_HANDLE)
                         throw TinyVkRuntimeError("TinyVulkan: Trying to render with TinyVkGraphicsRenderer without depth image [VK_NULL_HANDLE] on depth testing enabled graphics pipeline!");
 					
-                    optionalDepthImage->TransitionLayoutBarrier(commandBuffer, TinyVkCmdBufferSubmitStage::TINYVK_END, TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT);
+                    optionalDepthImage->TransitionLayoutBarrier(barrierBatch, TinyVkCmdBufferSubmitStage::TINYVK_END, TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT);
 				}
+				barrierBatch.Flush(commandBuffer);
 
+				if (renderContext.pipelineQueries != nullptr) renderContext.pipelineQueries->EndStatistics(commandBuffer);
+				if (renderContext.gpuProfiler != nullptr) renderContext.gpuProfiler->EndScope(commandBuffer);
+				TinyVkDebugUtils::EndLabel(commandBuffer);
 				if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to record [end] to command buffer!");
 			}
@@ -168,61 +367,21 @@
 			#pragma region RENDERING_SUBMISSION_AND_EXECUTION
 
 			/// @brief Executes the registered onRenderEvents and renders them to the target image/texture.
-			virtual VkResult RenderExecute(bool waitFences = true) {
+			/// @param waitLastUse Waits on the CPU for the render target's last use, otherwise only waits if every command buffer of the pool is still in flight.
+			virtual VkResult RenderExecute(bool waitLastUse = true) {
+				TinyVkRenderStatsScope statsScope(renderStats, true);
 				if (renderTarget == VK_NULL_HANDLE)
                     throw TinyVkRuntimeError("TinyVulkan: RenderTarget for TinyVkImageRenderer is [VK_NULL_HANDLE]!");
 				
-				if (waitFences) {
-					vkWaitForFences(renderContext.vkdevice.GetLogicalDevice(), 1, &renderTarget->imageWaitable, VK_TRUE, UINT64_MAX);
-					vkResetFences(renderContext.vkdevice.GetLogicalDevice(), 1, &renderTarget->imageWaitable);
-				}
-				
-				//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-				if (renderContext.graphicsPipeline.DepthTestingIsEnabled()) {
-                    if (optionalDepthImage == VK_NULL_HANDLE)
-                        throw TinyVkRuntimeError("TinyVulkan: Trying to render with TinyVkGraphicsRenderer without depth image [VK_NULL_HANDLE]! on depth testing enabled graphics pipeline!");
-                    
-                    if (optionalDepthImage->width != renderTarget->width || optionalDepthImage->height != renderTarget->height) {
-						optionalDepthImage->Disposable(false);
-						optionalDepthImage->ReCreateImage(optionalDepthImage->imageType, renderTarget->width, renderTarget->height, renderContext.graphicsPipeline.QueryDepthFormat(), VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
-					}
+				renderContext.graphicsPipeline.ApplyShaderReloads(this);
+				if (waitLastUse) {
+					VkResult result = renderTarget->lastUse.Wait(UINT64_MAX, "TinyVkGraphicsRenderer::RenderExecute");
+					if (result != VK_SUCCESS) return result;
 				}
 				
-				commandPool->ReturnAllBuffers();
-                onRenderEvents.invoke(*commandPool);
-				//////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
-                
-				std::vector<VkCommandBuffer> commandBuffers;
-				auto buffers = commandPool->GetBuffers();
-				std::for_each(buffers.begin(), buffers.end(),
-					[&commandBuffers](std::pair<VkCommandBuffer, VkBool32> cmdBuffer){
-						if (cmdBuffer.second) commandBuffers.push_back(cmdBuffer.first);
-				});
-
-				VkSubmitInfo submitInfo{};
-				submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-				submitInfo.commandBufferCount = static_cast<uint32_t>(commandBuffers.size());
-				submitInfo.pCommandBuffers = commandBuffers.data();
-				
-				VkPipelineStageFlags waitStages[] = { VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT };
-				VkSemaphore waitSemaphores[] = { renderTarget->imageAvailable };
-				VkSemaphore signalSemaphores[] = { renderTarget->imageFinished };
-				
-				VkResult result;
-				if (renderTarget->imageType == TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN) {
-					submitInfo.waitSemaphoreCount = 1;
-					submitInfo.pWaitDstStageMask = waitStages;
-					submitInfo.pWaitSemaphores = waitSemaphores;
-					submitInfo.signalSemaphoreCount = 1;
-					submitInfo.pSignalSemaphores = signalSemaphores;
-					result = vkQueueSubmit(renderContext.graphicsPipeline.GetPresentQueue(), 1, &submitInfo, renderTarget->imageWaitable);
-				} else {
-					result = vkQueueSubmit(renderContext.graphicsPipeline.GetGraphicsQueue(), 1, &submitInfo, renderTarget->imageWaitable);
-				}
-
-				if (result != VK_SUCCESS)
-					throw TinyVkRuntimeError("TinyVulkan: Failed to submit draw command buffer graphics queue!");
-				return result;
+				std::vector<VkCommandBuffer> commandBuffers = RecordRenderCommands();
+				TrackRenderSubmission(SubmitRenderCommands(commandBuffers));
+				return VK_SUCCESS;
 			}
 
 			/// @brief Acquires the target's mutex lock and executes the registered onRenderEvents and renders them to the target image/texture.
@@ -47,6 +47,10 @@
 		/// @brief GPU device image for sending images to the render (GPU) device.
 		class TinyVkImage : public TinyVkDisposable {
 		private:
+			TinyVkBindlessTable* bindlessTable = nullptr;
+			uint32_t bindlessIndex = UINT32_MAX;
+			TinyVkImageLayout bindlessLayout = TinyVkImageLayout::TINYVK_SHADER_READONLY;
+
 			void CreateImageView() {
 				VkImageViewCreateInfo createInfo{};
 				createInfo.sType = VK_STRUCTURE_TYPE_IMAGE_VIEW_CREATE_INFO;
@@ -86,21 +90,6 @@
 				if (vkCreateSampler(renderContext.vkdevice.GetLogicalDevice(), &samplerInfo, VK_NULL_HANDLE, &imageSampler) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to create image texture sampler!");
 			}
-
-			void CreateImageSyncObjects() {
-				VkSemaphoreCreateInfo semaphoreInfo{};
-				semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
-				semaphoreInfo.flags = VK_SEMAPHORE_TYPE_BINARY;
-
-				VkFenceCreateInfo fenceInfo{};
-				fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-				fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-				if (vkCreateSemaphore(renderContext.vkdevice.GetLogicalDevice(), &semaphoreInfo, VK_NULL_HANDLE, &imageAvailable) != VK_SUCCESS ||
-					vkCreateSemaphore(renderContext.vkdevice.GetLogicalDevice(), &semaphoreInfo, VK_NULL_HANDLE, &imageFinished) != VK_SUCCESS ||
-					vkCreateFence(renderContext.vkdevice.GetLogicalDevice(), &fenceInfo, VK_NULL_HANDLE, &imageWaitable) != VK_SUCCESS)
-					throw TinyVkRuntimeError("TinyVulkan: Failed to create synchronization objects for TinyVkImage!");
-			}
 		public:
 			std::timed_mutex image_lock;
 
@@ -111,10 +100,8 @@
 			TinyVkImageLayout imageLayout;
 			VkImageAspectFlags aspectFlags;
 			VkSamplerAddressMode addressingMode;
-
-			VkSemaphore imageAvailable;
-			VkSemaphore imageFinished;
-			VkFence imageWaitable;
+			TinyVkTimelinePoint lastUse; /// Timeline point of the last submission using this image.
+			std::string debugName; /// VK_EXT_debug_utils name of the image, view and sampler (re-applied when the image is re-created).
 
 			VkDeviceSize width, height;
 			VkFormat format;
@@ -127,36 +114,110 @@
 			
 			~TinyVkImage() { this->Dispose(); }
 
+			/// @brief Destroys the image after its last use: waits on the CPU (waitIdle) or retires it to the TinyVkVulkanDevice.
+			/// The bindless slot is kept so ReCreateImage() can rewrite it in place, Dispose() releases it.
 			void Disposable(bool waitIdle) {
-				if (waitIdle) renderContext.vkdevice.DeviceWaitIdle();
+				if (waitIdle) lastUse.Wait(UINT64_MAX, "TinyVkImage::Disposable");
 				
 				if (imageType != TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN) {
-					vkDestroySampler(renderContext.vkdevice.GetLogicalDevice(), imageSampler, VK_NULL_HANDLE);
-					vkDestroyImageView(renderContext.vkdevice.GetLogicalDevice(), imageView, VK_NULL_HANDLE);
-					vmaDestroyImage(renderContext.vkdevice.GetAllocator(), image, memory);
-					vkDestroySemaphore(renderContext.vkdevice.GetLogicalDevice(), imageAvailable, VK_NULL_HANDLE);
-					vkDestroySemaphore(renderContext.vkdevice.GetLogicalDevice(), imageFinished, VK_NULL_HANDLE);
-					vkDestroyFence(renderContext.vkdevice.GetLogicalDevice(), imageWaitable, VK_NULL_HANDLE);
+					VkDevice logicalDevice = renderContext.vkdevice.GetLogicalDevice();
+					VmaAllocator allocator = renderContext.vkdevice.GetAllocator();
+					VkSampler imageSampler = this->imageSampler;
+					VkImageView imageView = this->imageView;
+					VkImage image = this->image;
+					VmaAllocation memory = this->memory;
+
+					renderContext.vkdevice.RetireResource(lastUse, [logicalDevice, allocator, imageSampler, imageView, image, memory]() {
+						vkDestroySampler(logicalDevice, imageSampler, VK_NULL_HANDLE);
+						vkDestroyImageView(logicalDevice, imageView, VK_NULL_HANDLE);
+						if (memory != VK_NULL_HANDLE) {
+							vmaDestroyImage(allocator, image, memory);
+						} else vkDestroyImage(logicalDevice, image, VK_NULL_HANDLE);
+					});
 				}
 			}
 
 			/// @brief Creates a VkImage for rendering or loading image files (stagedata) into.
-			TinyVkImage(TinyVkRenderContext& renderContext, TinyVkImageType type, VkDeviceSize width, VkDeviceSize height, VkImage imageSource = VK_NULL_HANDLE, VkImageView imageViewSource = VK_NULL_HANDLE, VkSampler imageSampler = VK_NULL_HANDLE, VkSemaphore imageAvailable = VK_NULL_HANDLE, VkSemaphore imageFinished = VK_NULL_HANDLE, VkFence imageWaitable = VK_NULL_HANDLE, VkFormat format = VK_FORMAT_B8G8R8A8_UNORM, VkSamplerAddressMode addressingMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE)
-			: renderContext(renderContext), imageType(type), width(width), height(height), image(imageSource), imageView(imageViewSource), imageSampler(imageSampler), imageAvailable(imageAvailable), imageFinished(imageFinished), imageWaitable(imageWaitable), format(format), imageLayout(TinyVkImageLayout::TINYVK_UNDEFINED), addressingMode(addressingMode), aspectFlags(aspectFlags) {
-				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+			TinyVkImage(TinyVkRenderContext& renderContext, TinyVkImageType type, VkDeviceSize width, VkDeviceSize height, VkImage imageSource = VK_NULL_HANDLE, VkImageView imageViewSource = VK_NULL_HANDLE, VkSampler imageSampler = VK_NULL_HANDLE, VkFormat format = VK_FORMAT_B8G8R8A8_UNORM, VkSamplerAddressMode addressingMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE)
+			: renderContext(renderContext), imageType(type), width(width), height(height), image(imageSource), imageView(imageViewSource), imageSampler(imageSampler), format(format), imageLayout(TinyVkImageLayout::TINYVK_UNDEFINED), addressingMode(addressingMode), aspectFlags(aspectFlags) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) { this->UnregisterBindless(); this->Disposable(forceDispose); }));
+
+				#if TVK_DEBUG_UTILS
+					static const char* typeNames[] = { "SWAPCHAIN", "COLORATTACHMENT", "STORAGE", "DEPTHSTENCIL" };
+					debugName = "TinyVkImage[" + std::string(typeNames[static_cast<size_t>(type)]) + "]";
+				#endif
 				
 				if (type == TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN) {
 					if (imageSource == VK_NULL_HANDLE)
 						throw TinyVkRuntimeError("TinyVulkan: passed SwapChain image is: VK_NULL_HANDLE");
 					imageLayout = TinyVkImageLayout::TINYVK_UNDEFINED;
 					aspectFlags = VK_IMAGE_ASPECT_COLOR_BIT;
+				} else if (imageSource != VK_NULL_HANDLE) {
+					// Adopted image (e.g. aliased frame graph transients): the VkImage is destroyed with this TinyVkImage, its bound memory is owned by the caller.
+					imageLayout = TinyVkImageLayout::TINYVK_UNDEFINED;
+					aspectFlags = GetFormatAspectFlags(type, format);
+					if (imageView == VK_NULL_HANDLE) CreateImageView();
+					if (imageSampler == VK_NULL_HANDLE) CreateTextureSampler();
 				} else {
 					ReCreateImage(type, width, height, format, addressingMode);
 				}
+				SetDebugName(debugName);
+			}
+
+			/// @brief Names the VkImage, its view and sampler in validation messages and GPU captures (VK_EXT_debug_utils, compiled out in release).
+			void SetDebugName(const std::string& name) {
+				#if TVK_DEBUG_UTILS
+					debugName = name;
+					VkDevice logicalDevice = renderContext.vkdevice.GetLogicalDevice();
+					TinyVkDebugUtils::SetObjectName(logicalDevice, VK_OBJECT_TYPE_IMAGE, image, name);
+					TinyVkDebugUtils::SetObjectName(logicalDevice, VK_OBJECT_TYPE_IMAGE_VIEW, imageView, name + "::ImageView");
+					TinyVkDebugUtils::SetObjectName(logicalDevice, VK_OBJECT_TYPE_SAMPLER, imageSampler, name + "::Sampler");
+				#endif
+			}
+
+			#pragma region BINDLESS_TEXTURES
+
+			/// @brief Writes this image into a free slot of a bindless table and returns its index, stable until disposed/unregistered (see ABOUT BINDLESS TEXTURES).
+			uint32_t RegisterBindless(TinyVkBindlessTable& table, TinyVkImageLayout layout = TinyVkImageLayout::TINYVK_SHADER_READONLY) {
+				if (imageType == TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN)
+					throw TinyVkRuntimeError("TinyVulkan: Swapchain images can not be registered in a TinyVkBindlessTable!");
+				if (bindlessTable == &table && bindlessLayout == layout) return bindlessIndex;
+				UnregisterBindless();
+
+				bindlessIndex = table.RegisterImage(imageView, imageSampler, (VkImageLayout) layout, [this]() { bindlessTable = nullptr; bindlessIndex = UINT32_MAX; });
+				bindlessTable = &table;
+				bindlessLayout = layout;
+				return bindlessIndex;
+			}
+
+			/// @brief Releases this image's bindless table slot, the image is kept alive until the graphics queue's submissions made so far complete.
+			void UnregisterBindless() {
+				if (bindlessTable == nullptr) return;
+				bindlessTable->ReleaseImage(bindlessIndex);
+
+				TinyVkTimelinePoint submitted = renderContext.vkdevice.GetGraphicsTimeline().GetSubmittedPoint();
+				if (lastUse.timeline != submitted.timeline && lastUse.Wait(UINT64_MAX, "TinyVkImage::UnregisterBindless") != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Timed out waiting on the last use of TinyVkImage!");
+				lastUse = submitted;
+				bindlessTable = nullptr;
+				bindlessIndex = UINT32_MAX;
 			}
 
+			/// @brief Returns the image's bindless table slot (UINT32_MAX if not registered).
+			uint32_t GetBindlessIndex() { return bindlessIndex; }
+
+			#pragma endregion
 			#pragma region IMAGE_INITIATION_AND_SYNCHRONIZATION
 
+			/// @brief Returns the image aspect flags for an image type/format (stencil is only included for formats which have a stencil component).
+			inline static VkImageAspectFlags GetFormatAspectFlags(TinyVkImageType type, VkFormat format) {
+				if (type != TinyVkImageType::TINYVK_IMAGE_TYPE_DEPTHSTENCIL) return VK_IMAGE_ASPECT_COLOR_BIT;
+				
+				if (format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT || format == VK_FORMAT_D16_UNORM_S8_UINT)
+					return VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+				return VK_IMAGE_ASPECT_DEPTH_BIT;
+			}
+
 			/// @brief Recreates this TinyVkImage using a new layout/format (don't forget to call image.Disposable(bool waitIdle) to dispose of the previous image first.
 			void ReCreateImage(TinyVkImageType type, VkDeviceSize width, VkDeviceSize height, VkFormat format = VK_FORMAT_R16G16B16A16_UNORM, VkSamplerAddressMode addressingMode = VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE) {
 				if (type == TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN)
@@ -180,7 +241,7 @@
 					case TinyVkImageType::TINYVK_IMAGE_TYPE_DEPTHSTENCIL:
 						newLayout = TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT;
 						imgCreateInfo.usage |= VK_IMAGE_USAGE_DEPTH_STENCIL_ATTACHMENT_BIT;
-						aspectFlags = VK_IMAGE_ASPECT_DEPTH_BIT | VK_IMAGE_ASPECT_STENCIL_BIT;
+						aspectFlags = GetFormatAspectFlags(type, format);
 					break;
 					case TinyVkImageType::TINYVK_IMAGE_TYPE_STORAGE:
 						newLayout = TinyVkImageLayout::TINYVK_GENERAL;
@@ -204,64 +265,65 @@
 				
 				CreateTextureSampler();
 				CreateImageView();
-				CreateImageSyncObjects();
+				SetDebugName(debugName);
+				if (bindlessTable != nullptr) bindlessTable->UpdateImage(bindlessIndex, imageView, imageSampler, (VkImageLayout) bindlessLayout);
 				
 				if (newLayout != TinyVkImageLayout::TINYVK_UNDEFINED)
 					TransitionLayoutCmd(newLayout);
 			}
 			
 			/// @brief Get pipeline stages relative to the current image layout and command buffer recording stage.
-			void GetPipelineBarrierStages(TinyVkImageLayout layout, TinyVkCmdBufferSubmitStage cmdBufferStage, VkPipelineStageFlags& srcStage, VkPipelineStageFlags& dstStage, VkAccessFlags& srcAccessMask, VkAccessFlags& dstAccessMask) {
+			void GetPipelineBarrierStages(TinyVkImageLayout layout, TinyVkCmdBufferSubmitStage cmdBufferStage, VkPipelineStageFlags2& srcStage, VkPipelineStageFlags2& dstStage, VkAccessFlags2& srcAccessMask, VkAccessFlags2& dstAccessMask) {
 				if (cmdBufferStage == TinyVkCmdBufferSubmitStage::TINYVK_BEGIN) {
 					switch (layout) {
 						case TinyVkImageLayout::TINYVK_COLOR_ATTACHMENT:
-							srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-							dstStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-							srcAccessMask = VK_ACCESS_NONE;
-							dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+							srcStage = VK_PIPELINE_STAGE_2_NONE;
+							dstStage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+							srcAccessMask = VK_ACCESS_2_NONE;
+							dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT;
 						break;
 						case TinyVkImageLayout::TINYVK_PRESENT_SRC:
-							srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-							dstStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-							srcAccessMask = VK_ACCESS_NONE;
-							dstAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
+							srcStage = VK_PIPELINE_STAGE_2_NONE;
+							dstStage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+							srcAccessMask = VK_ACCESS_2_NONE;
+							dstAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT;
 						break;
 						case TinyVkImageLayout::TINYVK_TRANSFER_SRC:
-							srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-							dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-							srcAccessMask = VK_ACCESS_NONE;
-							dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
+							srcStage = VK_PIPELINE_STAGE_2_NONE;
+							dstStage = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+							srcAccessMask = VK_ACCESS_2_NONE;
+							dstAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
 						break;
 						case TinyVkImageLayout::TINYVK_TRANSFER_DST:
-							srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-							dstStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-							srcAccessMask = VK_ACCESS_NONE;
-							dstAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
+							srcStage = VK_PIPELINE_STAGE_2_NONE;
+							dstStage = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+							srcAccessMask = VK_ACCESS_2_NONE;
+							dstAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
 						break;
 						case TinyVkImageLayout::TINYVK_SHADER_READONLY:
-							srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-							dstStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-							srcAccessMask = VK_ACCESS_NONE;
-							dstAccessMask = VK_ACCESS_SHADER_READ_BIT;
+							srcStage = VK_PIPELINE_STAGE_2_NONE;
+							dstStage = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+							srcAccessMask = VK_ACCESS_2_NONE;
+							dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
 						break;
 						case TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT:
-							srcStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-							dstStage = VK_PIPELINE_STAGE_EARLY_FRAGMENT_TESTS_BIT;
-							srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-							dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+							srcStage = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_EARLY_FRAGMENT_TESTS_BIT;
+							srcAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+							dstAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 						break;
 						case TinyVkImageLayout::TINYVK_GENERAL:
-							srcStage = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
-							dstStage = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
-							srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
-							dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+							srcStage = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+							srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT;
+							dstAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT;
 						break;
 						case TinyVkImageLayout::TINYVK_UNDEFINED:
 						default:
-							srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-							dstStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-							srcAccessMask = VK_ACCESS_NONE;
-							dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;;
+							srcStage = VK_PIPELINE_STAGE_2_NONE;
+							dstStage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+							srcAccessMask = VK_ACCESS_2_NONE;
+							dstAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
 						break;
 					}
 				}
@@ -269,85 +331,79 @@
 				if (cmdBufferStage == TinyVkCmdBufferSubmitStage::TINYVK_END) {
 					switch (layout) {
 						case TinyVkImageLayout::TINYVK_COLOR_ATTACHMENT:
-							srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-							dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-							srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-							dstAccessMask = VK_ACCESS_NONE;
+							srcStage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_NONE;
+							srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT | VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT;
+							dstAccessMask = VK_ACCESS_2_NONE;
 						break;
 						case TinyVkImageLayout::TINYVK_PRESENT_SRC:
-							srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-							dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-							srcAccessMask = VK_ACCESS_COLOR_ATTACHMENT_READ_BIT;
-							dstAccessMask = VK_ACCESS_NONE;
+							srcStage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_NONE;
+							srcAccessMask = VK_ACCESS_2_COLOR_ATTACHMENT_READ_BIT;
+							dstAccessMask = VK_ACCESS_2_NONE;
 						break;
 						case TinyVkImageLayout::TINYVK_TRANSFER_SRC:
-							srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-							dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-							srcAccessMask = VK_ACCESS_TRANSFER_READ_BIT;
-							dstAccessMask = VK_ACCESS_NONE;
+							srcStage = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_NONE;
+							srcAccessMask = VK_ACCESS_2_TRANSFER_READ_BIT;
+							dstAccessMask = VK_ACCESS_2_NONE;
 						break;
 						case TinyVkImageLayout::TINYVK_TRANSFER_DST:
-							srcStage = VK_PIPELINE_STAGE_TRANSFER_BIT;
-							dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-							srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT;
-							dstAccessMask = VK_ACCESS_NONE;
+							srcStage = VK_PIPELINE_STAGE_2_TRANSFER_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_NONE;
+							srcAccessMask = VK_ACCESS_2_TRANSFER_WRITE_BIT;
+							dstAccessMask = VK_ACCESS_2_NONE;
 						break;
 						case TinyVkImageLayout::TINYVK_SHADER_READONLY:
-							srcStage = VK_PIPELINE_STAGE_FRAGMENT_SHADER_BIT;
-							dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-							srcAccessMask = VK_ACCESS_SHADER_READ_BIT;
-							dstAccessMask = VK_ACCESS_NONE;
+							srcStage = VK_PIPELINE_STAGE_2_FRAGMENT_SHADER_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_NONE;
+							srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT;
+							dstAccessMask = VK_ACCESS_2_NONE;
 						break;
 						case TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT:
-							srcStage = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-							dstStage = VK_PIPELINE_STAGE_LATE_FRAGMENT_TESTS_BIT;
-							srcAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
-							dstAccessMask = VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+							srcStage = VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_LATE_FRAGMENT_TESTS_BIT;
+							srcAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
+							dstAccessMask = VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_READ_BIT | VK_ACCESS_2_DEPTH_STENCIL_ATTACHMENT_WRITE_BIT;
 						break;
 						case TinyVkImageLayout::TINYVK_GENERAL:
-							srcStage = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
-							dstStage = VK_PIPELINE_STAGE_ALL_GRAPHICS_BIT;
-							srcAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
-							dstAccessMask = VK_ACCESS_SHADER_WRITE_BIT | VK_ACCESS_SHADER_READ_BIT;
+							srcStage = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_ALL_GRAPHICS_BIT | VK_PIPELINE_STAGE_2_COMPUTE_SHADER_BIT;
+							srcAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT;
+							dstAccessMask = VK_ACCESS_2_SHADER_WRITE_BIT | VK_ACCESS_2_SHADER_READ_BIT;
 						break;
 						case TinyVkImageLayout::TINYVK_UNDEFINED:
 						default:
-							srcStage = VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT;
-							dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-							srcAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT;;
-							dstAccessMask = VK_ACCESS_NONE;
+							srcStage = VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT;
+							dstStage = VK_PIPELINE_STAGE_2_NONE;
+							srcAccessMask = VK_ACCESS_2_SHADER_READ_BIT | VK_ACCESS_2_SHADER_WRITE_BIT;
+							dstAccessMask = VK_ACCESS_2_NONE;
 						break;
 					}
 				}
 
 				if (cmdBufferStage == TinyVkCmdBufferSubmitStage::TINYVK_BEGIN_TO_END) {
-					srcStage = VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT;
-					dstStage = VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT;
-					srcAccessMask = VK_ACCESS_NONE;
-					dstAccessMask = VK_ACCESS_NONE;
+					srcStage = VK_PIPELINE_STAGE_2_NONE;
+					dstStage = VK_PIPELINE_STAGE_2_NONE;
+					srcAccessMask = VK_ACCESS_2_NONE;
+					dstAccessMask = VK_ACCESS_2_NONE;
 				}
 			}
 					
-			/// @brief Get the pipeline barrier info for resource synchronization in image pipeline barrier pNext chain.
-			VkImageMemoryBarrier GetPipelineBarrier(TinyVkImageLayout newLayout, TinyVkCmdBufferSubmitStage cmdBufferStage, VkPipelineStageFlags& srcStage, VkPipelineStageFlags& dstStage) {
-				VkImageMemoryBarrier pipelineBarrier = {
-					.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER,
+			/// @brief Get the synchronization2 pipeline barrier (stage/access masks included) for transitioning this image into a new layout.
+			VkImageMemoryBarrier2 GetPipelineBarrier(TinyVkImageLayout newLayout, TinyVkCmdBufferSubmitStage cmdBufferStage) {
+				VkImageMemoryBarrier2 pipelineBarrier = {
+					.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_BARRIER_2,
 					.oldLayout = (VkImageLayout) imageLayout, .newLayout = (VkImageLayout) newLayout,
 					.srcQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED, .dstQueueFamilyIndex = VK_QUEUE_FAMILY_IGNORED,
-					.subresourceRange = { .aspectMask = VK_IMAGE_ASPECT_COLOR_BIT, .baseMipLevel = 0, .levelCount = 1, .baseArrayLayer = 0, .layerCount = 1, },
 					.image = image,
+					.subresourceRange = { .aspectMask = GetFormatAspectFlags(imageType, format), .baseMipLevel = 0, .levelCount = 1, .baseArrayLayer = 0, .layerCount = 1, },
 				};
 
-				if (imageLayout == TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT || newLayout == TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT) {
-					pipelineBarrier.subresourceRange.aspectMask = VK_IMAGE_ASPECT_DEPTH_BIT;
-					if (format == VK_FORMAT_D32_SFLOAT_S8_UINT || format == VK_FORMAT_D24_UNORM_S8_UINT)
-						pipelineBarrier.subresourceRange.aspectMask |= VK_IMAGE_ASPECT_STENCIL_BIT;
-				}
+				if (imageLayout == TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT || newLayout == TinyVkImageLayout::TINYVK_DEPTHSTENCIL_ATTACHMENT)
+					pipelineBarrier.subresourceRange.aspectMask = GetFormatAspectFlags(TinyVkImageType::TINYVK_IMAGE_TYPE_DEPTHSTENCIL, format);
 
-				VkAccessFlags srcAccessMask, dstAccessMask;
-				GetPipelineBarrierStages(newLayout, cmdBufferStage, srcStage, dstStage, srcAccessMask, dstAccessMask);
-				pipelineBarrier.srcAccessMask = srcAccessMask;
-				pipelineBarrier.dstAccessMask = dstAccessMask;
+				GetPipelineBarrierStages(newLayout, cmdBufferStage, pipelineBarrier.srcStageMask, pipelineBarrier.dstStageMask, pipelineBarrier.srcAccessMask, pipelineBarrier.dstAccessMask);
 				return pipelineBarrier;
 			}
 			
@@ -362,60 +418,88 @@
 				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
 				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
 				vkBeginCommandBuffer(bufferIndexPair.first, &beginInfo);
+				if (renderContext.gpuProfiler != nullptr) renderContext.gpuProfiler->BeginScope(bufferIndexPair.first, "TinyVkImage::Transfer");
+
+				// Earlier submissions on the queue which still use the transferred resources finish before the copy (replaces the CPU wait on lastUse).
+				TinyVkBarrierBatch barrierBatch;
+				barrierBatch.Memory(VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT,
+					VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_READ_BIT | VK_ACCESS_2_TRANSFER_WRITE_BIT);
+				barrierBatch.Flush(bufferIndexPair.first);
 				return bufferIndexPair;
 			}
 
-			/// @brief Ends a transfer command and gives the leased/rented command buffer pair back to the TinyVkCommandPool.
-			void EndTransferCmd(std::pair<VkCommandBuffer, int32_t> bufferIndexPair) {
+			/// @brief Ends a transfer command, submits it to the graphics timeline (collected by an active TinyVkSubmissionBatch) and
+			/// retires the command buffer to the returned timeline point, the CPU does not wait (wait on lastUse before reading back).
+			/// Pass the waits of resources last used on another queue (see TinyVkTimeline::AddWait()), the GPU waits on those instead.
+			TinyVkTimelinePoint EndTransferCmd(std::pair<VkCommandBuffer, int32_t> bufferIndexPair, const std::vector<TinyVkSemaphoreWait>& waits = {}) {
+				// Transfer writes are made visible to every later submission on the queue and to host reads of the timeline point.
+				TinyVkBarrierBatch barrierBatch;
+				barrierBatch.Memory(VK_PIPELINE_STAGE_2_TRANSFER_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT,
+					VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT | VK_PIPELINE_STAGE_2_HOST_BIT, VK_ACCESS_2_MEMORY_READ_BIT | VK_ACCESS_2_MEMORY_WRITE_BIT | VK_ACCESS_2_HOST_READ_BIT);
+				barrierBatch.Flush(bufferIndexPair.first);
+
+				if (renderContext.gpuProfiler != nullptr) renderContext.gpuProfiler->EndScope(bufferIndexPair.first);
 				vkEndCommandBuffer(bufferIndexPair.first);
 
-				VkSubmitInfo submitInfo{};
-				submitInfo.sType = VK_STRUCTURE_TYPE_SUBMIT_INFO;
-				submitInfo.commandBufferCount = 1;
-				submitInfo.pCommandBuffers = &bufferIndexPair.first;
-
-				vkQueueSubmit(renderContext.graphicsPipeline.GetGraphicsQueue(), 1, &submitInfo, VK_NULL_HANDLE);
-				vkQueueWaitIdle(renderContext.graphicsPipeline.GetGraphicsQueue());
-				vkResetCommandBuffer(bufferIndexPair.first, VK_COMMAND_BUFFER_RESET_RELEASE_RESOURCES_BIT);
-				renderContext.commandPool.ReturnBuffer(bufferIndexPair);
+				TINYVK_TRACE_SCOPE_CATEGORY("TinyVkImage::EndTransferCmd", "tinyvk");
+				lastUse = renderContext.vkdevice.GetGraphicsTimeline().Submit({ bufferIndexPair.first }, waits);
+				renderContext.commandPool.RetireBuffer(bufferIndexPair, lastUse);
+				return lastUse;
 			}
 			
 			/// @brief Transitions the GPU bound VkImage from its current layout into a new layout.
 			void TransitionLayoutCmd(TinyVkImageLayout newLayout) {
+				std::vector<TinyVkSemaphoreWait> waits;
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, lastUse);
 				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = BeginTransferCmd();
 				
-				VkPipelineStageFlags srcStage, dstStage;
-				VkImageMemoryBarrier pipelineBarrier = GetPipelineBarrier(newLayout, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN_TO_END, srcStage, dstStage);
+				TransitionLayoutBarrier(bufferIndexPair.first, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN_TO_END, newLayout);
+
+				EndTransferCmd(bufferIndexPair, waits);
+			}
+
+			/// @brief Adds the transition of the GPU bound VkImage into a new layout to a barrier batch (recorded on the batch's next Flush()).
+			void TransitionLayoutBarrier(TinyVkBarrierBatch& barrierBatch, TinyVkCmdBufferSubmitStage cmdBufferStage, TinyVkImageLayout newLayout) {
+				VkImageMemoryBarrier2 pipelineBarrier = GetPipelineBarrier(newLayout, cmdBufferStage);
 				imageLayout = newLayout;
 				aspectFlags = pipelineBarrier.subresourceRange.aspectMask;
-				vkCmdPipelineBarrier(bufferIndexPair.first, VK_PIPELINE_STAGE_TOP_OF_PIPE_BIT, VK_PIPELINE_STAGE_BOTTOM_OF_PIPE_BIT, 0, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, 1, &pipelineBarrier);
+				barrierBatch.Add(pipelineBarrier);
+			}
 
-				EndTransferCmd(bufferIndexPair);
+			/// @brief Adds the transition into a new layout to a barrier batch with an explicit source stage instead of the one derived from the
+			/// current layout, e.g. the stage waiting on a swapchain acquire semaphore (the transition must be ordered after that wait).
+			void TransitionLayoutBarrier(TinyVkBarrierBatch& barrierBatch, TinyVkCmdBufferSubmitStage cmdBufferStage, TinyVkImageLayout newLayout, VkPipelineStageFlags2 srcStageMask) {
+				VkImageMemoryBarrier2 pipelineBarrier = GetPipelineBarrier(newLayout, cmdBufferStage);
+				pipelineBarrier.srcStageMask = srcStageMask;
+				imageLayout = newLayout;
+				aspectFlags = pipelineBarrier.subresourceRange.aspectMask;
+				barrierBatch.Add(pipelineBarrier);
 			}
 
 			/// @brief Transitions the GPU bound VkImage from its current layout into a new layout.
 			void TransitionLayoutBarrier(VkCommandBuffer cmdBuffer, TinyVkCmdBufferSubmitStage cmdBufferStage, TinyVkImageLayout newLayout) {
-				VkPipelineStageFlags srcStage, dstStage;
-				VkImageMemoryBarrier pipelineBarrier = GetPipelineBarrier(newLayout, cmdBufferStage, srcStage, dstStage);
-				imageLayout = newLayout;
-				aspectFlags = pipelineBarrier.subresourceRange.aspectMask;
-				vkCmdPipelineBarrier(cmdBuffer, srcStage, dstStage, 0, 0, VK_NULL_HANDLE, 0, VK_NULL_HANDLE, 1, &pipelineBarrier);
+				TinyVkBarrierBatch barrierBatch;
+				TransitionLayoutBarrier(barrierBatch, cmdBufferStage, newLayout);
+				barrierBatch.Flush(cmdBuffer);
 			}
 
 			/// @brief Copies data from CPU accessible memory to GPU accessible memory.
 			void StageImageData(void* data, VkDeviceSize dataSize) {
-				TinyVkBuffer stagingBuffer = TinyVkBuffer(renderContext, dataSize, TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING);
+				TinyVkBuffer* stagingBuffer = new TinyVkBuffer(renderContext, dataSize, TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING);
 				
-				memcpy(stagingBuffer.description.pMappedData, data, (size_t)dataSize);
+				memcpy(stagingBuffer->description.pMappedData, data, (size_t)dataSize);
 				TransitionLayoutCmd(TinyVkImageLayout::TINYVK_TRANSFER_DST);
-				TransferFromBufferCmd(stagingBuffer);
+				TransferFromBufferCmd(*stagingBuffer);
 				TransitionLayoutCmd(TinyVkImageLayout::TINYVK_COLOR_ATTACHMENT);
 
-				stagingBuffer.Dispose();
+				renderContext.vkdevice.RetireResource(stagingBuffer->lastUse, [stagingBuffer]() { delete stagingBuffer; });
 			}
 
 			/// @brief Copies data from the source TinyVkBuffer into this TinyVkImage.
 			void TransferFromBufferCmd(TinyVkBuffer& srcBuffer) {
+				std::vector<TinyVkSemaphoreWait> waits;
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, lastUse);
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, srcBuffer.lastUse, VK_PIPELINE_STAGE_2_TRANSFER_BIT);
 				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = BeginTransferCmd();
 
 				TransitionLayoutBarrier(bufferIndexPair.first, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN_TO_END, imageLayout);
@@ -426,12 +510,16 @@
 					.imageOffset = { 0, 0, 0 }, .imageExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 }
 				};
 				vkCmdCopyBufferToImage(bufferIndexPair.first, srcBuffer.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+				if (srcBuffer.bufferType == TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING) TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_BYTES_UPLOADED, srcBuffer.size);
 
-				EndTransferCmd(bufferIndexPair);
+				srcBuffer.lastUse = EndTransferCmd(bufferIndexPair, waits);
 			}
 
 			/// @brief Copies data from the source TinyVkBuffer into this TinyVkImage.
 			void TransferFromBufferCmdExt(TinyVkBuffer& srcBuffer, VkExtent2D size, VkOffset2D offset) {
+				std::vector<TinyVkSemaphoreWait> waits;
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, lastUse);
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, srcBuffer.lastUse, VK_PIPELINE_STAGE_2_TRANSFER_BIT);
 				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = BeginTransferCmd();
 
 				TransitionLayoutBarrier(bufferIndexPair.first, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN_TO_END, imageLayout);
@@ -443,12 +531,16 @@
 					.imageOffset = { static_cast<int32_t>(offset.x), static_cast<int32_t>(offset.y), 0 }
 				};
 				vkCmdCopyBufferToImage(bufferIndexPair.first, srcBuffer.buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+				if (srcBuffer.bufferType == TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING) TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_BYTES_UPLOADED, srcBuffer.size);
 
-				EndTransferCmd(bufferIndexPair);
+				srcBuffer.lastUse = EndTransferCmd(bufferIndexPair, waits);
 			}
 			
 			/// @brief Copies data from this TinyVkImage into the destination TinyVkBuffer
 			void TransferToBufferCmd(TinyVkBuffer& dstBuffer) {
+				std::vector<TinyVkSemaphoreWait> waits;
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, lastUse);
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, dstBuffer.lastUse, VK_PIPELINE_STAGE_2_TRANSFER_BIT);
 				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = BeginTransferCmd();
 
 				TransitionLayoutBarrier(bufferIndexPair.first, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN_TO_END, imageLayout);
@@ -459,12 +551,16 @@
 					.imageOffset = { 0, 0, 0 }, .imageExtent = { static_cast<uint32_t>(width), static_cast<uint32_t>(height), 1 }
 				};
 				vkCmdCopyImageToBuffer(bufferIndexPair.first, image, (VkImageLayout) imageLayout, dstBuffer.buffer, 1, &region);
+				if (dstBuffer.bufferType == TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING) TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_BYTES_READ_BACK, dstBuffer.size);
 
-				EndTransferCmd(bufferIndexPair);
+				dstBuffer.lastUse = EndTransferCmd(bufferIndexPair, waits);
 			}
 
 			/// @brief Copies data from this TinyVkImage into the destination TinyVkBuffer
 			void TransferToBufferCmdExt(TinyVkBuffer& dstBuffer, VkExtent2D size, VkOffset2D offset) {
+				std::vector<TinyVkSemaphoreWait> waits;
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, lastUse);
+				renderContext.vkdevice.GetGraphicsTimeline().AddWait(waits, dstBuffer.lastUse, VK_PIPELINE_STAGE_2_TRANSFER_BIT);
 				std::pair<VkCommandBuffer, int32_t> bufferIndexPair = BeginTransferCmd();
 
 				TransitionLayoutBarrier(bufferIndexPair.first, TinyVkCmdBufferSubmitStage::TINYVK_BEGIN_TO_END, imageLayout);
@@ -479,8 +575,9 @@
 				region.imageExtent = { static_cast<uint32_t>(size.width), static_cast<uint32_t>(size.height), 1 };
 				region.imageOffset = { static_cast<int32_t>(offset.x), static_cast<int32_t>(offset.y), 0 };
 				vkCmdCopyImageToBuffer(bufferIndexPair.first, image, (VkImageLayout) imageLayout, dstBuffer.buffer, 1, &region);
+				if (dstBuffer.bufferType == TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING) TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_BYTES_READ_BACK, dstBuffer.size);
 
-				EndTransferCmd(bufferIndexPair);
+				dstBuffer.lastUse = EndTransferCmd(bufferIndexPair, waits);
 			}
 
 			/// @brief Copies data from this TinyVkImage into the destination TinyVkBuffer
@@ -488,9 +585,10 @@
 				if (srcImage.format != dstImage.format)
 					throw TinyVkRuntimeError("TinyVulkan: Tried to copy [SOURCE] image to [DESTINATION] image with different VkImageFormat!");
 				
-				TinyVkBuffer buffer(renderContext, dataSize, TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING);
-				srcImage.TransferToBufferCmd(buffer);
-				dstImage.TransferFromBufferCmd(buffer);
+				TinyVkBuffer* buffer = new TinyVkBuffer(renderContext, dataSize, TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING);
+				srcImage.TransferToBufferCmd(*buffer);
+				dstImage.TransferFromBufferCmd(*buffer);
+				renderContext.vkdevice.RetireResource(buffer->lastUse, [buffer]() { delete buffer; });
 			}
 
 			/// @brief Copies data from this TinyVkImage into the destination TinyVkBuffer
@@ -498,9 +596,10 @@
 				if (srcImage.format != dstImage.format)
 					throw TinyVkRuntimeError("TinyVulkan: Tried to copy [SOURCE] image to [DESTINATION] image with different VkImageFormat!");
 				
-				TinyVkBuffer buffer(renderContext, dataSize, TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING);
-				srcImage.TransferToBufferCmdExt(buffer, size, srcOffset);
-				dstImage.TransferFromBufferCmdExt(buffer, size, dstOffset);
+				TinyVkBuffer* buffer = new TinyVkBuffer(renderContext, dataSize, TinyVkBufferType::TINYVK_BUFFER_TYPE_STAGING);
+				srcImage.TransferToBufferCmdExt(*buffer, size, srcOffset);
+				dstImage.TransferFromBufferCmdExt(*buffer, size, dstOffset);
+				renderContext.vkdevice.RetireResource(buffer->lastUse, [buffer]() { delete buffer; });
 			}
 			
 			#pragma endregion
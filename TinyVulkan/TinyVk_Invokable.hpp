@@ -78,6 +78,7 @@
 
             /// Execute all registered TinyVkCallbacks, operator ()
             TinyVkInvokable<A...>& invoke(A... args) {
+                TINYVK_TRACE_SCOPE_CATEGORY("TinyVkInvokable::invoke", "tinyvk");
                 timed_guard<false> g(safety_lock);
                 std::vector<TinyVkCallback<A...>> clonecb(TinyVkCallbacks);
                 g.Unlock();
@@ -87,6 +88,7 @@
 
             /// Execute all registered TinyVkCallbacks, operator ()
             TinyVkInvokable<A...>& invoke_blocking(A... args) {
+                TINYVK_TRACE_SCOPE_CATEGORY("TinyVkInvokable::invoke_blocking", "tinyvk");
                 timed_guard<false> g(safety_lock);
                 for (TinyVkCallback<A...> cb : TinyVkCallbacks) cb.invoke(static_cast<A&&>(args)...);
                 return (*this);
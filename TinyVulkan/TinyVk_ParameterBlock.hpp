@@ -0,0 +1,188 @@
+#pragma once
+#ifndef TINYVK_TINYVKPARAMETERBLOCK
+#define TINYVK_TINYVKPARAMETERBLOCK
+	#include "./TinyVulkan.hpp"
+	#include <cstddef>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT PARAMETER BLOCKS:
+				A parameter block types the C++ struct that is passed to a shader's push constants or uniform buffer, so
+				layout mistakes fail to compile instead of rendering garbage:
+					TinyVkPushBlock<T, Stages, Offset>:  push constants (std430), stages/offset/size are part of the type.
+						renderer.PushConstants<CameraPush>(cmd, camera) records vkCmdPushConstants straight from the struct.
+						CameraPush::GetRange() returns the VkPushConstantRange to create the pipeline with.
+					TinyVkUniformBlock<T, Layout>:  uniform buffers (std140 by default), written with one memcpy into
+						the persistently mapped TINYVK_BUFFER_TYPE_UNIFORM buffer. Each block index is one slot of
+						TinyVkUniformBlock::stride bytes (aligned to any minUniformBufferOffsetAlignment), use one slot
+						per frame in flight so the CPU never writes a slot the GPU is still reading.
+
+				The block types assert that T is a plain (trivially copyable, standard layout) struct and that its size
+				and offset are valid. Member offsets can not be reflected in C++, so check each member against the
+				std140/std430 alignment rules with:
+					struct CameraData { glm::mat4 projection; glm::vec4 tint; float time; float pad[3]; };
+					TINYVK_STD140_MEMBER(CameraData, projection); TINYVK_STD140_MEMBER(CameraData, tint); ...
+
+				The GLSL alignment of a struct is the largest alignment of its members (not the C++ alignof), so structs
+				nested in a block must list their members with TINYVK_BLOCK_STRUCT (nesting an unlisted struct fails to
+				compile). Listing the block struct itself also asserts that its size is padded to that alignment:
+					struct Light { glm::vec3 position; float radius; };
+					TINYVK_BLOCK_STRUCT(Light, &Light::position, &Light::radius);
+
+				Member rules (GLSL base alignment N = sizeof(scalar)):
+					Scalars align to N, vec2 to 2N, vec3/vec4 to 4N, bool has no C++ equivalent (use uint32_t).
+					Arrays and matrix columns align to their element and their stride must be a multiple of it.
+					std140 rounds the alignment of arrays, matrix columns and structs up to 16 bytes (vec4), so
+					float[4] or glm::mat3 (12 byte columns) fail std140 and structs must be padded to 16 bytes.
+		*/
+
+		/// @brief Memory layout rules of a shader parameter block (uniform buffers default to std140, push constants use std430).
+		enum class TinyVkBlockLayout {
+			TINYVK_STD140, /// Uniform buffer layout (arrays, matrix columns and structs aligned to 16 bytes).
+			TINYVK_STD430, /// Push constant and storage buffer layout (tightly aligned to their elements).
+		};
+
+		template<TinyVkBlockLayout Layout, typename M>
+		struct TinyVkBlockMember;
+
+		/// @brief Member type of a pointer to a struct member.
+		template<typename P>
+		struct TinyVkBlockMemberPointer;
+
+		template<typename C, typename M>
+		struct TinyVkBlockMemberPointer<M C::*> { using Type = M; };
+
+		/// @brief Members (pointers to members) of a struct used in a parameter block, its alignment is the largest member alignment.
+		template<auto... Members>
+		struct TinyVkBlockMembers {
+			template<TinyVkBlockLayout Layout>
+			static constexpr size_t Alignment() { return std::max({ static_cast<size_t>(1), TinyVkBlockMember<Layout, typename TinyVkBlockMemberPointer<decltype(Members)>::Type>::alignment... }); }
+
+			template<TinyVkBlockLayout Layout>
+			static constexpr bool IsValid() { return (true && ... && TinyVkBlockMember<Layout, typename TinyVkBlockMemberPointer<decltype(Members)>::Type>::isValid); }
+		};
+
+		/// @brief Member list of a struct used in a parameter block, declared with TINYVK_BLOCK_STRUCT.
+		template<typename T>
+		struct TinyVkBlockStruct {
+			static const bool declared = false;
+			using Members = TinyVkBlockMembers<>;
+		};
+
+		/// @brief Lists the members of a struct used in a parameter block (its GLSL alignment is derived from them), e.g. TINYVK_BLOCK_STRUCT(Light, &Light::position, &Light::radius).
+		#define TINYVK_BLOCK_STRUCT(type, ...) template<> struct TINYVULKAN_NAMESPACE::TinyVkBlockStruct<type> { \
+			static const bool declared = true; using Members = TINYVULKAN_NAMESPACE::TinyVkBlockMembers<__VA_ARGS__>; }
+
+		/// @brief Base alignment and stride validity of a C++ type as a member of a std140/std430 parameter block (scalars align to their size, structs to their largest member).
+		template<TinyVkBlockLayout Layout, typename M>
+		struct TinyVkBlockMember {
+			static_assert(!std::is_same_v<M, bool>, "TinyVulkan: bool has no shader block layout (GLSL bool is 4 bytes), use uint32_t!");
+			static_assert(std::is_arithmetic_v<M> || std::is_class_v<M>, "TinyVulkan: Parameter block members must be scalars, glm vectors/matrices, arrays or structs!");
+			static_assert(std::is_arithmetic_v<M> || TinyVkBlockStruct<M>::declared, "TinyVulkan: Structs nested in parameter blocks must list their members with TINYVK_BLOCK_STRUCT!");
+
+			using Members = typename TinyVkBlockStruct<M>::Members;
+			static const size_t alignment = (std::is_arithmetic_v<M>)? sizeof(M) : (Layout == TinyVkBlockLayout::TINYVK_STD140)? ((Members::template Alignment<Layout>() + 15) / 16) * 16 : Members::template Alignment<Layout>();
+			static const bool isValid = Members::template IsValid<Layout>() && (sizeof(M) % alignment) == 0;
+		};
+
+		/// @brief Glm vectors align to 2N (vec2) or 4N (vec3/vec4).
+		template<TinyVkBlockLayout Layout, glm::length_t L, typename S, glm::qualifier Q>
+		struct TinyVkBlockMember<Layout, glm::vec<L, S, Q>> {
+			static const size_t alignment = ((L == 3)? 4 : L) * sizeof(S);
+			static const bool isValid = true;
+		};
+
+		/// @brief Arrays align to their elements (rounded to 16 bytes in std140) with a stride that is a multiple of that alignment.
+		template<TinyVkBlockLayout Layout, typename E, size_t N>
+		struct TinyVkBlockArray {
+			static const size_t alignment = (Layout == TinyVkBlockLayout::TINYVK_STD140)? ((TinyVkBlockMember<Layout, E>::alignment + 15) / 16) * 16 : TinyVkBlockMember<Layout, E>::alignment;
+			static const bool isValid = TinyVkBlockMember<Layout, E>::isValid && (sizeof(E) % alignment) == 0;
+		};
+
+		template<TinyVkBlockLayout Layout, typename E, size_t N>
+		struct TinyVkBlockMember<Layout, E[N]> : TinyVkBlockArray<Layout, E, N> {};
+
+		/// @brief Glm matrices are arrays of their column vectors.
+		template<TinyVkBlockLayout Layout, glm::length_t C, glm::length_t R, typename S, glm::qualifier Q>
+		struct TinyVkBlockMember<Layout, glm::mat<C, R, S, Q>> : TinyVkBlockArray<Layout, glm::vec<R, S, Q>, static_cast<size_t>(C)> {};
+
+		/// @brief Returns true if a parameter block member of type M at the byte offset follows the layout's alignment rules.
+		template<TinyVkBlockLayout Layout, typename M>
+		constexpr bool TinyVkIsBlockMemberAligned(size_t offset) {
+			return TinyVkBlockMember<Layout, M>::isValid && (offset % TinyVkBlockMember<Layout, M>::alignment) == 0;
+		}
+
+		/// @brief Returns true if the block struct is padded to its layout alignment and the offset is aligned (always true if T has no TINYVK_BLOCK_STRUCT member list).
+		template<TinyVkBlockLayout Layout, typename T>
+		constexpr bool TinyVkIsBlockPadded(size_t offset = 0) {
+			if constexpr (TinyVkBlockStruct<T>::declared) {
+				return TinyVkBlockMember<Layout, T>::isValid && (offset % TinyVkBlockMember<Layout, T>::alignment) == 0;
+			} else return true;
+		}
+
+		/// @brief Compile-time check of a parameter block struct member against the std140 (uniform buffer) rules.
+		#define TINYVK_STD140_MEMBER(type, member) static_assert(TINYVULKAN_NAMESPACE::TinyVkIsBlockMemberAligned<TINYVULKAN_NAMESPACE::TinyVkBlockLayout::TINYVK_STD140, decltype(type::member)>(offsetof(type, member)), \
+			"TinyVulkan: " #type "::" #member " breaks the std140 layout (misaligned offset, vec3/mat3 padding or array stride)!")
+
+		/// @brief Compile-time check of a parameter block struct member against the std430 (push constant/storage buffer) rules.
+		#define TINYVK_STD430_MEMBER(type, member) static_assert(TINYVULKAN_NAMESPACE::TinyVkIsBlockMemberAligned<TINYVULKAN_NAMESPACE::TinyVkBlockLayout::TINYVK_STD430, decltype(type::member)>(offsetof(type, member)), \
+			"TinyVulkan: " #type "::" #member " breaks the std430 layout (misaligned offset, vec3/mat3 padding or array stride)!")
+
+		/// @brief Typed push constant block: the struct T pushed to the shader stages at a byte offset (std430).
+		template<typename T, VkShaderStageFlags Stages, uint32_t Offset = 0>
+		class TinyVkPushBlock {
+			static_assert(std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>, "TinyVulkan: Push constant blocks must be plain structs (trivially copyable, standard layout)!");
+			static_assert(Stages != 0, "TinyVulkan: Push constant blocks need at least one shader stage!");
+			static_assert(Offset % 4 == 0 && sizeof(T) % 4 == 0, "TinyVulkan: Push constant offset and size must be multiples of 4 bytes!");
+			static_assert(Offset + sizeof(T) <= 128, "TinyVulkan: Push constant blocks past 128 bytes are not guaranteed by maxPushConstantsSize!");
+			static_assert(TinyVkIsBlockPadded<TinyVkBlockLayout::TINYVK_STD430, T>(Offset), "TinyVulkan: Push constant block is not padded/aligned for std430!");
+
+		public:
+			using BlockType = T;
+			inline static const VkShaderStageFlags stageFlags = Stages;
+			inline static const uint32_t offset = Offset;
+			inline static const uint32_t size = static_cast<uint32_t>(sizeof(T));
+
+			/// @brief Returns the push constant range of this block for creating the pipeline layout.
+			static VkPushConstantRange GetRange() { return { Stages, Offset, size }; }
+
+			/// @brief Returns true if every stage of this block is declared by a push constant range covering its bytes.
+			static bool IsDeclaredIn(const std::vector<VkPushConstantRange>& pushConstantRanges) {
+				VkShaderStageFlags declaredStages = 0;
+				for(const VkPushConstantRange& range : pushConstantRanges)
+					if (range.offset <= Offset && Offset + size <= range.offset + range.size) declaredStages |= range.stageFlags;
+				return (declaredStages & Stages) == Stages;
+			}
+
+			/// @brief Records the block to the command buffer with vkCmdPushConstants (no intermediate copy).
+			static void CmdPush(VkCommandBuffer cmdBuffer, VkPipelineLayout pipelineLayout, const T& value) {
+				vkCmdPushConstants(cmdBuffer, pipelineLayout, Stages, Offset, size, &value);
+			}
+		};
+
+		/// @brief Typed uniform buffer block: the struct T written into slots of a mapped TINYVK_BUFFER_TYPE_UNIFORM buffer (std140 by default).
+		template<typename T, TinyVkBlockLayout Layout = TinyVkBlockLayout::TINYVK_STD140>
+		class TinyVkUniformBlock {
+			static_assert(std::is_trivially_copyable_v<T> && std::is_standard_layout_v<T>, "TinyVulkan: Uniform blocks must be plain structs (trivially copyable, standard layout)!");
+			static_assert(TinyVkIsBlockPadded<Layout, T>(), "TinyVulkan: Uniform block is not padded to its layout alignment (std140 structs pad to 16 bytes)!");
+
+		public:
+			using BlockType = T;
+			inline static const VkDeviceSize size = sizeof(T);
+			inline static const VkDeviceSize stride = ((sizeof(T) + 255) / 256) * 256; /// Slot stride, 256 bytes is the largest minUniformBufferOffsetAlignment allowed by Vulkan.
+
+			/// @brief Returns the uniform buffer size for a number of block slots (e.g. one per frame in flight).
+			static VkDeviceSize GetBufferSize(uint32_t slotCount = 1) { return stride * slotCount; }
+
+			/// @brief Writes the block into a slot of the mapped uniform buffer (single memcpy), the slot must not be read by pending GPU work.
+			static void Write(TinyVkBuffer& buffer, const T& value, uint32_t slot = 0) {
+				buffer.WriteMappedData(&value, size, stride * slot);
+			}
+
+			/// @brief Returns the buffer descriptor of a slot for SelectWriteBufferDescriptor/PushDescriptorTemplate.
+			static VkDescriptorBufferInfo GetBufferDescriptor(TinyVkBuffer& buffer, uint32_t slot = 0) {
+				return buffer.GetBufferDescriptor(stride * slot, size);
+			}
+		};
+	}
+#endif
@@ -0,0 +1,204 @@
+#pragma once
+#ifndef TINYVK_TINYVKPIPELINECOMPILER
+#define TINYVK_TINYVKPIPELINECOMPILER
+	#include "./TinyVulkan.hpp"
+	#include <condition_variable>
+	#include <deque>
+	#include <memory>
+	#include <mutex>
+	#include <thread>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT BACKGROUND PIPELINE COMPILATION:
+				TinyVkPipelineCompiler is a pool of worker threads which runs pipeline creation jobs (shader file I/O, shader
+				modules and vkCreateGraphicsPipelines/vkCreateComputePipelines) off the calling thread. Jobs run concurrently
+				against the device's shared VkPipelineCache (pipeline creation does not require external synchronization of
+				the cache). Requests return a TinyVkPipelineHandle immediately which becomes ready (or failed) once its job ran:
+					TinyVkGraphicsPipeline::RequestVariant(variant, &compiler)
+					TinyVkGraphicsRenderer::CmdBindPipelineVariantAsync(cmd, variant, compiler, fallback)
+					TinyVkComputeRenderer(..., &compiler) (ComputeExecute() returns VK_NOT_READY until compiled)
+
+				Handles do not own their VkPipeline, it is owned (and destroyed) by the graphics pipeline/compute renderer which
+				requested it. Pipelines/compute renderers wait for their own pending jobs before they are disposed and disposing
+				the compiler finishes every queued job before joining its threads, so either may be disposed first.
+		*/
+
+		enum class TinyVkPipelineStatus {
+			TINYVK_PIPELINE_PENDING,
+			TINYVK_PIPELINE_READY,
+			TINYVK_PIPELINE_FAILED
+		};
+
+		/// @brief Completion state shared between a TinyVkPipelineHandle and the job compiling its pipeline.
+		struct TinyVkPipelineState {
+			std::atomic<TinyVkPipelineStatus> status = TinyVkPipelineStatus::TINYVK_PIPELINE_PENDING;
+			VkPipeline pipeline = VK_NULL_HANDLE; /// Written before status is released.
+			std::string error; /// Written before status is released.
+			std::mutex wait_lock;
+			std::condition_variable waitSignal;
+		};
+
+		/// @brief Handle to a pipeline which becomes ready later (copyable, does not own the VkPipeline).
+		class TinyVkPipelineHandle {
+		private:
+			std::shared_ptr<TinyVkPipelineState> state;
+
+			void Complete(TinyVkPipelineStatus status, VkPipeline pipeline, const std::string& error) const {
+				{
+					std::lock_guard<std::mutex> waitLock(state->wait_lock);
+					state->pipeline = pipeline;
+					state->error = error;
+					state->status.store(status, std::memory_order_release);
+				}
+				state->waitSignal.notify_all();
+			}
+
+		public:
+			TinyVkPipelineHandle() = default;
+
+			/// @brief Creates a pending handle to be completed with Resolve() or Fail().
+			static TinyVkPipelineHandle Pending() {
+				TinyVkPipelineHandle handle;
+				handle.state = std::make_shared<TinyVkPipelineState>();
+				return handle;
+			}
+
+			/// @brief Creates an already compiled handle.
+			static TinyVkPipelineHandle Ready(VkPipeline pipeline) {
+				TinyVkPipelineHandle handle = Pending();
+				handle.state->pipeline = pipeline;
+				handle.state->status.store(TinyVkPipelineStatus::TINYVK_PIPELINE_READY, std::memory_order_release);
+				return handle;
+			}
+
+			/// @brief Completes the handle with its compiled pipeline (called by the compiling thread).
+			void Resolve(VkPipeline pipeline) const { Complete(TinyVkPipelineStatus::TINYVK_PIPELINE_READY, pipeline, ""); }
+
+			/// @brief Completes the handle with the error of a failed compile (called by the compiling thread).
+			void Fail(const std::string& error) const { Complete(TinyVkPipelineStatus::TINYVK_PIPELINE_FAILED, VK_NULL_HANDLE, error); }
+
+			/// @brief Returns true if this handle was created from a request (default constructed handles are invalid).
+			bool IsValid() const { return state != nullptr; }
+
+			TinyVkPipelineStatus GetStatus() const {
+				if (state == nullptr) return TinyVkPipelineStatus::TINYVK_PIPELINE_FAILED;
+				return state->status.load(std::memory_order_acquire);
+			}
+
+			bool IsPending() const { return GetStatus() == TinyVkPipelineStatus::TINYVK_PIPELINE_PENDING; }
+			bool IsReady() const { return GetStatus() == TinyVkPipelineStatus::TINYVK_PIPELINE_READY; }
+			bool IsFailed() const { return GetStatus() == TinyVkPipelineStatus::TINYVK_PIPELINE_FAILED; }
+
+			/// @brief Returns the compiled pipeline or VK_NULL_HANDLE if still pending/failed (never blocks).
+			VkPipeline Get() const { return (IsReady())? state->pipeline : VK_NULL_HANDLE; }
+
+			/// @brief Returns the error message of a failed compile.
+			std::string GetError() const {
+				if (state == nullptr) return "TinyVulkan: Invalid pipeline handle!";
+				return (IsFailed())? state->error : "";
+			}
+
+			/// @brief Blocks until the pipeline is compiled, returns VK_NULL_HANDLE if compilation failed.
+			VkPipeline Wait() const {
+				if (state == nullptr) return VK_NULL_HANDLE;
+				if (IsPending()) {
+					TINYVK_TRACE_SCOPE_CATEGORY("TinyVkPipelineHandle::Wait", "tinyvk");
+					std::unique_lock<std::mutex> waitLock(state->wait_lock);
+					state->waitSignal.wait(waitLock, [this]() { return !IsPending(); });
+				}
+				return Get();
+			}
+		};
+
+		/// @brief Worker thread pool for compiling pipelines in the background.
+		class TinyVkPipelineCompiler : public TinyVkDisposable {
+		private:
+			std::vector<std::thread> workers;
+			std::deque<std::function<void()>> jobs;
+			std::mutex job_lock;
+			std::condition_variable jobSignal;
+			std::condition_variable idleSignal;
+			size_t activeJobs = 0;
+			bool stopping = false;
+
+			void WorkerLoop() {
+				while(true) {
+					std::function<void()> job;
+					{
+						std::unique_lock<std::mutex> jobLock(job_lock);
+						jobSignal.wait(jobLock, [this]() { return stopping || !jobs.empty(); });
+						if (jobs.empty()) return;
+
+						job = std::move(jobs.front());
+						jobs.pop_front();
+						activeJobs ++;
+					}
+
+					job();
+
+					{
+						std::lock_guard<std::mutex> jobLock(job_lock);
+						activeJobs --;
+						if (jobs.empty() && activeJobs == 0) idleSignal.notify_all();
+					}
+				}
+			}
+
+		public:
+			TinyVkPipelineCompiler operator=(const TinyVkPipelineCompiler& compiler) = delete;
+
+			~TinyVkPipelineCompiler() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				{
+					std::lock_guard<std::mutex> jobLock(job_lock);
+					stopping = true;
+				}
+				jobSignal.notify_all();
+
+				for(std::thread& worker : workers)
+					if (worker.joinable()) worker.join();
+				workers.clear();
+			}
+
+			/// @brief Creates the worker threads, threadCount of 0 uses every core but the calling thread's (at least one).
+			TinyVkPipelineCompiler(uint32_t threadCount = 0) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				if (threadCount == 0) {
+					uint32_t cores = std::thread::hardware_concurrency();
+					threadCount = (cores > 1)? cores - 1 : 1;
+				}
+
+				for(uint32_t i = 0; i < threadCount; i++)
+					workers.emplace_back([this]() { this->WorkerLoop(); });
+			}
+
+			/// @brief Queues a job to run on a worker thread (jobs must not throw, complete a TinyVkPipelineHandle instead).
+			void Enqueue(std::function<void()> job) {
+				{
+					std::lock_guard<std::mutex> jobLock(job_lock);
+					if (stopping) throw TinyVkRuntimeError("TinyVulkan: Tried to queue a pipeline compile on a disposed TinyVkPipelineCompiler!");
+					jobs.push_back(std::move(job));
+				}
+				jobSignal.notify_one();
+			}
+
+			/// @brief Blocks until every queued job has finished (e.g. at the end of a loading screen).
+			void WaitIdle() {
+				TINYVK_TRACE_SCOPE_CATEGORY("TinyVkPipelineCompiler::WaitIdle", "tinyvk");
+				std::unique_lock<std::mutex> jobLock(job_lock);
+				idleSignal.wait(jobLock, [this]() { return jobs.empty() && activeJobs == 0; });
+			}
+
+			/// @brief Returns the number of queued and running jobs.
+			size_t GetPendingCount() {
+				std::lock_guard<std::mutex> jobLock(job_lock);
+				return jobs.size() + activeJobs;
+			}
+
+			size_t GetThreadCount() { return workers.size(); }
+		};
+	}
+#endif
@@ -0,0 +1,470 @@
+#pragma once
+#ifndef TINYVK_TINYVKPIPELINEQUERIES
+#define TINYVK_TINYVKPIPELINEQUERIES
+	#include "./TinyVulkan.hpp"
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT PIPELINE QUERIES:
+				TinyVkPipelineQueries records named pipeline statistics scopes (VK_QUERY_TYPE_PIPELINE_STATISTICS: input
+				assembly vertices/primitives, vertex/fragment/compute shader invocations, clipping invocations/primitives)
+				and occlusion scopes (samples passed). Like the TinyVkGpuProfiler the query pools are split into one range
+				per in-flight frame, results are read back without stalling once the frame's submissions complete and are
+				aggregated per scope name:
+
+					queries.BeginFrame();		// Collects every completed frame, selects the next query range.
+					...record & submit...		// Scopes recorded by the renderers or Begin/End*() calls.
+					queries.EndFrame();			// Marks the frame's submissions (graphics/compute timelines).
+
+				Only one query of each type may be active in a command buffer at a time (nested scopes of the same type
+				are dropped). Occlusion scopes that are meant to drive rendering on the GPU are copied into a predicate
+				buffer with ResolveOcclusion(cmd) (outside of dynamic rendering, after the scopes ended in the same command
+				buffer), later draws are wrapped in BeginConditional(cmd, name)/EndConditional(cmd) which uses
+				vkCmdBeginConditionalRenderingEXT on the most recent resolved result of that scope (this frame or an older
+				one). If VK_EXT_conditional_rendering is unavailable BeginConditional() returns false and draws always execute.
+
+				Renderers record their own statistics scopes when given a TinyVkPipelineQueries: TinyVkRenderContext.pipelineQueries
+				(graphics/swapchain renderers) and TinyVkComputeRenderer.pipelineQueries (compute renderer).
+		*/
+
+		/// @brief Query types recorded by TinyVkPipelineQueries (compute statistics are used for separate compute queue families).
+		enum class TinyVkQueryType {
+			TINYVK_QUERY_GRAPHICS_STATISTICS = 0,
+			TINYVK_QUERY_COMPUTE_STATISTICS = 1,
+			TINYVK_QUERY_OCCLUSION = 2
+		};
+
+		/// @brief Pipeline statistics counters of a single query result.
+		struct TinyVkPipelineCounters {
+			uint64_t inputAssemblyVertices = 0, inputAssemblyPrimitives = 0, vertexShaderInvocations = 0;
+			uint64_t clippingInvocations = 0, clippingPrimitives = 0, fragmentShaderInvocations = 0, computeShaderInvocations = 0;
+		};
+
+		/// @brief Aggregated pipeline statistics of a named query scope.
+		struct TinyVkPipelineStatistics {
+			std::string name;
+			size_t count = 0;
+			TinyVkPipelineCounters last, total;
+
+			/// @brief Adds a single query result to the scope statistics.
+			void Record(const TinyVkPipelineCounters& counters) {
+				last = counters;
+				total.inputAssemblyVertices += counters.inputAssemblyVertices;
+				total.inputAssemblyPrimitives += counters.inputAssemblyPrimitives;
+				total.vertexShaderInvocations += counters.vertexShaderInvocations;
+				total.clippingInvocations += counters.clippingInvocations;
+				total.clippingPrimitives += counters.clippingPrimitives;
+				total.fragmentShaderInvocations += counters.fragmentShaderInvocations;
+				total.computeShaderInvocations += counters.computeShaderInvocations;
+				count ++;
+			}
+
+			/// @brief Returns the average fragment shader invocations per pixel of a width*height target (overdraw) of the last result.
+			double Overdraw(uint32_t width, uint32_t height) const {
+				return (width * height > 0)? static_cast<double>(last.fragmentShaderInvocations) / (static_cast<double>(width) * static_cast<double>(height)) : 0.0;
+			}
+		};
+
+		/// @brief Aggregated occlusion results (samples passed) of a named query scope.
+		struct TinyVkOcclusionResult {
+			std::string name;
+			size_t count = 0, visibleCount = 0;
+			uint64_t lastSamples = 0;
+
+			/// @brief Returns true if any sample passed in the last result.
+			bool IsVisible() const { return lastSamples > 0; }
+
+			/// @brief Adds a single query result to the scope results.
+			void Record(uint64_t samples) {
+				lastSamples = samples;
+				if (samples > 0) visibleCount ++;
+				count ++;
+			}
+		};
+
+		/// @brief Pipeline statistics/occlusion query scopes with asynchronous readback and occlusion driven conditional rendering.
+		class TinyVkPipelineQueries : public TinyVkDisposable {
+		private:
+			static constexpr size_t queryTypeCount = 3;
+
+			struct TinyVkQueryScope {
+				std::string name;
+				uint32_t query;
+				VkCommandBuffer commandBuffer;
+			};
+
+			struct TinyVkQueryFrame {
+				bool pending = false;
+				size_t frameNumber = 0;
+				std::array<uint32_t, queryTypeCount> firstQuery {}, queryCount {};
+				std::array<std::vector<TinyVkQueryScope>, queryTypeCount> scopes;
+				std::vector<TinyVkQueryScope> resolvedOcclusion;
+				std::vector<TinyVkTimelinePoint> submissions;
+			};
+
+			/// Open query: command buffer, query type, the frame's scope index and query (UINT32_MAX if dropped).
+			struct TinyVkOpenQuery {
+				VkCommandBuffer commandBuffer;
+				TinyVkQueryType type;
+				uint32_t scope;
+				uint32_t query;
+			};
+
+			std::timed_mutex query_lock;
+			std::array<VkQueryPool, queryTypeCount> queryPools { VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE };
+			std::array<uint32_t, queryTypeCount> resultCounts { 7, 1, 1 };
+			std::vector<TinyVkQueryFrame> frames;
+			std::vector<TinyVkOpenQuery> openQueries;
+			std::vector<std::pair<VkCommandBuffer, bool>> openConditions;
+			std::vector<TinyVkPipelineStatistics> statistics;
+			std::vector<TinyVkOcclusionResult> occlusionResults;
+			VkBuffer predicateBuffer = VK_NULL_HANDLE;
+			VmaAllocation predicateMemory = VK_NULL_HANDLE;
+			uint32_t queriesPerFrame;
+			size_t currentFrame = 0;
+			bool recording = false;
+			bool separateComputeFamily = false;
+			bool preciseOcclusion = false;
+			size_t droppedFrames = 0, droppedScopes = 0;
+
+			/// @brief Creates and host resets a query pool for every in-flight frame's query range.
+			VkQueryPool CreateQueryPool(VkQueryType queryType, VkQueryPipelineStatisticFlags statisticFlags) {
+				VkQueryPoolCreateInfo queryPoolInfo {};
+				queryPoolInfo.sType = VK_STRUCTURE_TYPE_QUERY_POOL_CREATE_INFO;
+				queryPoolInfo.queryType = queryType;
+				queryPoolInfo.queryCount = queriesPerFrame * static_cast<uint32_t>(frames.size());
+				queryPoolInfo.pipelineStatistics = statisticFlags;
+
+				VkQueryPool queryPool = VK_NULL_HANDLE;
+				if (vkCreateQueryPool(vkdevice.GetLogicalDevice(), &queryPoolInfo, VK_NULL_HANDLE, &queryPool) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to create pipeline statistics/occlusion query pool!");
+				vkResetQueryPool(vkdevice.GetLogicalDevice(), queryPool, 0, queryPoolInfo.queryCount);
+				return queryPool;
+			}
+
+			/// @brief Creates the device local predicate buffer occlusion results are copied into for conditional rendering.
+			void CreatePredicateBuffer() {
+				VkBufferCreateInfo bufCreateInfo = { VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO };
+				bufCreateInfo.size = sizeof(uint32_t) * queriesPerFrame * frames.size();
+				bufCreateInfo.usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_CONDITIONAL_RENDERING_BIT_EXT;
+
+				VmaAllocationCreateInfo allocCreateInfo {};
+				allocCreateInfo.usage = VMA_MEMORY_USAGE_AUTO_PREFER_DEVICE;
+
+				if (vmaCreateBuffer(vkdevice.GetAllocator(), &bufCreateInfo, &allocCreateInfo, &predicateBuffer, &predicateMemory, VK_NULL_HANDLE) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Could not allocate memory for conditional rendering predicate buffer!");
+			}
+
+			/// @brief Returns the Vulkan query type of a TinyVkQueryType (statistics scopes of both kinds may not be active at once).
+			static VkQueryType GetVkQueryType(TinyVkQueryType type) {
+				return (type == TinyVkQueryType::TINYVK_QUERY_OCCLUSION)? VK_QUERY_TYPE_OCCLUSION : VK_QUERY_TYPE_PIPELINE_STATISTICS;
+			}
+
+			/// @brief Reads back and resets a frame's queries if all of its submissions completed (query_lock must be held).
+			bool CollectFrame(TinyVkQueryFrame& frame) {
+				if (!frame.pending) return true;
+
+				for(TinyVkTimelinePoint& submission : frame.submissions)
+					if (!submission.IsComplete()) return false;
+
+				for(size_t type = 0; type < queryTypeCount; type++) {
+					if (queryPools[type] == VK_NULL_HANDLE) continue;
+
+					// Result values followed by availability: scopes recorded into never submitted command buffers stay unavailable.
+					const size_t stride = resultCounts[type] + 1;
+					std::vector<uint64_t> results(static_cast<size_t>(frame.queryCount[type]) * stride, 0);
+					if (frame.queryCount[type] > 0)
+						vkGetQueryPoolResults(vkdevice.GetLogicalDevice(), queryPools[type], frame.firstQuery[type], frame.queryCount[type], results.size() * sizeof(uint64_t), results.data(),
+							stride * sizeof(uint64_t), VK_QUERY_RESULT_64_BIT | VK_QUERY_RESULT_WITH_AVAILABILITY_BIT);
+
+					for(TinyVkQueryScope& scope : frame.scopes[type]) {
+						const uint64_t* result = &results[static_cast<size_t>(scope.query - frame.firstQuery[type]) * stride];
+						if (result[resultCounts[type]] == 0) { droppedScopes ++; continue; }
+
+						if (static_cast<TinyVkQueryType>(type) == TinyVkQueryType::TINYVK_QUERY_OCCLUSION) {
+							auto occlusion = std::find_if(occlusionResults.begin(), occlusionResults.end(), [&scope](TinyVkOcclusionResult& r) { return r.name == scope.name; });
+							if (occlusion == occlusionResults.end()) {
+								occlusionResults.push_back(TinyVkOcclusionResult { .name = scope.name });
+								occlusion = occlusionResults.end() - 1;
+							}
+							occlusion->Record(result[0]);
+							continue;
+						}
+
+						TinyVkPipelineCounters counters {};
+						if (static_cast<TinyVkQueryType>(type) == TinyVkQueryType::TINYVK_QUERY_GRAPHICS_STATISTICS) {
+							counters = { result[0], result[1], result[2], result[3], result[4], result[5], result[6] };
+						} else counters.computeShaderInvocations = result[0];
+
+						auto stats = std::find_if(statistics.begin(), statistics.end(), [&scope](TinyVkPipelineStatistics& s) { return s.name == scope.name; });
+						if (stats == statistics.end()) {
+							statistics.push_back(TinyVkPipelineStatistics { .name = scope.name });
+							stats = statistics.end() - 1;
+						}
+						stats->Record(counters);
+					}
+
+					vkResetQueryPool(vkdevice.GetLogicalDevice(), queryPools[type], frame.firstQuery[type], queriesPerFrame);
+					frame.queryCount[type] = 0;
+					frame.scopes[type].clear();
+				}
+
+				frame.pending = false;
+				frame.submissions.clear();
+				return true;
+			}
+
+			/// @brief Begins a query of the type in the current frame's range (dropped if not recording, full or a query of the same type is active).
+			void BeginQuery(VkCommandBuffer commandBuffer, const std::string& name, TinyVkQueryType type) {
+				timed_guard<false> queryLock(query_lock);
+				TinyVkOpenQuery openQuery { commandBuffer, type, UINT32_MAX, UINT32_MAX };
+				const size_t typeIndex = static_cast<size_t>(type);
+
+				bool active = std::any_of(openQueries.begin(), openQueries.end(), [commandBuffer, type](TinyVkOpenQuery& query) {
+					return query.commandBuffer == commandBuffer && query.query != UINT32_MAX && GetVkQueryType(query.type) == GetVkQueryType(type);
+				});
+
+				if (recording && queryPools[typeIndex] != VK_NULL_HANDLE) {
+					TinyVkQueryFrame& frame = frames[currentFrame % frames.size()];
+					if (!active && frame.queryCount[typeIndex] < queriesPerFrame) {
+						openQuery.query = frame.firstQuery[typeIndex] + frame.queryCount[typeIndex];
+						openQuery.scope = static_cast<uint32_t>(frame.scopes[typeIndex].size());
+						frame.queryCount[typeIndex] ++;
+						frame.scopes[typeIndex].push_back({ name, openQuery.query, commandBuffer });
+
+						VkQueryControlFlags controlFlags = (type == TinyVkQueryType::TINYVK_QUERY_OCCLUSION && preciseOcclusion)? VK_QUERY_CONTROL_PRECISE_BIT : 0;
+						vkCmdBeginQuery(commandBuffer, queryPools[typeIndex], openQuery.query, controlFlags);
+					} else droppedScopes ++;
+				}
+
+				openQueries.push_back(openQuery);
+			}
+
+			/// @brief Ends the innermost open query of the type in the command buffer.
+			void EndQuery(VkCommandBuffer commandBuffer, TinyVkQueryType type) {
+				timed_guard<false> queryLock(query_lock);
+				auto openQuery = std::find_if(openQueries.rbegin(), openQueries.rend(), [commandBuffer, type](TinyVkOpenQuery& query) { return query.commandBuffer == commandBuffer && query.type == type; });
+				if (openQuery == openQueries.rend()) return;
+
+				TinyVkOpenQuery query = *openQuery;
+				openQueries.erase(std::next(openQuery).base());
+				if (query.query != UINT32_MAX) vkCmdEndQuery(commandBuffer, queryPools[static_cast<size_t>(type)], query.query);
+			}
+
+		public:
+			TinyVkVulkanDevice& vkdevice;
+
+			/// @brief Deleted copy constructor (dynamic objects are not copyable).
+			TinyVkPipelineQueries operator=(const TinyVkPipelineQueries& queries) = delete;
+
+			~TinyVkPipelineQueries() { this->Dispose(); }
+
+			/// @brief Waits on the submissions of frames still in flight and destroys the query pools and predicate buffer.
+			void Disposable(bool waitIdle) {
+				for(TinyVkQueryFrame& frame : frames)
+					for(TinyVkTimelinePoint& submission : frame.submissions) submission.Wait(UINT64_MAX, "TinyVkPipelineQueries::Disposable");
+
+				for(VkQueryPool queryPool : queryPools)
+					if (queryPool != VK_NULL_HANDLE) vkDestroyQueryPool(vkdevice.GetLogicalDevice(), queryPool, VK_NULL_HANDLE);
+
+				if (predicateBuffer != VK_NULL_HANDLE)
+					vmaDestroyBuffer(vkdevice.GetAllocator(), predicateBuffer, predicateMemory);
+			}
+
+			/// @brief Creates the statistics/occlusion query pools for frameLatency in-flight frames of up to maxScopesPerFrame scopes of each type.
+			/// @param preciseOcclusion Requests exact sample counts (occlusionQueryPrecise) instead of zero/non-zero results.
+			TinyVkPipelineQueries(TinyVkVulkanDevice& vkdevice, size_t frameLatency = 4, uint32_t maxScopesPerFrame = 64, bool preciseOcclusion = false)
+			: vkdevice(vkdevice), queriesPerFrame(std::max(maxScopesPerFrame, 1u)) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+
+				VkPhysicalDeviceFeatures features = vkdevice.GetDeviceFeatures();
+				this->preciseOcclusion = preciseOcclusion && features.occlusionQueryPrecise;
+
+				frames.resize(std::max(frameLatency, static_cast<size_t>(1)));
+				for(size_t i = 0; i < frames.size(); i++)
+					for(size_t type = 0; type < queryTypeCount; type++) frames[i].firstQuery[type] = static_cast<uint32_t>(i) * queriesPerFrame;
+
+				if (features.pipelineStatisticsQuery) {
+					queryPools[static_cast<size_t>(TinyVkQueryType::TINYVK_QUERY_GRAPHICS_STATISTICS)] = CreateQueryPool(VK_QUERY_TYPE_PIPELINE_STATISTICS,
+						VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_VERTICES_BIT | VK_QUERY_PIPELINE_STATISTIC_INPUT_ASSEMBLY_PRIMITIVES_BIT | VK_QUERY_PIPELINE_STATISTIC_VERTEX_SHADER_INVOCATIONS_BIT |
+						VK_QUERY_PIPELINE_STATISTIC_CLIPPING_INVOCATIONS_BIT | VK_QUERY_PIPELINE_STATISTIC_CLIPPING_PRIMITIVES_BIT | VK_QUERY_PIPELINE_STATISTIC_FRAGMENT_SHADER_INVOCATIONS_BIT |
+						VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT);
+
+					// Graphics statistics may only be queried on graphics queues, a separate compute family gets a compute only pool.
+					TinyVkQueueFamily queueFamilies = vkdevice.GetQueueFamilies();
+					separateComputeFamily = queueFamilies.computeFamily != queueFamilies.graphicsFamily;
+					if (separateComputeFamily)
+						queryPools[static_cast<size_t>(TinyVkQueryType::TINYVK_QUERY_COMPUTE_STATISTICS)] = CreateQueryPool(VK_QUERY_TYPE_PIPELINE_STATISTICS, VK_QUERY_PIPELINE_STATISTIC_COMPUTE_SHADER_INVOCATIONS_BIT);
+				}
+				#if TVK_VALIDATION_LAYERS
+				else std::cout << "TinyVulkan: pipelineStatisticsQuery is not supported, TinyVkPipelineQueries only records occlusion queries." << std::endl;
+				#endif
+
+				queryPools[static_cast<size_t>(TinyVkQueryType::TINYVK_QUERY_OCCLUSION)] = CreateQueryPool(VK_QUERY_TYPE_OCCLUSION, 0);
+
+				if (vkdevice.IsDeviceExtensionEnabled(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME))
+					CreatePredicateBuffer();
+			}
+
+			#pragma region FRAME_QUERIES
+
+			/// @brief Collects the results of completed frames and starts querying a new frame (skipped if its query range is still in flight).
+			void BeginFrame() {
+				timed_guard<false> queryLock(query_lock);
+				for(TinyVkQueryFrame& frame : frames) CollectFrame(frame);
+
+				TinyVkQueryFrame& frame = frames[currentFrame % frames.size()];
+				recording = !frame.pending;
+				if (recording) {
+					frame.frameNumber = currentFrame;
+					frame.resolvedOcclusion.clear();
+				} else droppedFrames ++;
+
+				openQueries.clear();
+				openConditions.clear();
+			}
+
+			/// @brief Ends the queried frame: its results are read back once the graphics/compute submissions made so far complete.
+			void EndFrame() {
+				timed_guard<false> queryLock(query_lock);
+				if (recording) {
+					TinyVkQueryFrame& frame = frames[currentFrame % frames.size()];
+					frame.pending = std::any_of(frame.queryCount.begin(), frame.queryCount.end(), [](uint32_t count) { return count > 0; });
+					frame.submissions = { vkdevice.GetGraphicsTimeline().GetSubmittedPoint() };
+					if (&vkdevice.GetComputeTimeline() != &vkdevice.GetGraphicsTimeline())
+						frame.submissions.push_back(vkdevice.GetComputeTimeline().GetSubmittedPoint());
+				}
+
+				recording = false;
+				currentFrame ++;
+			}
+
+			/// @brief Begins a named pipeline statistics scope (set computeQueue for command buffers submitted to the compute queue).
+			void BeginStatistics(VkCommandBuffer commandBuffer, const std::string& name, bool computeQueue = false) {
+				BeginQuery(commandBuffer, name, (computeQueue && separateComputeFamily)? TinyVkQueryType::TINYVK_QUERY_COMPUTE_STATISTICS : TinyVkQueryType::TINYVK_QUERY_GRAPHICS_STATISTICS);
+			}
+
+			/// @brief Ends the open pipeline statistics scope of the command buffer.
+			void EndStatistics(VkCommandBuffer commandBuffer, bool computeQueue = false) {
+				EndQuery(commandBuffer, (computeQueue && separateComputeFamily)? TinyVkQueryType::TINYVK_QUERY_COMPUTE_STATISTICS : TinyVkQueryType::TINYVK_QUERY_GRAPHICS_STATISTICS);
+			}
+
+			/// @brief Begins a named occlusion scope (samples passed by the draws recorded until EndOcclusion).
+			void BeginOcclusion(VkCommandBuffer commandBuffer, const std::string& name) {
+				BeginQuery(commandBuffer, name, TinyVkQueryType::TINYVK_QUERY_OCCLUSION);
+			}
+
+			/// @brief Ends the open occlusion scope of the command buffer.
+			void EndOcclusion(VkCommandBuffer commandBuffer) {
+				EndQuery(commandBuffer, TinyVkQueryType::TINYVK_QUERY_OCCLUSION);
+			}
+
+			#pragma endregion
+			#pragma region CONDITIONAL_RENDERING
+
+			/// @brief Copies the results of this frame's ended occlusion scopes recorded in the command buffer into the predicate buffer (record outside of rendering).
+			void ResolveOcclusion(VkCommandBuffer commandBuffer) {
+				timed_guard<false> queryLock(query_lock);
+				if (!recording || predicateBuffer == VK_NULL_HANDLE) return;
+
+				const size_t typeIndex = static_cast<size_t>(TinyVkQueryType::TINYVK_QUERY_OCCLUSION);
+				TinyVkQueryFrame& frame = frames[currentFrame % frames.size()];
+				std::vector<TinyVkQueryScope> resolvable;
+				for(TinyVkQueryScope& scope : frame.scopes[typeIndex]) {
+					bool open = std::any_of(openQueries.begin(), openQueries.end(), [&scope](TinyVkOpenQuery& query) { return query.query == scope.query && query.type == TinyVkQueryType::TINYVK_QUERY_OCCLUSION; });
+					bool resolved = std::any_of(frame.resolvedOcclusion.begin(), frame.resolvedOcclusion.end(), [&scope](TinyVkQueryScope& r) { return r.query == scope.query; });
+					if (scope.commandBuffer == commandBuffer && !open && !resolved) resolvable.push_back(scope);
+				}
+
+				if (resolvable.empty()) return;
+
+				TinyVkBarrierBatch barrierBatch;
+				const VkDeviceSize regionOffset = sizeof(uint32_t) * frame.firstQuery[typeIndex], regionSize = sizeof(uint32_t) * queriesPerFrame;
+				barrierBatch.Buffer(predicateBuffer, VK_PIPELINE_STAGE_2_CONDITIONAL_RENDERING_BIT_EXT, VK_ACCESS_2_NONE, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, regionOffset, regionSize);
+				barrierBatch.Flush(commandBuffer);
+
+				for(TinyVkQueryScope& scope : resolvable) {
+					vkCmdCopyQueryPoolResults(commandBuffer, queryPools[typeIndex], scope.query, 1, predicateBuffer, sizeof(uint32_t) * scope.query, sizeof(uint32_t), VK_QUERY_RESULT_WAIT_BIT);
+					frame.resolvedOcclusion.push_back(scope);
+				}
+
+				barrierBatch.Buffer(predicateBuffer, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_CONDITIONAL_RENDERING_BIT_EXT, VK_ACCESS_2_CONDITIONAL_RENDERING_READ_BIT_EXT, regionOffset, regionSize);
+				barrierBatch.Flush(commandBuffer);
+			}
+
+			/// @brief Begins conditional rendering on the most recent resolved result of the occlusion scope (draws are skipped if no samples passed).
+			/// Returns false (draws always execute) if conditional rendering is unavailable, the scope was never resolved or conditional rendering is already active.
+			bool BeginConditional(VkCommandBuffer commandBuffer, const std::string& name, bool inverted = false) {
+				timed_guard<false> queryLock(query_lock);
+				bool active = std::any_of(openConditions.begin(), openConditions.end(), [commandBuffer](std::pair<VkCommandBuffer, bool>& condition) { return condition.first == commandBuffer && condition.second; });
+
+				const TinyVkQueryScope* latest = nullptr;
+				size_t latestFrame = 0;
+				for(TinyVkQueryFrame& frame : frames)
+					for(TinyVkQueryScope& scope : frame.resolvedOcclusion)
+						if (scope.name == name && (latest == nullptr || frame.frameNumber >= latestFrame)) { latest = &scope; latestFrame = frame.frameNumber; }
+
+				bool recorded = predicateBuffer != VK_NULL_HANDLE && latest != nullptr && !active;
+				if (recorded) {
+					VkConditionalRenderingBeginInfoEXT conditionalInfo {};
+					conditionalInfo.sType = VK_STRUCTURE_TYPE_CONDITIONAL_RENDERING_BEGIN_INFO_EXT;
+					conditionalInfo.buffer = predicateBuffer;
+					conditionalInfo.offset = sizeof(uint32_t) * latest->query;
+					conditionalInfo.flags = (inverted)? VK_CONDITIONAL_RENDERING_INVERTED_BIT_EXT : 0;
+					vkCmdBeginConditionalRenderingEKHR(vkdevice.GetInstance(), commandBuffer, &conditionalInfo);
+				}
+
+				openConditions.push_back({ commandBuffer, recorded });
+				return recorded;
+			}
+
+			/// @brief Ends the innermost BeginConditional() of the command buffer.
+			void EndConditional(VkCommandBuffer commandBuffer) {
+				timed_guard<false> queryLock(query_lock);
+				auto condition = std::find_if(openConditions.rbegin(), openConditions.rend(), [commandBuffer](std::pair<VkCommandBuffer, bool>& c) { return c.first == commandBuffer; });
+				if (condition == openConditions.rend()) return;
+
+				bool recorded = condition->second;
+				openConditions.erase(std::next(condition).base());
+				if (recorded) vkCmdEndConditionalRenderingEKHR(vkdevice.GetInstance(), commandBuffer);
+			}
+
+			#pragma endregion
+			#pragma region QUERY_RESULTS
+
+			/// @brief Returns the aggregated pipeline statistics of every scope read back so far.
+			std::vector<TinyVkPipelineStatistics> GetStatistics() {
+				timed_guard<false> queryLock(query_lock);
+				return statistics;
+			}
+
+			/// @brief Returns the aggregated occlusion results of every scope read back so far (CPU side, a few frames behind).
+			std::vector<TinyVkOcclusionResult> GetOcclusionResults() {
+				timed_guard<false> queryLock(query_lock);
+				return occlusionResults;
+			}
+
+			/// @brief Clears the aggregated results and dropped frame/scope counters.
+			void ResetStats() {
+				timed_guard<false> queryLock(query_lock);
+				statistics.clear();
+				occlusionResults.clear();
+				droppedFrames = droppedScopes = 0;
+			}
+
+			/// @brief Returns the number of frames skipped because their query range was still in flight.
+			size_t GetDroppedFrames() { return droppedFrames; }
+
+			/// @brief Returns the number of scopes without results (range full, nested or never submitted).
+			size_t GetDroppedScopes() { return droppedScopes; }
+
+			/// @brief Returns true if pipeline statistics queries are supported (occlusion queries are always available).
+			bool IsStatisticsSupported() { return queryPools[static_cast<size_t>(TinyVkQueryType::TINYVK_QUERY_GRAPHICS_STATISTICS)] != VK_NULL_HANDLE; }
+
+			/// @brief Returns true if occlusion scopes can drive conditional rendering (VK_EXT_conditional_rendering).
+			bool IsConditionalRenderingSupported() { return predicateBuffer != VK_NULL_HANDLE; }
+
+			#pragma endregion
+		};
+	}
+#endif
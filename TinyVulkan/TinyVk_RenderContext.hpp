@@ -11,6 +11,8 @@
             tinyvk::TinyVkVulkanDevice& vkdevice;
             tinyvk::TinyVkCommandPool& commandPool;
             tinyvk::TinyVkGraphicsPipeline& graphicsPipeline;
+            tinyvk::TinyVkGpuProfiler* gpuProfiler = nullptr; /// Optional GPU profiler for render/transfer scopes.
+            tinyvk::TinyVkPipelineQueries* pipelineQueries = nullptr; /// Optional pipeline statistics queries for recorded render command buffers.
 
             TinyVkRenderContext(TinyVkVulkanDevice& vkdevice, TinyVkCommandPool& commandPool, TinyVkGraphicsPipeline& graphicsPipeline)
                 : vkdevice(vkdevice), commandPool(commandPool), graphicsPipeline(graphicsPipeline) {}
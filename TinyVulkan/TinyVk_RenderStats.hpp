@@ -0,0 +1,324 @@
+#pragma once
+#ifndef TINYVK_TINYVKRENDERSTATS
+#define TINYVK_TINYVKRENDERSTATS
+	#include "./TinyVulkan.hpp"
+	#include <chrono>
+	#include <filesystem>
+	#include <mutex>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT RENDER STATISTICS:
+				Every TinyVkRenderStats keeps relaxed atomic counters for the frame being recorded (draws, dispatches,
+				barriers, pushed descriptors, uploaded/read back bytes, submits, command buffers, blocking timeline
+				waits and stalled waits). EndFrame() moves them into the last frame snapshot (GetSnapshot()) and the running totals (GetTotals()).
+
+				Counters are recorded into the calling thread's active stats object: renderers activate their own
+				renderStats while executing (RenderExecute/ComputeExecute, including onRenderEvents) and end one frame
+				per execution. Everything recorded outside of a renderer (transfers, StageBufferData, user command
+				buffers) goes to TinyVkRenderStats::Global(), call Global().EndFrame() once per application frame.
+
+				ExportAll() returns every live stats object as JSON or Prometheus text exposition format, SetPeriodicDump()
+				writes it to a file every N frames (written to path.tmp, then renamed over the file).
+		*/
+
+		/// @brief Per-frame renderer counters (index into TinyVkRenderStatsSnapshot.values).
+		enum class TinyVkRenderCounter {
+			TINYVK_COUNTER_DRAW_CALLS,
+			TINYVK_COUNTER_DRAWN_VERTICES,
+			TINYVK_COUNTER_DRAWN_INDICES,
+			TINYVK_COUNTER_DISPATCHES,
+			TINYVK_COUNTER_BARRIERS,
+			TINYVK_COUNTER_DESCRIPTORS_PUSHED,
+			TINYVK_COUNTER_BYTES_UPLOADED,
+			TINYVK_COUNTER_BYTES_READ_BACK,
+			TINYVK_COUNTER_SUBMITS,
+			TINYVK_COUNTER_COMMAND_BUFFERS,
+			TINYVK_COUNTER_WAITS,
+			TINYVK_COUNTER_WAIT_NS,
+			TINYVK_COUNTER_STALLS,
+			TINYVK_COUNTER_COUNT
+		};
+
+		/// @brief Export format of TinyVkRenderStats::ExportAll().
+		enum class TinyVkStatsFormat {
+			TINYVK_STATS_JSON,
+			TINYVK_STATS_PROMETHEUS
+		};
+
+		/// @brief Plain copy of a TinyVkRenderStats' counters (one frame or running totals).
+		struct TinyVkRenderStatsSnapshot {
+			std::string name;
+			uint64_t frames = 0;
+			std::array<uint64_t, static_cast<size_t>(TinyVkRenderCounter::TINYVK_COUNTER_COUNT)> values {};
+
+			/// @brief Returns the value of a counter.
+			uint64_t Get(TinyVkRenderCounter counter) const { return values[static_cast<size_t>(counter)]; }
+
+			/// @brief Returns the export (JSON key/Prometheus metric suffix) name of a counter.
+			static const char* GetCounterName(TinyVkRenderCounter counter) {
+				static const char* names[] = {
+					"draw_calls", "drawn_vertices", "drawn_indices", "dispatches", "barriers", "descriptors_pushed",
+					"bytes_uploaded", "bytes_read_back", "submits", "command_buffers", "waits", "wait_ns", "stalls"
+				};
+				return names[static_cast<size_t>(counter)];
+			}
+		};
+
+		/// @brief Cheap always-on per-frame renderer counters with snapshot and JSON/Prometheus export.
+		class TinyVkRenderStats {
+		private:
+			static constexpr size_t counterCount = static_cast<size_t>(TinyVkRenderCounter::TINYVK_COUNTER_COUNT);
+
+			std::array<std::atomic<uint64_t>, counterCount> counters {};
+			std::timed_mutex stats_lock;
+			TinyVkRenderStatsSnapshot lastFrame, totals;
+			uint64_t statsId;
+
+			std::string dumpPath;
+			TinyVkStatsFormat dumpFormat = TinyVkStatsFormat::TINYVK_STATS_JSON;
+			uint64_t dumpInterval = 0;
+
+			struct TinyVkStatsRegistry {
+				std::timed_mutex registry_lock;
+				std::vector<TinyVkRenderStats*> stats;
+				uint64_t nextId = 0;
+			};
+
+			/// @brief Returns the registry of live stats objects (used by ExportAll).
+			static TinyVkStatsRegistry& Registry() {
+				static TinyVkStatsRegistry registry;
+				return registry;
+			}
+
+			/// @brief Returns the calling thread's active stats object (nullptr = Global()).
+			static TinyVkRenderStats*& ActivePointer() {
+				thread_local TinyVkRenderStats* active = nullptr;
+				return active;
+			}
+
+			/// @brief Escapes a string for JSON strings/Prometheus label values.
+			static std::string Escape(const std::string& text) {
+				std::string escaped;
+				for(char c : text) {
+					if (c == '"' || c == '\\') escaped += '\\';
+					if (c == '\n') { escaped += "\\n"; continue; }
+					escaped += c;
+				}
+				return escaped;
+			}
+
+		public:
+			/// Name exported with the counters (renderers default to their class name).
+			std::string name;
+
+			TinyVkRenderStats(const TinyVkRenderStats&) = delete;
+			TinyVkRenderStats operator=(const TinyVkRenderStats&) = delete;
+
+			TinyVkRenderStats(const std::string& name) : name(name) {
+				TinyVkStatsRegistry& registry = Registry();
+				timed_guard<false> registryLock(registry.registry_lock);
+				statsId = registry.nextId ++;
+				registry.stats.push_back(this);
+			}
+
+			~TinyVkRenderStats() {
+				TinyVkStatsRegistry& registry = Registry();
+				timed_guard<false> registryLock(registry.registry_lock);
+				std::erase(registry.stats, this);
+			}
+
+			/// @brief Returns the process-wide stats object for work recorded outside of renderers (transfers, user command buffers).
+			static TinyVkRenderStats& Global() {
+				static TinyVkRenderStats global("TinyVulkan");
+				return global;
+			}
+
+			/// @brief Returns the calling thread's active stats object (the executing renderer's or Global()).
+			static TinyVkRenderStats& Active() {
+				TinyVkRenderStats* active = ActivePointer();
+				return (active != nullptr)? *active : Global();
+			}
+
+			#pragma region COUNTERS
+
+			/// @brief Adds a value to a counter of the frame being recorded.
+			inline void Add(TinyVkRenderCounter counter, uint64_t value = 1) {
+				counters[static_cast<size_t>(counter)].fetch_add(value, std::memory_order_relaxed);
+			}
+
+			/// @brief Counts a draw call and its vertices/indices (times instances).
+			inline void RecordDraw(bool isIndexed, uint64_t vertexCount, uint64_t instanceCount) {
+				Add(TinyVkRenderCounter::TINYVK_COUNTER_DRAW_CALLS);
+				Add((isIndexed)? TinyVkRenderCounter::TINYVK_COUNTER_DRAWN_INDICES : TinyVkRenderCounter::TINYVK_COUNTER_DRAWN_VERTICES, vertexCount * instanceCount);
+			}
+
+			/// @brief Counts a submission of command buffers.
+			inline void RecordSubmit(uint64_t commandBufferCount) {
+				Add(TinyVkRenderCounter::TINYVK_COUNTER_SUBMITS);
+				Add(TinyVkRenderCounter::TINYVK_COUNTER_COMMAND_BUFFERS, commandBufferCount);
+			}
+
+			/// @brief Counts a blocking wait and its duration.
+			inline void RecordWait(uint64_t waitNs) {
+				Add(TinyVkRenderCounter::TINYVK_COUNTER_WAITS);
+				Add(TinyVkRenderCounter::TINYVK_COUNTER_WAIT_NS, waitNs);
+			}
+
+			/// @brief Counts a blocking wait which exceeded its stall threshold (once per exceeded threshold interval).
+			inline void RecordStall() { Add(TinyVkRenderCounter::TINYVK_COUNTER_STALLS); }
+
+			/// @brief Ends the frame: the counters become the last frame snapshot, are added to the totals and reset (writes the periodic dump if due).
+			void EndFrame() {
+				std::string path;
+				TinyVkStatsFormat format;
+				{
+					timed_guard<false> statsLock(stats_lock);
+					lastFrame.name = totals.name = name;
+					lastFrame.frames = 1;
+					totals.frames ++;
+					for(size_t i = 0; i < counterCount; i++) {
+						lastFrame.values[i] = counters[i].exchange(0, std::memory_order_relaxed);
+						totals.values[i] += lastFrame.values[i];
+					}
+
+					if (dumpInterval == 0 || totals.frames % dumpInterval != 0) return;
+					path = dumpPath;
+					format = dumpFormat;
+				}
+				SaveAll(path, format);
+			}
+
+			/// @brief Returns the counters of the last ended frame.
+			TinyVkRenderStatsSnapshot GetSnapshot() {
+				timed_guard<false> statsLock(stats_lock);
+				return lastFrame;
+			}
+
+			/// @brief Returns the counters summed over every ended frame.
+			TinyVkRenderStatsSnapshot GetTotals() {
+				timed_guard<false> statsLock(stats_lock);
+				return totals;
+			}
+
+			/// @brief Returns the counters of the frame being recorded (not yet ended).
+			TinyVkRenderStatsSnapshot GetCurrent() {
+				TinyVkRenderStatsSnapshot current { .name = name, .frames = 0 };
+				for(size_t i = 0; i < counterCount; i++) current.values[i] = counters[i].load(std::memory_order_relaxed);
+				return current;
+			}
+
+			/// @brief Clears the current, last frame and total counters.
+			void Reset() {
+				timed_guard<false> statsLock(stats_lock);
+				for(std::atomic<uint64_t>& counter : counters) counter.store(0, std::memory_order_relaxed);
+				lastFrame = totals = TinyVkRenderStatsSnapshot();
+			}
+
+			#pragma endregion
+			#pragma region METRICS_EXPORT
+
+			/// @brief Writes ExportAll(format) to the path every frameInterval frames ended on this stats object (0 disables).
+			void SetPeriodicDump(const std::string& path, TinyVkStatsFormat format, uint64_t frameInterval) {
+				timed_guard<false> statsLock(stats_lock);
+				dumpPath = path;
+				dumpFormat = format;
+				dumpInterval = frameInterval;
+			}
+
+			/// @brief Returns the last frame and total counters of every live stats object as JSON or Prometheus text.
+			static std::string ExportAll(TinyVkStatsFormat format) {
+				std::vector<std::pair<uint64_t, std::pair<TinyVkRenderStatsSnapshot, TinyVkRenderStatsSnapshot>>> snapshots;
+				{
+					TinyVkStatsRegistry& registry = Registry();
+					timed_guard<false> registryLock(registry.registry_lock);
+					for(TinyVkRenderStats* stats : registry.stats) {
+						TinyVkRenderStatsSnapshot frame = stats->GetSnapshot(), total = stats->GetTotals();
+						frame.name = total.name = stats->name;
+						snapshots.push_back({ stats->statsId, { frame, total } });
+					}
+				}
+
+				std::ostringstream text;
+				if (format == TinyVkStatsFormat::TINYVK_STATS_JSON) {
+					text << "{\"renderers\":[";
+					for(size_t i = 0; i < snapshots.size(); i++) {
+						text << ((i > 0)? ",\n" : "\n") << "{\"name\":\"" << Escape(snapshots[i].second.first.name) << "\",\"id\":" << snapshots[i].first << ",\"frames\":" << snapshots[i].second.second.frames;
+						for(const TinyVkRenderStatsSnapshot* snapshot : { &snapshots[i].second.first, &snapshots[i].second.second }) {
+							text << ((snapshot == &snapshots[i].second.first)? ",\"frame\":{" : ",\"total\":{");
+							for(size_t c = 0; c < counterCount; c++)
+								text << ((c > 0)? "," : "") << "\"" << TinyVkRenderStatsSnapshot::GetCounterName(static_cast<TinyVkRenderCounter>(c)) << "\":" << snapshot->values[c];
+							text << "}";
+						}
+						text << "}";
+					}
+					text << "\n]}\n";
+					return text.str();
+				}
+
+				// Prometheus text exposition format: last frame values as gauges, totals as counters.
+				for(size_t c = 0; c < counterCount; c++) {
+					std::string metric = std::string("tinyvk_") + TinyVkRenderStatsSnapshot::GetCounterName(static_cast<TinyVkRenderCounter>(c));
+					text << "# TYPE " << metric << " gauge\n";
+					for(auto& snapshot : snapshots)
+						text << metric << "{renderer=\"" << Escape(snapshot.second.first.name) << "\",id=\"" << snapshot.first << "\"} " << snapshot.second.first.values[c] << "\n";
+					text << "# TYPE " << metric << "_total counter\n";
+					for(auto& snapshot : snapshots)
+						text << metric << "_total{renderer=\"" << Escape(snapshot.second.second.name) << "\",id=\"" << snapshot.first << "\"} " << snapshot.second.second.values[c] << "\n";
+				}
+
+				text << "# TYPE tinyvk_frames_total counter\n";
+				for(auto& snapshot : snapshots)
+					text << "tinyvk_frames_total{renderer=\"" << Escape(snapshot.second.second.name) << "\",id=\"" << snapshot.first << "\"} " << snapshot.second.second.frames << "\n";
+				return text.str();
+			}
+
+			/// @brief Writes ExportAll(format) to path.tmp and renames it over the path (readers never see a partial file), returns false on failure.
+			static bool SaveAll(const std::string& path, TinyVkStatsFormat format) {
+				if (path.empty()) return false;
+
+				std::string temporaryPath = path + ".tmp";
+				{
+					std::ofstream file(temporaryPath, std::ios::out | std::ios::trunc);
+					if (!file.is_open()) return false;
+					file << ExportAll(format);
+					if (!file.good()) return false;
+				}
+
+				// std::filesystem::rename replaces an existing file in one step (POSIX rename, MoveFileEx on Windows).
+				std::error_code error;
+				std::filesystem::rename(temporaryPath, path, error);
+				if (error) {
+					std::filesystem::remove(temporaryPath, error);
+					return false;
+				}
+				return true;
+			}
+
+			#pragma endregion
+
+			friend class TinyVkRenderStatsScope;
+		};
+
+		/// @brief Makes a stats object the calling thread's active stats object while alive (optionally ending its frame when it goes out of scope).
+		class TinyVkRenderStatsScope {
+		private:
+			TinyVkRenderStats& stats;
+			TinyVkRenderStats* previous;
+			bool endFrame;
+
+		public:
+			TinyVkRenderStatsScope(TinyVkRenderStats& stats, bool endFrame = false) : stats(stats), previous(TinyVkRenderStats::ActivePointer()), endFrame(endFrame) {
+				TinyVkRenderStats::ActivePointer() = &stats;
+			}
+
+			~TinyVkRenderStatsScope() {
+				TinyVkRenderStats::ActivePointer() = previous;
+				if (endFrame) stats.EndFrame();
+			}
+
+			TinyVkRenderStatsScope(const TinyVkRenderStatsScope&) = delete;
+			TinyVkRenderStatsScope operator=(const TinyVkRenderStatsScope&) = delete;
+		};
+	}
+#endif
@@ -0,0 +1,194 @@
+#pragma once
+#ifndef TINYVK_TINYVKSHADERCACHE
+#define TINYVK_TINYVKSHADERCACHE
+	#include "./TinyVulkan.hpp"
+	#include <unordered_map>
+	#include <cstring>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT THE SHADER MODULE CACHE:
+				Every TinyVkVulkanDevice owns a TinyVkShaderCache (GetShaderCache()) holding one VkShaderModule per unique SPIR-V
+				code, keyed by a 64-bit FNV-1a hash of the code and compared word for word on a hit (a hash collision creates its
+				own module). Modules are shared by every graphics pipeline and compute renderer
+				and kept until the device is disposed. Shader paths are resolved once: a path's code is loaded on its first use and
+				later pipelines using the same path (or the same code under another path) reuse its module.
+
+				Embedded shaders skip the filesystem. Compile them to uint32_t arrays at build time and register them under the path
+				the pipelines load them from, the embedded code is then used instead of the file by pipelines, compute renderers
+				and TinyVkShaderReflection:
+					glslc -mfmt=num passthrough.vert -o passthrough_vert_spv.inc
+					inline constexpr uint32_t passthrough_vert_spv[] = {
+						#include "passthrough_vert_spv.inc"
+					};
+					TINYVK_EMBED_SHADER("./Shaders/passthrough_vert.spv", passthrough_vert_spv)
+				_SHADERS.bat (source.cpp) and Benchmarks/CMakeLists.txt generate these as ./Shaders/<name>_spv.h headers.
+
+				Shader hot reload (TinyVkShaderWatcher) always reads the file on disk and points the path at the reloaded code's
+				module (UpdateShaderModule()), modules of the previous code stay cached.
+		*/
+
+		/// @brief Device-wide VkShaderModule cache keyed by SPIR-V content with a registry of embedded SPIR-V.
+		class TinyVkShaderCache : public TinyVkDisposable {
+		private:
+			VkDevice logicalDevice;
+			std::timed_mutex cache_lock;
+			std::unordered_map<uint64_t, std::vector<std::pair<std::vector<uint32_t>, VkShaderModule>>> shaderModules; /// Content hash -> code and module (more than one on collision).
+			std::unordered_map<std::string, VkShaderModule> shaderPaths; /// Path -> module of its current code.
+			size_t moduleCount = 0;
+
+			/// @brief Embedded SPIR-V by path (function local so registration during static initialization is safe).
+			inline static std::unordered_map<std::string, std::pair<const uint32_t*, size_t>>& EmbeddedShaders() {
+				static std::unordered_map<std::string, std::pair<const uint32_t*, size_t>> embeddedShaders;
+				return embeddedShaders;
+			}
+
+			inline static std::timed_mutex& EmbeddedLock() {
+				static std::timed_mutex embedded_lock;
+				return embedded_lock;
+			}
+
+			/// @brief Returns the module of the code, the hash only selects candidates which must match the code exactly (cache_lock must be held).
+			VkShaderModule GetOrCreateModule(uint64_t hash, const uint32_t* code, size_t wordCount) {
+				std::vector<std::pair<std::vector<uint32_t>, VkShaderModule>>& candidates = shaderModules[hash];
+				for(const auto& cached : candidates)
+					if (cached.first.size() == wordCount && std::memcmp(cached.first.data(), code, wordCount * sizeof(uint32_t)) == 0)
+						return cached.second;
+
+				VkShaderModuleCreateInfo createInfo{};
+				createInfo.sType = VK_STRUCTURE_TYPE_SHADER_MODULE_CREATE_INFO;
+				createInfo.pNext = VK_NULL_HANDLE;
+				createInfo.flags = 0;
+				createInfo.codeSize = wordCount * sizeof(uint32_t);
+				createInfo.pCode = code;
+
+				VkShaderModule shaderModule;
+				if (vkCreateShaderModule(logicalDevice, &createInfo, VK_NULL_HANDLE, &shaderModule) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to create shader module!");
+
+				candidates.emplace_back(std::vector<uint32_t>(code, code + wordCount), shaderModule);
+				moduleCount ++;
+				return shaderModule;
+			}
+
+		public:
+			TinyVkShaderCache operator=(const TinyVkShaderCache& cache) = delete;
+
+			~TinyVkShaderCache() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				for(auto& candidates : shaderModules)
+					for(auto& cached : candidates.second)
+						vkDestroyShaderModule(logicalDevice, cached.second, VK_NULL_HANDLE);
+				shaderModules.clear();
+				moduleCount = 0;
+				shaderPaths.clear();
+			}
+
+			/// @brief Creates the shader module cache for the logical device (owned by the TinyVkVulkanDevice).
+			TinyVkShaderCache(VkDevice logicalDevice) : logicalDevice(logicalDevice) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+			}
+
+			/// @brief Returns the 64-bit FNV-1a hash of SPIR-V code (the cache key of its shader module).
+			inline static uint64_t HashCode(const uint32_t* code, size_t wordCount) {
+				const uint8_t* bytes = reinterpret_cast<const uint8_t*>(code);
+				uint64_t hash = 14695981039346656037ull;
+				for(size_t i = 0; i < wordCount * sizeof(uint32_t); i++) {
+					hash ^= bytes[i];
+					hash *= 1099511628211ull;
+				}
+				return hash;
+			}
+
+			/// @brief Registers SPIR-V embedded in the executable under a shader path (the code must outlive every device, e.g. a constexpr array).
+			static bool Embed(const std::string& path, const uint32_t* code, size_t wordCount) {
+				timed_guard<false> embeddedLock(EmbeddedLock());
+				EmbeddedShaders()[path] = std::pair(code, wordCount);
+				return true;
+			}
+
+			/// @brief Registers a SPIR-V array embedded in the executable under a shader path.
+			template<size_t N>
+			static bool Embed(const std::string& path, const uint32_t (&code)[N]) { return Embed(path, code, N); }
+
+			/// @brief Returns true if SPIR-V is embedded for the shader path.
+			static bool IsEmbedded(const std::string& path) {
+				timed_guard<false> embeddedLock(EmbeddedLock());
+				return EmbeddedShaders().contains(path);
+			}
+
+			/// @brief Reads a SPIR-V file from disk (ignores embedded shaders).
+			static std::vector<uint32_t> ReadShaderFile(const std::string& path) {
+				std::ifstream file(path, std::ios::ate | std::ios::binary);
+				if (!file.is_open())
+					throw TinyVkRuntimeError("TinyVulkan: Failed to Read File: " + path);
+
+				size_t fsize = static_cast<size_t>(file.tellg());
+				if (fsize == 0 || fsize % sizeof(uint32_t) != 0)
+					throw TinyVkRuntimeError("TinyVulkan: Invalid SPIR-V file (size is not a multiple of 4 bytes): " + path);
+
+				std::vector<uint32_t> code(fsize / sizeof(uint32_t));
+				file.seekg(0);
+				file.read(reinterpret_cast<char*>(code.data()), fsize);
+				return code;
+			}
+
+			/// @brief Returns the SPIR-V of a shader path: the embedded code if registered (no file I/O), otherwise read from disk.
+			static std::vector<uint32_t> ReadShaderCode(const std::string& path) {
+				{
+					timed_guard<false> embeddedLock(EmbeddedLock());
+					auto embedded = EmbeddedShaders().find(path);
+					if (embedded != EmbeddedShaders().end())
+						return std::vector<uint32_t>(embedded->second.first, embedded->second.first + embedded->second.second);
+				}
+				return ReadShaderFile(path);
+			}
+
+			/// @brief Returns the shader module of a shader path, resolved on first use (embedded or read once from disk) and shared by identical code (thread-safe).
+			VkShaderModule GetShaderModule(const std::string& path) {
+				{
+					timed_guard<false> cacheLock(cache_lock);
+					auto cached = shaderPaths.find(path);
+					if (cached != shaderPaths.end()) return cached->second;
+				}
+
+				std::pair<const uint32_t*, size_t> embeddedCode = { nullptr, 0 };
+				{
+					timed_guard<false> embeddedLock(EmbeddedLock());
+					auto embedded = EmbeddedShaders().find(path);
+					if (embedded != EmbeddedShaders().end()) embeddedCode = embedded->second;
+				}
+				if (embeddedCode.first != nullptr) return UpdateShaderModule(path, embeddedCode.first, embeddedCode.second);
+
+				std::vector<uint32_t> shaderCode = ReadShaderFile(path);
+				return UpdateShaderModule(path, shaderCode.data(), shaderCode.size());
+			}
+
+			/// @brief Returns the shader module of SPIR-V code, created once per unique code (thread-safe).
+			VkShaderModule GetShaderModule(const uint32_t* code, size_t wordCount) {
+				uint64_t hash = HashCode(code, wordCount);
+				timed_guard<false> cacheLock(cache_lock);
+				return GetOrCreateModule(hash, code, wordCount);
+			}
+
+			/// @brief Points a shader path at new code (e.g. reloaded from disk) and returns its module, the previous code's module stays cached.
+			VkShaderModule UpdateShaderModule(const std::string& path, const uint32_t* code, size_t wordCount) {
+				uint64_t hash = HashCode(code, wordCount);
+				timed_guard<false> cacheLock(cache_lock);
+				VkShaderModule shaderModule = GetOrCreateModule(hash, code, wordCount);
+				shaderPaths[path] = shaderModule;
+				return shaderModule;
+			}
+
+			/// @brief Returns the number of unique shader modules created.
+			size_t GetModuleCount() {
+				timed_guard<false> cacheLock(cache_lock);
+				return moduleCount;
+			}
+		};
+	}
+
+	/// @brief Registers an embedded SPIR-V array under a shader path during static initialization (use at namespace scope).
+	#define TINYVK_EMBED_SHADER(path, code) inline const bool tinyvk_embedded_##code = TINYVULKAN_NAMESPACE::TinyVkShaderCache::Embed(path, code);
+#endif
@@ -0,0 +1,426 @@
+#pragma once
+#ifndef TINYVK_TINYVKSHADERREFLECTION
+#define TINYVK_TINYVKSHADERREFLECTION
+	#include "./TinyVulkan.hpp"
+	#include <cstring>
+	#include <span>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT SHADER REFLECTION:
+				TinyVkShaderReflection parses SPIR-V modules directly (no SPIRV-Cross/glslang dependency) and derives:
+					Descriptor bindings: set/binding/type/count and the stages using them (merged across modules).
+					Push constant range: one range covering every stage's push constant block (merged stage flags).
+					Vertex input: per-vertex attributes of the vertex stage, tightly packed in location order on binding 0.
+					Compute local size: OpExecutionMode LocalSize of the compute entry point.
+
+				Only the first entry point of each module is reflected (TinyVulkan loads "main"). Runtime sized descriptor arrays
+				are reported with a descriptorCount of 0. Push descriptor pipelines only use set 0: GetPushDescriptorBindings()
+				throws if the shaders declare other sets, apart from a TinyVkBindlessTable's set 1 for pipelines created with one
+				(GetPushDescriptorBindings(true)). Mismatched descriptor types on the same set/binding between stages throw.
+		*/
+
+		/// @brief A descriptor binding reflected from SPIR-V (set + layout binding).
+		struct TinyVkReflectedBinding {
+			uint32_t set;
+			VkDescriptorSetLayoutBinding layoutBinding;
+		};
+
+		/// @brief Descriptor, push constant, vertex input and local size layout reflected from SPIR-V shader modules.
+		class TinyVkShaderReflection {
+		private:
+			#pragma region SPIRV_CONSTANTS
+
+			inline static const uint32_t SpvMagicNumber = 0x07230203;
+			enum SpvOp : uint32_t {
+				SpvOpEntryPoint = 15, SpvOpExecutionMode = 16, SpvOpTypeBool = 20, SpvOpTypeInt = 21, SpvOpTypeFloat = 22, SpvOpTypeVector = 23,
+				SpvOpTypeMatrix = 24, SpvOpTypeImage = 25, SpvOpTypeSampler = 26, SpvOpTypeSampledImage = 27, SpvOpTypeArray = 28,
+				SpvOpTypeRuntimeArray = 29, SpvOpTypeStruct = 30, SpvOpTypePointer = 32, SpvOpConstant = 43, SpvOpSpecConstant = 50,
+				SpvOpVariable = 59, SpvOpDecorate = 71, SpvOpMemberDecorate = 72, SpvOpTypeAccelerationStructure = 5341
+			};
+			enum SpvDecoration : uint32_t {
+				SpvDecorationBlock = 2, SpvDecorationBufferBlock = 3, SpvDecorationArrayStride = 6, SpvDecorationMatrixStride = 7,
+				SpvDecorationBuiltIn = 11, SpvDecorationLocation = 30, SpvDecorationBinding = 33, SpvDecorationDescriptorSet = 34, SpvDecorationOffset = 35
+			};
+			enum SpvStorageClass : uint32_t {
+				SpvStorageUniformConstant = 0, SpvStorageInput = 1, SpvStorageUniform = 2, SpvStoragePushConstant = 9, SpvStorageStorageBuffer = 12
+			};
+			inline static const uint32_t SpvExecutionModeLocalSize = 17;
+			inline static const uint32_t SpvDimBuffer = 5, SpvDimSubpassData = 6;
+
+			#pragma endregion
+
+			/// @brief Type/variable/constant/decoration info of a single SPIR-V result id.
+			struct SpvId {
+				uint32_t opcode = 0;
+				uint32_t typeId = 0;       /// Pointee, element, component, sampled or variable type.
+				uint32_t storageClass = 0; /// Pointers and variables.
+				uint32_t width = 0, signedness = 0, count = 0; /// Scalar width/signedness, vector/matrix size or array length id.
+				uint32_t imageDim = 0, imageSampled = 0;
+				uint32_t constant = 0;
+				std::vector<uint32_t> members, memberOffsets, memberMatrixStrides;
+				uint32_t set = 0, binding = 0, location = 0, arrayStride = 0;
+				bool hasBinding = false, hasLocation = false, builtIn = false, bufferBlock = false;
+			};
+
+			inline static SpvId& Id(std::vector<SpvId>& ids, uint32_t id) {
+				if (id >= ids.size()) throw TinyVkRuntimeError("TinyVulkan: Invalid SPIR-V module (id out of bounds)!");
+				return ids[id];
+			}
+
+			inline static uint32_t SizeOf(std::vector<SpvId>& ids, uint32_t typeId, uint32_t matrixStride = 0) {
+				SpvId& type = Id(ids, typeId);
+				switch(type.opcode) {
+					case SpvOpTypeBool: return 4;
+					case SpvOpTypeInt:
+					case SpvOpTypeFloat: return type.width / 8;
+					case SpvOpTypeVector: return type.count * SizeOf(ids, type.typeId);
+					case SpvOpTypeMatrix: return type.count * ((matrixStride > 0)? matrixStride : SizeOf(ids, type.typeId));
+					case SpvOpTypeArray: return Id(ids, type.count).constant * ((type.arrayStride > 0)? type.arrayStride : SizeOf(ids, type.typeId));
+					case SpvOpTypeStruct: {
+						uint32_t size = 0;
+						for(size_t i = 0; i < type.members.size(); i++) {
+							uint32_t offset = (i < type.memberOffsets.size())? type.memberOffsets[i] : size;
+							uint32_t stride = (i < type.memberMatrixStrides.size())? type.memberMatrixStrides[i] : 0;
+							size = std::max(size, offset + SizeOf(ids, type.members[i], stride));
+						}
+						return size;
+					}
+					default: return 0;
+				}
+			}
+
+			inline static VkFormat VertexFormat(std::vector<SpvId>& ids, uint32_t typeId) {
+				SpvId& type = Id(ids, typeId);
+				uint32_t components = (type.opcode == SpvOpTypeVector)? type.count : 1;
+				SpvId& scalar = (type.opcode == SpvOpTypeVector)? Id(ids, type.typeId) : type;
+				if (components < 1 || components > 4) return VK_FORMAT_UNDEFINED;
+
+				const VkFormat floats[4] = { VK_FORMAT_R32_SFLOAT, VK_FORMAT_R32G32_SFLOAT, VK_FORMAT_R32G32B32_SFLOAT, VK_FORMAT_R32G32B32A32_SFLOAT };
+				const VkFormat doubles[4] = { VK_FORMAT_R64_SFLOAT, VK_FORMAT_R64G64_SFLOAT, VK_FORMAT_R64G64B64_SFLOAT, VK_FORMAT_R64G64B64A64_SFLOAT };
+				const VkFormat sints[4] = { VK_FORMAT_R32_SINT, VK_FORMAT_R32G32_SINT, VK_FORMAT_R32G32B32_SINT, VK_FORMAT_R32G32B32A32_SINT };
+				const VkFormat uints[4] = { VK_FORMAT_R32_UINT, VK_FORMAT_R32G32_UINT, VK_FORMAT_R32G32B32_UINT, VK_FORMAT_R32G32B32A32_UINT };
+				if (scalar.opcode == SpvOpTypeFloat && scalar.width == 32) return floats[components - 1];
+				if (scalar.opcode == SpvOpTypeFloat && scalar.width == 64) return doubles[components - 1];
+				if (scalar.opcode == SpvOpTypeInt && scalar.width == 32) return (scalar.signedness)? sints[components - 1] : uints[components - 1];
+				return VK_FORMAT_UNDEFINED;
+			}
+
+			inline static VkShaderStageFlags ExecutionModelStage(uint32_t executionModel) {
+				switch(executionModel) {
+					case 0: return VK_SHADER_STAGE_VERTEX_BIT;
+					case 1: return VK_SHADER_STAGE_TESSELLATION_CONTROL_BIT;
+					case 2: return VK_SHADER_STAGE_TESSELLATION_EVALUATION_BIT;
+					case 3: return VK_SHADER_STAGE_GEOMETRY_BIT;
+					case 4: return VK_SHADER_STAGE_FRAGMENT_BIT;
+					case 5: return VK_SHADER_STAGE_COMPUTE_BIT;
+					case 5364: return VK_SHADER_STAGE_TASK_BIT_EXT;
+					case 5365: return VK_SHADER_STAGE_MESH_BIT_EXT;
+					default: return 0;
+				}
+			}
+
+			void ReflectVariable(std::vector<SpvId>& ids, SpvId& variable) {
+				uint32_t typeId = Id(ids, variable.typeId).typeId;
+				SpvId* type = &Id(ids, typeId);
+
+				if (variable.storageClass == SpvStoragePushConstant) {
+					if (type->opcode != SpvOpTypeStruct) return;
+					uint32_t begin = UINT32_MAX;
+					for(uint32_t offset : type->memberOffsets) begin = std::min(begin, offset);
+					if (begin == UINT32_MAX) begin = 0;
+					begin &= ~3u;
+
+					uint32_t end = (SizeOf(ids, typeId) + 3u) & ~3u;
+					if (end > begin) pushConstantRanges.push_back({ stages, begin, end - begin });
+					return;
+				}
+
+				if (variable.storageClass == SpvStorageInput) {
+					if (!(stages & VK_SHADER_STAGE_VERTEX_BIT) || !variable.hasLocation || variable.builtIn) return;
+
+					uint32_t columns = (type->opcode == SpvOpTypeMatrix)? type->count : 1;
+					uint32_t columnType = (type->opcode == SpvOpTypeMatrix)? type->typeId : typeId;
+					VkFormat format = VertexFormat(ids, columnType);
+					if (format == VK_FORMAT_UNDEFINED)
+						throw TinyVkRuntimeError("TinyVulkan: Unsupported vertex input type at location " + std::to_string(variable.location) + " (reflection supports 32-bit scalars/vectors/matrices)!");
+
+					for(uint32_t i = 0; i < columns; i++)
+						vertexAttributes.push_back({ variable.location + i, 0, format, SizeOf(ids, columnType) });
+					return;
+				}
+
+				if (!variable.hasBinding || (variable.storageClass != SpvStorageUniformConstant && variable.storageClass != SpvStorageUniform && variable.storageClass != SpvStorageStorageBuffer))
+					return;
+
+				uint32_t descriptorCount = 1;
+				while(type->opcode == SpvOpTypeArray || type->opcode == SpvOpTypeRuntimeArray) {
+					descriptorCount = (type->opcode == SpvOpTypeArray)? descriptorCount * Id(ids, type->count).constant : 0;
+					type = &Id(ids, type->typeId);
+				}
+
+				VkDescriptorType descriptorType;
+				switch(type->opcode) {
+					case SpvOpTypeSampledImage: descriptorType = VK_DESCRIPTOR_TYPE_COMBINED_IMAGE_SAMPLER; break;
+					case SpvOpTypeSampler: descriptorType = VK_DESCRIPTOR_TYPE_SAMPLER; break;
+					case SpvOpTypeAccelerationStructure: descriptorType = VK_DESCRIPTOR_TYPE_ACCELERATION_STRUCTURE_KHR; break;
+					case SpvOpTypeImage:
+						if (type->imageDim == SpvDimBuffer) { descriptorType = (type->imageSampled == 2)? VK_DESCRIPTOR_TYPE_STORAGE_TEXEL_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_TEXEL_BUFFER; }
+						else if (type->imageDim == SpvDimSubpassData) { descriptorType = VK_DESCRIPTOR_TYPE_INPUT_ATTACHMENT; }
+						else descriptorType = (type->imageSampled == 2)? VK_DESCRIPTOR_TYPE_STORAGE_IMAGE : VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE;
+						break;
+					case SpvOpTypeStruct:
+						descriptorType = (variable.storageClass == SpvStorageStorageBuffer || type->bufferBlock)? VK_DESCRIPTOR_TYPE_STORAGE_BUFFER : VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER;
+						break;
+					default: return;
+				}
+
+				VkDescriptorSetLayoutBinding layoutBinding {};
+				layoutBinding.binding = variable.binding;
+				layoutBinding.descriptorType = descriptorType;
+				layoutBinding.descriptorCount = descriptorCount;
+				layoutBinding.stageFlags = stages;
+				layoutBinding.pImmutableSamplers = VK_NULL_HANDLE;
+				bindings.push_back({ variable.set, layoutBinding });
+			}
+
+		public:
+			VkShaderStageFlags stages = 0;
+			std::vector<TinyVkReflectedBinding> bindings;
+			std::vector<VkPushConstantRange> pushConstantRanges; /// At most one range, merged across stages.
+			std::vector<VkVertexInputAttributeDescription> vertexAttributes; /// Binding 0, tightly packed in location order.
+			uint32_t vertexStride = 0;
+			std::array<uint32_t, 3> localSize = { 0, 0, 0 }; /// Compute work group size (zero for other stages).
+
+			/// @brief Reflects a SPIR-V module, stage of 0 uses the module's first entry point's execution model.
+			static TinyVkShaderReflection FromCode(const uint32_t* code, size_t codeWords, VkShaderStageFlags stage = 0) {
+				if (codeWords < 5)
+					throw TinyVkRuntimeError("TinyVulkan: Invalid SPIR-V module (missing header)!");
+
+				std::span<const uint32_t> words(code, codeWords);
+				if (words[0] != SpvMagicNumber)
+					throw TinyVkRuntimeError("TinyVulkan: Invalid SPIR-V module (bad magic number)!");
+
+				TinyVkShaderReflection reflection;
+				std::vector<SpvId> ids(words[3]);
+				uint32_t executionModel = UINT32_MAX, entryPoint = 0;
+
+				for(size_t i = 5; i < words.size();) {
+					const uint32_t* op = &words[i];
+					uint32_t opcode = op[0] & 0xFFFF, wordCount = op[0] >> 16;
+					if (wordCount == 0 || i + wordCount > words.size())
+						throw TinyVkRuntimeError("TinyVulkan: Invalid SPIR-V module (truncated instruction)!");
+
+					switch(opcode) {
+						case SpvOpEntryPoint:
+							if (executionModel == UINT32_MAX) { executionModel = op[1]; entryPoint = op[2]; }
+						break;
+						case SpvOpExecutionMode:
+							if (op[1] == entryPoint && op[2] == SpvExecutionModeLocalSize && wordCount >= 6) reflection.localSize = { op[3], op[4], op[5] };
+						break;
+						case SpvOpDecorate: {
+							SpvId& target = Id(ids, op[1]);
+							uint32_t value = (wordCount > 3)? op[3] : 0;
+							switch(op[2]) {
+								case SpvDecorationBufferBlock: target.bufferBlock = true; break;
+								case SpvDecorationArrayStride: target.arrayStride = value; break;
+								case SpvDecorationBuiltIn: target.builtIn = true; break;
+								case SpvDecorationLocation: target.location = value; target.hasLocation = true; break;
+								case SpvDecorationBinding: target.binding = value; target.hasBinding = true; break;
+								case SpvDecorationDescriptorSet: target.set = value; break;
+							}
+						} break;
+						case SpvOpMemberDecorate: {
+							SpvId& target = Id(ids, op[1]);
+							uint32_t member = op[2], value = (wordCount > 4)? op[4] : 0;
+							if (op[3] == SpvDecorationOffset) {
+								if (target.memberOffsets.size() <= member) target.memberOffsets.resize(member + 1, 0);
+								target.memberOffsets[member] = value;
+							} else if (op[3] == SpvDecorationMatrixStride) {
+								if (target.memberMatrixStrides.size() <= member) target.memberMatrixStrides.resize(member + 1, 0);
+								target.memberMatrixStrides[member] = value;
+							} else if (op[3] == SpvDecorationBuiltIn) target.builtIn = true;
+						} break;
+						case SpvOpTypeBool:
+						case SpvOpTypeSampler:
+						case SpvOpTypeAccelerationStructure:
+							Id(ids, op[1]).opcode = opcode;
+						break;
+						case SpvOpTypeInt:
+						case SpvOpTypeFloat: {
+							SpvId& type = Id(ids, op[1]);
+							type.opcode = opcode;
+							type.width = op[2];
+							type.signedness = (opcode == SpvOpTypeInt && wordCount > 3)? op[3] : 1;
+						} break;
+						case SpvOpTypeVector:
+						case SpvOpTypeMatrix:
+						case SpvOpTypeArray: {
+							SpvId& type = Id(ids, op[1]);
+							type.opcode = opcode;
+							type.typeId = op[2];
+							type.count = op[3];
+						} break;
+						case SpvOpTypeImage: {
+							SpvId& type = Id(ids, op[1]);
+							type.opcode = opcode;
+							type.typeId = op[2];
+							type.imageDim = op[3];
+							type.imageSampled = op[7];
+						} break;
+						case SpvOpTypeSampledImage:
+						case SpvOpTypeRuntimeArray: {
+							SpvId& type = Id(ids, op[1]);
+							type.opcode = opcode;
+							type.typeId = op[2];
+						} break;
+						case SpvOpTypeStruct: {
+							SpvId& type = Id(ids, op[1]);
+							type.opcode = opcode;
+							type.members.assign(op + 2, op + wordCount);
+						} break;
+						case SpvOpTypePointer: {
+							SpvId& type = Id(ids, op[1]);
+							type.opcode = opcode;
+							type.storageClass = op[2];
+							type.typeId = op[3];
+						} break;
+						case SpvOpConstant:
+						case SpvOpSpecConstant: {
+							SpvId& constant = Id(ids, op[2]);
+							constant.opcode = opcode;
+							constant.typeId = op[1];
+							constant.constant = op[3];
+						} break;
+						case SpvOpVariable: {
+							SpvId& variable = Id(ids, op[2]);
+							variable.opcode = opcode;
+							variable.typeId = op[1];
+							variable.storageClass = op[3];
+						} break;
+					}
+					i += wordCount;
+				}
+
+				reflection.stages = (stage != 0)? stage : ExecutionModelStage(executionModel);
+				for(SpvId& id : ids)
+					if (id.opcode == SpvOpVariable) reflection.ReflectVariable(ids, id);
+
+				std::sort(reflection.vertexAttributes.begin(), reflection.vertexAttributes.end(),
+					[](const VkVertexInputAttributeDescription& a, const VkVertexInputAttributeDescription& b) { return a.location < b.location; });
+				for(VkVertexInputAttributeDescription& attribute : reflection.vertexAttributes) {
+					uint32_t size = attribute.offset; // Holds the attribute size until packed.
+					attribute.offset = reflection.vertexStride;
+					reflection.vertexStride += size;
+				}
+
+				if (reflection.stages != VK_SHADER_STAGE_COMPUTE_BIT) reflection.localSize = { 0, 0, 0 };
+				return reflection;
+			}
+
+			/// @brief Reflects a SPIR-V module stored as bytes, stage of 0 uses the module's first entry point's execution model.
+			static TinyVkShaderReflection FromCode(const std::vector<char>& code, VkShaderStageFlags stage = 0) {
+				if (code.size() % 4 != 0)
+					throw TinyVkRuntimeError("TinyVulkan: Invalid SPIR-V module (size is not a multiple of 4 bytes)!");
+
+				std::vector<uint32_t> words(code.size() / 4);
+				std::memcpy(words.data(), code.data(), code.size());
+				return FromCode(words.data(), words.size(), stage);
+			}
+
+			/// @brief Reflects the SPIR-V of a shader path (embedded code if registered with TinyVkShaderCache::Embed(), otherwise read from disk).
+			static TinyVkShaderReflection FromFile(const std::string& path, VkShaderStageFlags stage = 0) {
+				std::vector<uint32_t> code = TinyVkShaderCache::ReadShaderCode(path);
+				return FromCode(code.data(), code.size(), stage);
+			}
+
+			/// @brief Reflects and merges the shader stages of a pipeline.
+			static TinyVkShaderReflection FromShaders(const std::vector<std::tuple<VkShaderStageFlagBits, std::string>>& shaders) {
+				TinyVkShaderReflection reflection;
+				for(const auto& shader : shaders)
+					reflection.Merge(FromFile(std::get<1>(shader), std::get<0>(shader)));
+				return reflection;
+			}
+
+			/// @brief Merges another stage's reflection into this one (stage flags of shared bindings/push constants are combined).
+			void Merge(const TinyVkShaderReflection& other) {
+				stages |= other.stages;
+
+				for(const TinyVkReflectedBinding& binding : other.bindings) {
+					auto existing = std::find_if(bindings.begin(), bindings.end(), [&binding](const TinyVkReflectedBinding& b) { return b.set == binding.set && b.layoutBinding.binding == binding.layoutBinding.binding; });
+					if (existing == bindings.end()) { bindings.push_back(binding); continue; }
+
+					if (existing->layoutBinding.descriptorType != binding.layoutBinding.descriptorType)
+						throw TinyVkRuntimeError("TinyVulkan: Shader stages declare different descriptor types at set " + std::to_string(binding.set) + " binding " + std::to_string(binding.layoutBinding.binding) + "!");
+					existing->layoutBinding.stageFlags |= binding.layoutBinding.stageFlags;
+					existing->layoutBinding.descriptorCount = std::max(existing->layoutBinding.descriptorCount, binding.layoutBinding.descriptorCount);
+				}
+
+				for(const VkPushConstantRange& range : other.pushConstantRanges) {
+					if (pushConstantRanges.empty()) { pushConstantRanges.push_back(range); continue; }
+
+					VkPushConstantRange& merged = pushConstantRanges[0];
+					uint32_t end = std::max(merged.offset + merged.size, range.offset + range.size);
+					merged.offset = std::min(merged.offset, range.offset);
+					merged.size = end - merged.offset;
+					merged.stageFlags |= range.stageFlags;
+				}
+
+				if (!other.vertexAttributes.empty()) { vertexAttributes = other.vertexAttributes; vertexStride = other.vertexStride; }
+				if (other.localSize[0] > 0) localSize = other.localSize;
+			}
+
+			/// @brief Returns the reflected layout bindings of a descriptor set.
+			std::vector<VkDescriptorSetLayoutBinding> GetDescriptorBindings(uint32_t set = 0) const {
+				std::vector<VkDescriptorSetLayoutBinding> setBindings;
+				for(const TinyVkReflectedBinding& binding : bindings)
+					if (binding.set == set) setBindings.push_back(binding.layoutBinding);
+				return setBindings;
+			}
+
+			/// @brief Returns true if a reflected binding is one of the TinyVkBindlessTable's (set 1: binding 0 sampled images, binding 1 samplers).
+			inline static bool IsBindlessBinding(const TinyVkReflectedBinding& binding) {
+				return binding.set == TinyVkBindlessTable::descriptorSetIndex
+					&& ((binding.layoutBinding.binding == 0 && binding.layoutBinding.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLED_IMAGE)
+					|| (binding.layoutBinding.binding == 1 && binding.layoutBinding.descriptorType == VK_DESCRIPTOR_TYPE_SAMPLER));
+			}
+
+			/// @brief Returns the push descriptor layout bindings (set 0), throws if the shaders use other sets (except a bindless table's set if bindless) or runtime sized arrays.
+			std::vector<VkDescriptorSetLayoutBinding> GetPushDescriptorBindings(bool bindless = false) const {
+				for(const TinyVkReflectedBinding& binding : bindings) {
+					if (bindless && IsBindlessBinding(binding)) continue;
+					if (binding.set != 0)
+						throw TinyVkRuntimeError("TinyVulkan: Reflected shaders use descriptor set " + std::to_string(binding.set) + ", push descriptor pipelines only support set 0!");
+					if (binding.layoutBinding.descriptorCount == 0)
+						throw TinyVkRuntimeError("TinyVulkan: Reflected shaders use a runtime sized descriptor array at binding " + std::to_string(binding.layoutBinding.binding) + ", push descriptors require a fixed count!");
+				}
+				return GetDescriptorBindings(0);
+			}
+
+			/// @brief Returns the stage flags of the merged push constant range (0 if none), pass these to PushConstants().
+			VkShaderStageFlags GetPushConstantStages() const {
+				return (pushConstantRanges.empty())? 0 : pushConstantRanges[0].stageFlags;
+			}
+
+			/// @brief Returns the vertex binding description of the reflected vertex attributes.
+			VkVertexInputBindingDescription GetVertexBinding(VkVertexInputRate inputRate = VK_VERTEX_INPUT_RATE_VERTEX) const {
+				return { 0, vertexStride, inputRate };
+			}
+
+			/// @brief Returns true if every descriptor binding (same type, set 0 or the bindless table's if bindless) and push constant byte used by the shaders is declared in an existing pipeline layout.
+			bool IsLayoutCompatible(const std::vector<VkDescriptorSetLayoutBinding>& layoutBindings, const std::vector<VkPushConstantRange>& layoutRanges, bool bindless = false) const {
+				for(const TinyVkReflectedBinding& reflected : bindings) {
+					if (bindless && IsBindlessBinding(reflected)) continue;
+					auto declared = std::find_if(layoutBindings.begin(), layoutBindings.end(), [&reflected](const VkDescriptorSetLayoutBinding& binding) { return binding.binding == reflected.layoutBinding.binding; });
+					if (reflected.set != 0 || declared == layoutBindings.end() || declared->descriptorType != reflected.layoutBinding.descriptorType) return false;
+				}
+
+				uint32_t layoutEnd = 0;
+				for(const VkPushConstantRange& range : layoutRanges) layoutEnd = std::max(layoutEnd, range.offset + range.size);
+				for(const VkPushConstantRange& range : pushConstantRanges)
+					if (range.offset + range.size > layoutEnd) return false;
+				return true;
+			}
+		};
+	}
+#endif
@@ -0,0 +1,207 @@
+#pragma once
+#ifndef TINYVK_TINYVKSHADERWATCHER
+#define TINYVK_TINYVKSHADERWATCHER
+	#include "./TinyVulkan.hpp"
+	#include <chrono>
+	#include <condition_variable>
+	#include <cstdlib>
+	#include <filesystem>
+	#include <thread>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT SHADER HOT RELOAD:
+				TinyVkShaderWatcher polls the write times of the SPIR-V files used by the graphics pipelines and compute renderers
+				it watches on its own thread (every pollInterval). When a file changes every pipeline variant using it is rebuilt in
+				the background (on the TinyVkPipelineCompiler if one is given, otherwise on the watcher thread) and staged. Running
+				pipelines are only swapped at a frame boundary, ApplyShaderReloads() at the start of RenderExecute()/RenderSwapChain()
+				/ComputeExecute(). A replaced graphics VkPipeline is retired once every renderer recording with the pipeline passed
+				its next frame boundary and the graphics queue's submissions up to then complete, a compute pipeline once the compute
+				queue's submissions made so far complete (TinyVkVulkanDevice::RetireResource(), call CollectRetiredResources() once per frame).
+
+				Shader sources can be watched with a compile command (e.g. "glslc sample.vert -o sample_vert.spv") which runs on the
+				watcher thread when the source changes, the rebuilt SPIR-V file is reloaded by the same poll. Compile commands and
+				rebuilds run without holding the watch lock, only disposing (unwatching) an object waits for a rebuild in progress.
+
+				A failed compile command is logged to std::cerr next to the compiler's own output. A failed reload (partially written
+				file, invalid SPIR-V or a shader using descriptor bindings/push constants not declared in the pipeline layout) fails the
+				reload's TinyVkPipelineHandle and is reported to the instance's debug messengers (TinyVkDebugUtils::SubmitMessage(),
+				printed by the validation messenger), the previous pipeline keeps running and the next write of the file retries.
+				Pipeline layouts are never reloaded.
+
+				VkPipelines/TinyVkPipelineHandles kept across frames go stale after a reload, re-request them every frame (GetVariant(),
+				RequestVariant(), GetGraphicsPipeline()). Command buffers recorded outside of the pipeline's renderers (which register
+				themselves, see TinyVkGraphicsPipeline::AddRecorder()) must be submitted before the next frame boundary of a renderer.
+				Either the watcher or what it watches may be disposed first.
+		*/
+
+		/// @brief Watches the shaders of graphics pipelines/compute renderers and rebuilds them when their files change (development hot reload).
+		class TinyVkShaderWatcher : public TinyVkDisposable {
+		private:
+			std::vector<TinyVkGraphicsPipeline*> pipelines;
+			std::vector<TinyVkComputeRenderer*> computeRenderers;
+			std::unordered_map<std::string, std::string> shaderSources; /// Source file -> compile command.
+			std::unordered_map<std::string, std::filesystem::file_time_type> writeTimes;
+			std::timed_mutex watch_lock;
+			std::timed_mutex reload_lock; /// Held while rebuilding, so Unwatch() returns only once nothing reloads the unwatched object.
+
+			TinyVkPipelineCompiler* pipelineCompiler;
+			std::chrono::milliseconds pollInterval;
+			std::thread watcher;
+			std::mutex wake_lock;
+			std::condition_variable wakeSignal;
+			bool stopping = false;
+
+			/// @brief Returns true if the file was written since the last check (files seen for the first time or missing are not changes).
+			bool HasChanged(const std::string& path) {
+				std::error_code error;
+				std::filesystem::file_time_type writeTime = std::filesystem::last_write_time(path, error);
+				if (error) return false;
+
+				auto known = writeTimes.find(path);
+				if (known == writeTimes.end()) {
+					writeTimes.emplace(path, writeTime);
+					return false;
+				}
+
+				if (known->second == writeTime) return false;
+				known->second = writeTime;
+				return true;
+			}
+
+			/// @brief Sets the detach callback the watched object calls when disposed (under its detach_lock).
+			template<typename W>
+			void SetDetach(W& watched, std::function<void()> detach) {
+				timed_guard<false> detachLock(watched.detach_lock);
+				watched.shaderWatcherDetach = detach;
+			}
+
+			void WatchLoop() {
+				std::unique_lock<std::mutex> wakeLock(wake_lock);
+				while(!stopping) {
+					if (wakeSignal.wait_for(wakeLock, pollInterval, [this]() { return stopping; })) return;
+
+					wakeLock.unlock();
+					Poll();
+					wakeLock.lock();
+				}
+			}
+
+		public:
+			TinyVkShaderWatcher operator=(const TinyVkShaderWatcher& watcher) = delete;
+
+			~TinyVkShaderWatcher() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				{
+					std::lock_guard<std::mutex> wakeLock(wake_lock);
+					stopping = true;
+				}
+				wakeSignal.notify_all();
+				if (watcher.joinable()) watcher.join();
+
+				timed_guard<false> watchLock(watch_lock);
+				for(TinyVkGraphicsPipeline* pipeline : pipelines) SetDetach(*pipeline, nullptr);
+				for(TinyVkComputeRenderer* renderer : computeRenderers) SetDetach(*renderer, nullptr);
+				pipelines.clear();
+				computeRenderers.clear();
+			}
+
+			/// @brief Starts the watcher thread, rebuilds run on the pipelineCompiler's threads (or the watcher thread if nullptr).
+			TinyVkShaderWatcher(TinyVkPipelineCompiler* pipelineCompiler = nullptr, std::chrono::milliseconds pollInterval = std::chrono::milliseconds(250))
+			: pipelineCompiler(pipelineCompiler), pollInterval(pollInterval) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+				watcher = std::thread([this]() { this->WatchLoop(); });
+			}
+
+			/// @brief Watches every SPIR-V file used by the pipeline and its variants.
+			void Watch(TinyVkGraphicsPipeline& pipeline) {
+				timed_guard<false> watchLock(watch_lock);
+				if (std::find(pipelines.begin(), pipelines.end(), &pipeline) != pipelines.end()) return;
+
+				pipelines.push_back(&pipeline);
+				SetDetach(pipeline, [this, &pipeline]() { this->Unwatch(pipeline); });
+				for(const std::string& path : pipeline.GetShaderPaths()) HasChanged(path);
+			}
+
+			/// @brief Watches the SPIR-V file of the compute renderer.
+			void Watch(TinyVkComputeRenderer& renderer) {
+				timed_guard<false> watchLock(watch_lock);
+				if (std::find(computeRenderers.begin(), computeRenderers.end(), &renderer) != computeRenderers.end()) return;
+
+				computeRenderers.push_back(&renderer);
+				SetDetach(renderer, [this, &renderer]() { this->Unwatch(renderer); });
+				HasChanged(renderer.GetShaderPath());
+			}
+
+			/// @brief Watches a shader source file and runs the compile command (producing a watched SPIR-V file) when it changes.
+			void WatchSource(const std::string& sourcePath, const std::string& compileCommand) {
+				timed_guard<false> watchLock(watch_lock);
+				shaderSources[sourcePath] = compileCommand;
+				HasChanged(sourcePath);
+			}
+
+			/// @brief Stops watching the pipeline (waits for a rebuild of it running on the watcher thread).
+			void Unwatch(TinyVkGraphicsPipeline& pipeline) {
+				timed_guard<false> reloadLock(reload_lock);
+				timed_guard<false> watchLock(watch_lock);
+				std::erase(pipelines, &pipeline);
+				SetDetach(pipeline, nullptr);
+			}
+
+			/// @brief Stops watching the compute renderer (waits for a rebuild of it running on the watcher thread).
+			void Unwatch(TinyVkComputeRenderer& renderer) {
+				timed_guard<false> reloadLock(reload_lock);
+				timed_guard<false> watchLock(watch_lock);
+				std::erase(computeRenderers, &renderer);
+				SetDetach(renderer, nullptr);
+			}
+
+			/// @brief Checks every watched file once, compiles changed sources and rebuilds whatever uses changed SPIR-V files. Returns the number of pipelines/renderers rebuilding.
+			/// Compile commands and rebuilds run outside of watch_lock (Watch()/WatchSource() never wait on them), Unwatch() waits for the rebuilds.
+			size_t Poll() {
+				TINYVK_TRACE_SCOPE_CATEGORY("TinyVkShaderWatcher::Poll", "tinyvk");
+				std::vector<std::string> compileCommands;
+				{
+					timed_guard<false> watchLock(watch_lock);
+					for(auto& source : shaderSources)
+						if (HasChanged(source.first)) compileCommands.push_back(source.second);
+				}
+
+				for(const std::string& command : compileCommands) {
+					int result = std::system(command.c_str());
+					if (result != 0) std::cerr << "TinyVulkan: Shader compile failed (" << result << "): " << command << std::endl;
+				}
+
+				timed_guard<false> reloadLock(reload_lock);
+				std::vector<std::string> changedPaths;
+				std::vector<TinyVkGraphicsPipeline*> reloadPipelines;
+				std::vector<TinyVkComputeRenderer*> reloadRenderers;
+				{
+					timed_guard<false> watchLock(watch_lock);
+					auto checkPath = [this, &changedPaths](const std::string& path) {
+						if (std::find(changedPaths.begin(), changedPaths.end(), path) == changedPaths.end() && HasChanged(path)) changedPaths.push_back(path);
+					};
+					for(TinyVkGraphicsPipeline* pipeline : pipelines)
+						for(const std::string& path : pipeline->GetShaderPaths()) checkPath(path);
+					for(TinyVkComputeRenderer* renderer : computeRenderers) checkPath(renderer->GetShaderPath());
+					if (changedPaths.empty()) return 0;
+
+					reloadPipelines = pipelines;
+					reloadRenderers = computeRenderers;
+				}
+
+				#if TVK_VALIDATION_LAYERS
+				for(const std::string& path : changedPaths) std::cout << "TinyVulkan: Reloading Shader @ " << path << std::endl;
+				#endif
+
+				size_t reloads = 0;
+				for(TinyVkGraphicsPipeline* pipeline : reloadPipelines)
+					if (pipeline->ReloadShaders(changedPaths, pipelineCompiler)) reloads ++;
+				for(TinyVkComputeRenderer* renderer : reloadRenderers)
+					if (renderer->ReloadShaders(changedPaths, pipelineCompiler)) reloads ++;
+				return reloads;
+			}
+		};
+	}
+#endif
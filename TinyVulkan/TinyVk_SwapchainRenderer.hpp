@@ -18,6 +18,10 @@
 		///		Call RenderExecute(mutex[optional]) to render to the swap chain image.
 		///			All swap chain rendering is done via render events and does not accept pre-recorded command buffers.
 		///			The command buffer will be returned to the command pool queue after execution.
+		///			Frames are pipelined: render events record into a per-frame target while previous frames are still on the GPU,
+		///			the swapchain image is acquired just before submission and the frame target is copied into it for presenting.
+		///			With directRendering the image is acquired before recording and rendered to directly (no copy, but the CPU may
+		///			block in the acquire before it has recorded anything).
 		///	
 		///	Why? This rendering paradigm allows the swap chain to effectively manage and synchronize its own resources
 		///	minimizing screen rendering errors or validation layer errors.
@@ -36,17 +40,34 @@
 			VkExtent2D imageExtent;
 			VkImageUsageFlags imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT;
 			TinyVkBufferingMode bufferingMode;
+			size_t framesInFlight;
 			
+			/// Per-Swapchain-Image resources (sized by the image count returned by the driver).
 			std::vector<TinyVkImage*> imageSources;
+			std::vector<VkSemaphore> imageFinished;
+
+			/// Per-Frame-In-Flight resources (sized by framesInFlight).
+			std::vector<TinyVkImage*> imageFrameTargets; /// Created on the first frame rendered without directRendering.
 			std::vector<TinyVkImage*> imageDepthSources;
 			std::vector<VkSemaphore> imageAvailable;
-			std::vector<VkSemaphore> imageFinished;
-			std::vector<VkFence> imageInFlight;
+			std::vector<TinyVkTimelinePoint> imageInFlight;
 			std::vector<TinyVkCommandPool*> imageCmdPools;
 
+			/// Swapchains replaced by a resize, destroyed once the last graphics submission and present made before their replacement complete.
+			struct TinyVkRetiredSwapchain {
+				TinyVkTimelinePoint graphicsPoint;
+				TinyVkTimelinePoint presentPoint;
+				VkSwapchainKHR swapChain;
+				std::vector<TinyVkImage*> imageSources;
+				std::vector<VkSemaphore> imageFinished;
+			};
+			std::vector<TinyVkRetiredSwapchain> retiredSwapchains;
+
 			uint32_t currentSyncFrame = 0; // Current Synchronized Frame (Ordered).
 			uint32_t currentSwapFrame = 0; // Current SwapChain Image Frame (Out of Order).
 			std::atomic_bool presentable, refreshable;
+			std::atomic_uint32_t pendingWidth, pendingHeight; // Latest (coalesced) frame buffer size requested by resize events.
+			VkPipelineStageFlags2 acquireWaitStage = VK_PIPELINE_STAGE_2_COPY_BIT; // First stage of the frame touching the acquired image.
 
 			#pragma region SWAPCHAIN_CREATION_AND_RECREATION
 			
@@ -55,8 +76,8 @@
 				TinyVkSwapChainSupporter swapChainSupport = QuerySwapChainSupport(renderContext.vkdevice.GetPhysicalDevice());
 				VkSurfaceFormatKHR surfaceFormat = QuerySwapSurfaceFormat(swapChainSupport.formats);
 				VkPresentModeKHR presentMode = QuerySwapPresentMode(swapChainSupport.presentModes);
-				VkExtent2D extent = QuerySwapExtent(swapChainSupport.capabilities);
-				uint32_t imageCount = std::min(swapChainSupport.capabilities.maxImageCount, std::max(swapChainSupport.capabilities.minImageCount, static_cast<uint32_t>(bufferingMode)));
+				VkExtent2D extent;
+				uint32_t imageCount = std::max(swapChainSupport.capabilities.minImageCount, static_cast<uint32_t>(bufferingMode));
 
 				if (width != 0 && height != 0) {
 					extent = {
@@ -113,7 +134,7 @@
 
 				imageSources.resize(imageCount);
 				for(uint32_t i = 0; i < imageCount; i++)
-					imageSources[i] = new TinyVkImage(renderContext, TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN, extent.width, extent.height, newSwapImages[i], VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE);
+					imageSources[i] = new TinyVkImage(renderContext, TinyVkImageType::TINYVK_IMAGE_TYPE_SWAPCHAIN, extent.width, extent.height, newSwapImages[i], VK_NULL_HANDLE, VK_NULL_HANDLE);
 
 				imageFormat = surfaceFormat.format;
 				imageExtent = extent;
@@ -144,6 +165,10 @@
 
 					if (vkCreateImageView(renderContext.vkdevice.GetLogicalDevice(), &createInfo, VK_NULL_HANDLE, &imageSources[i]->imageView) != VK_SUCCESS)
 						throw TinyVkRuntimeError("TinyVulkan: Failed to create swap chain image views!");
+
+					#if TVK_DEBUG_UTILS
+						imageSources[i]->SetDebugName("TinyVkSwapchainRenderer::imageSources[" + std::to_string(i) + "]");
+					#endif
 				}
 			}
 
@@ -151,32 +176,86 @@
 			void CreateSwapChain(uint32_t width = 0, uint32_t height = 0) {
 				CreateSwapChainImages(width, height);
 				CreateSwapChainImageViews();
+				CreatePresentSyncObjects();
+			}
+
+			/// @brief Returns the timeline points after which the current swapchain's images and present semaphores are no longer in use.
+			/// Presents do not signal the timeline, an empty submission to the present queue after the last present stands in for them (queue order).
+			std::pair<TinyVkTimelinePoint, TinyVkTimelinePoint> GetSwapchainLastUse() {
+				TinyVkTimelinePoint graphicsPoint = renderContext.vkdevice.GetGraphicsTimeline().GetSubmittedPoint();
+				TinyVkTimelinePoint presentPoint = renderContext.vkdevice.GetPresentTimeline().Submit({});
+				return std::pair(graphicsPoint, presentPoint);
+			}
+
+			/// @brief Recreates the swapchain (passing the current one as oldSwapchain) without waiting on the device, the old swapchain is retired instead.
+			void ReCreateSwapChain(uint32_t width, uint32_t height) {
+				std::pair<TinyVkTimelinePoint, TinyVkTimelinePoint> lastUse = GetSwapchainLastUse();
+				retiredSwapchains.push_back({ lastUse.first, lastUse.second, swapChain, imageSources, imageFinished });
+				imageSources.clear();
+				imageFinished.clear();
+
+				CreateSwapChain(width, height);
+				presentable = true;
+				onResizeFrameBuffer.invoke(imageExtent.width, imageExtent.height);
 			}
 
-			/// @brief Creates the synchronization semaphores/fences for swapchain multi-frame buffering.
+			/// @brief Destroys retired swapchains whose graphics and present timeline points completed (forced: waits on them on the CPU first).
+			void CollectRetiredSwapchains(bool force = false) {
+				std::erase_if(retiredSwapchains, [this, force](TinyVkRetiredSwapchain& retired) {
+					if (force) {
+						retired.graphicsPoint.Wait(UINT64_MAX, "TinyVkSwapchainRenderer::CollectRetiredSwapchains");
+						retired.presentPoint.Wait(UINT64_MAX, "TinyVkSwapchainRenderer::CollectRetiredSwapchains");
+					} else if (!retired.graphicsPoint.IsComplete() || !retired.presentPoint.IsComplete()) return false;
+
+					for(TinyVkImage* image : retired.imageSources) {
+						vkDestroyImageView(renderContext.vkdevice.GetLogicalDevice(), image->imageView, VK_NULL_HANDLE);
+						delete image;
+					}
+
+					for(VkSemaphore semaphore : retired.imageFinished)
+						vkDestroySemaphore(renderContext.vkdevice.GetLogicalDevice(), semaphore, VK_NULL_HANDLE);
+
+					vkDestroySwapchainKHR(renderContext.vkdevice.GetLogicalDevice(), retired.swapChain, VK_NULL_HANDLE);
+					return true;
+				});
+			}
+
+			/// @brief Creates the binary acquire semaphores for each frame in flight (frames in flight are tracked on the graphics timeline).
 			void CreateImageSyncObjects() {
-				size_t count = static_cast<size_t>(bufferingMode);
-				imageAvailable.resize(count);
-				imageFinished.resize(count);
-				imageInFlight.resize(count);
+				imageAvailable.resize(framesInFlight);
+				imageInFlight.resize(framesInFlight);
 
 				VkSemaphoreCreateInfo semaphoreInfo{};
 				semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
 
-				VkFenceCreateInfo fenceInfo{};
-				fenceInfo.sType = VK_STRUCTURE_TYPE_FENCE_CREATE_INFO;
-				fenceInfo.flags = VK_FENCE_CREATE_SIGNALED_BIT;
-
-				for (size_t i = 0; i < imageSources.size(); i++) {
-					if (vkCreateSemaphore(renderContext.vkdevice.GetLogicalDevice(), &semaphoreInfo, VK_NULL_HANDLE, &imageAvailable[i]) != VK_SUCCESS ||
-						vkCreateSemaphore(renderContext.vkdevice.GetLogicalDevice(), &semaphoreInfo, VK_NULL_HANDLE, &imageFinished[i]) != VK_SUCCESS ||
-						vkCreateFence(renderContext.vkdevice.GetLogicalDevice(), &fenceInfo, VK_NULL_HANDLE, &imageInFlight[i]) != VK_SUCCESS)
+				for (size_t i = 0; i < framesInFlight; i++)
+					if (vkCreateSemaphore(renderContext.vkdevice.GetLogicalDevice(), &semaphoreInfo, VK_NULL_HANDLE, &imageAvailable[i]) != VK_SUCCESS)
 						throw TinyVkRuntimeError("TinyVulkan: Failed to create synchronization objects for a frame!");
-					
-					imageSources[i]->imageAvailable = imageAvailable[i];
-					imageSources[i]->imageFinished = imageFinished[i];
-					imageSources[i]->imageWaitable = imageInFlight[i];
-				}
+
+				#if TVK_DEBUG_UTILS
+					for (size_t i = 0; i < framesInFlight; i++)
+						TinyVkDebugUtils::SetObjectName(renderContext.vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_SEMAPHORE, imageAvailable[i], "TinyVkSwapchainRenderer::imageAvailable[" + std::to_string(i) + "]");
+				#endif
+			}
+
+			/// @brief Creates the binary present semaphores for each swapchain image (an image's semaphore is only reused once that image is re-acquired).
+			void CreatePresentSyncObjects() {
+				for(VkSemaphore semaphore : imageFinished)
+					vkDestroySemaphore(renderContext.vkdevice.GetLogicalDevice(), semaphore, VK_NULL_HANDLE);
+				
+				imageFinished.resize(imageSources.size());
+
+				VkSemaphoreCreateInfo semaphoreInfo{};
+				semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+
+				for (size_t i = 0; i < imageFinished.size(); i++)
+					if (vkCreateSemaphore(renderContext.vkdevice.GetLogicalDevice(), &semaphoreInfo, VK_NULL_HANDLE, &imageFinished[i]) != VK_SUCCESS)
+						throw TinyVkRuntimeError("TinyVulkan: Failed to create synchronization objects for a swapchain image!");
+
+				#if TVK_DEBUG_UTILS
+					for (size_t i = 0; i < imageFinished.size(); i++)
+						TinyVkDebugUtils::SetObjectName(renderContext.vkdevice.GetLogicalDevice(), VK_OBJECT_TYPE_SEMAPHORE, imageFinished[i], "TinyVkSwapchainRenderer::imageFinished[" + std::to_string(i) + "]");
+				#endif
 			}
 
 			#pragma endregion
@@ -243,15 +322,100 @@
 			#pragma endregion
 			#pragma region RENDER_SUBMISSION_AND_EXECUTION
 			
-			/// @brief Acquires the next image from the swap chain and returns out that image index.
+			/// @brief Blocks only if this frame slot's previous submission is still in flight (its command pool, frame target and depth image are about to be reused).
+			VkResult WaitFrameReuse() {
+				TINYVK_TRACE_SCOPE_CATEGORY("TinyVkSwapchainRenderer::WaitFrameReuse", "tinyvk");
+				VkResult result = imageInFlight[currentSyncFrame].Wait(UINT64_MAX, "TinyVkSwapchainRenderer::WaitFrameReuse");
+				if (result != VK_SUCCESS) return result;
+
+				renderContext.vkdevice.CollectRetiredResources();
+				CollectRetiredSwapchains();
+				if (directRendering) return VK_SUCCESS;
+
+				if (imageFrameTargets.size() == 0)
+					for(size_t i = 0; i < framesInFlight; i++) {
+						imageFrameTargets.push_back(new TinyVkImage(renderContext, TinyVkImageType::TINYVK_IMAGE_TYPE_COLORATTACHMENT, imageExtent.width, imageExtent.height, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, imageFormat, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE));
+						#if TVK_DEBUG_UTILS
+							imageFrameTargets[i]->SetDebugName("TinyVkSwapchainRenderer::imageFrameTargets[" + std::to_string(i) + "]");
+						#endif
+					}
+
+				TinyVkImage* frameTarget = imageFrameTargets[currentSyncFrame];
+				if (frameTarget->width != imageExtent.width || frameTarget->height != imageExtent.height) {
+					frameTarget->Disposable(false);
+					frameTarget->ReCreateImage(frameTarget->imageType, imageExtent.width, imageExtent.height, imageFormat, VK_SAMPLER_ADDRESS_MODE_CLAMP_TO_EDGE);
+				}
+				return VK_SUCCESS;
+			}
+
+			/// @brief Acquires the next image from the swap chain and returns out that image index (reports stalls/times out like the present queue's timeline waits).
 			VkResult QueryNextImage() {
-				vkWaitForFences(renderContext.vkdevice.GetLogicalDevice(), 1, &imageInFlight[currentSyncFrame], VK_TRUE, UINT64_MAX);
-				vkResetFences(renderContext.vkdevice.GetLogicalDevice(), 1, &imageInFlight[currentSyncFrame]);
-				return vkAcquireNextImageKHR(renderContext.vkdevice.GetLogicalDevice(), swapChain, UINT64_MAX, imageAvailable[currentSyncFrame], VK_NULL_HANDLE, &currentSwapFrame);
+				TINYVK_TRACE_SCOPE_CATEGORY("TinyVkSwapchainRenderer::QueryNextImage", "tinyvk");
+				TinyVkTimeline& presentTimeline = renderContext.vkdevice.GetPresentTimeline();
+				uint64_t threshold = presentTimeline.GetStallThreshold(), timeout = presentTimeline.GetWaitTimeout(), waitedNs = 0;
+				auto acquireStart = std::chrono::steady_clock::now();
+
+				while(true) {
+					VkResult result = vkAcquireNextImageKHR(renderContext.vkdevice.GetLogicalDevice(), swapChain, std::min(threshold, timeout - waitedNs), imageAvailable[currentSyncFrame], VK_NULL_HANDLE, &currentSwapFrame);
+					if (result != VK_TIMEOUT && result != VK_NOT_READY) return result;
+
+					waitedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - acquireStart).count());
+					bool timedOut = waitedNs >= timeout;
+					presentTimeline.ReportStall({ "TinyVkSwapchainRenderer::QueryNextImage", presentTimeline.GetQueueFamily(), 0, presentTimeline.GetCompletedValue(), presentTimeline.GetSubmittedValue(), waitedNs, timedOut });
+					if (timedOut) return VK_TIMEOUT;
+				}
+			}
+
+			/// @brief Records the copy of the frame target into the acquired swapchain image and its transition to present.
+			VkCommandBuffer RecordPresentCopy() {
+				TinyVkImage* frameTarget = imageFrameTargets[currentSyncFrame];
+				TinyVkImage* swapImage = imageSources[currentSwapFrame];
+				VkCommandBuffer commandBuffer = imageCmdPools[currentSyncFrame]->LeaseBuffer().first;
+
+				VkCommandBufferBeginInfo beginInfo{};
+				beginInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO;
+				beginInfo.flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT;
+				if (vkBeginCommandBuffer(commandBuffer, &beginInfo) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to record [begin] to present command buffer!");
+				if (renderContext.gpuProfiler != nullptr) renderContext.gpuProfiler->BeginScope(commandBuffer, gpuScopeName + "::PresentCopy");
+
+				TinyVkBarrierBatch barrierBatch;
+				barrierBatch.Image(frameTarget->image, VK_IMAGE_ASPECT_COLOR_BIT, (VkImageLayout) frameTarget->imageLayout, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL,
+					VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_READ_BIT);
+				barrierBatch.Image(swapImage->image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_UNDEFINED, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL,
+					VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_NONE, VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT);
+				barrierBatch.Flush(commandBuffer);
+
+				VkImageCopy region = {
+					.srcSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 }, .srcOffset = { 0, 0, 0 },
+					.dstSubresource = { VK_IMAGE_ASPECT_COLOR_BIT, 0, 0, 1 }, .dstOffset = { 0, 0, 0 },
+					.extent = { static_cast<uint32_t>(std::min(frameTarget->width, swapImage->width)), static_cast<uint32_t>(std::min(frameTarget->height, swapImage->height)), 1 }
+				};
+				vkCmdCopyImage(commandBuffer, frameTarget->image, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, swapImage->image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
+
+				barrierBatch.Image(frameTarget->image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_SRC_OPTIMAL, (VkImageLayout) frameTarget->imageLayout,
+					VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_NONE, VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT, VK_ACCESS_2_COLOR_ATTACHMENT_WRITE_BIT);
+				barrierBatch.Image(swapImage->image, VK_IMAGE_ASPECT_COLOR_BIT, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_PRESENT_SRC_KHR,
+					VK_PIPELINE_STAGE_2_COPY_BIT, VK_ACCESS_2_TRANSFER_WRITE_BIT, VK_PIPELINE_STAGE_2_NONE, VK_ACCESS_2_NONE);
+				barrierBatch.Flush(commandBuffer);
+				swapImage->imageLayout = TinyVkImageLayout::TINYVK_PRESENT_SRC;
+
+				if (renderContext.gpuProfiler != nullptr) renderContext.gpuProfiler->EndScope(commandBuffer);
+				if (vkEndCommandBuffer(commandBuffer) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to record [end] to present command buffer!");
+				return commandBuffer;
+			}
+
+			/// @brief Submits the frame's command buffers waiting on the acquire semaphore and signaling the present semaphore.
+			TinyVkTimelinePoint SubmitRenderCommands(const std::vector<VkCommandBuffer>& commandBuffers) override {
+				TinyVkSemaphoreWait acquireWait = { imageAvailable[currentSyncFrame], 0, acquireWaitStage };
+				imageInFlight[currentSyncFrame] = renderContext.vkdevice.GetGraphicsTimeline().Submit(commandBuffers, { acquireWait }, { imageFinished[currentSwapFrame] });
+				imageSources[currentSwapFrame]->lastUse = imageInFlight[currentSyncFrame];
+				return imageInFlight[currentSyncFrame];
 			}
 
 			VkResult RenderPresent() {
-				VkSemaphore signalSemaphores[] = { renderTarget->imageFinished };
+				VkSemaphore signalSemaphores[] = { imageFinished[currentSwapFrame] };
 				
 				VkPresentInfoKHR presentInfo{};
 				presentInfo.sType = VK_STRUCTURE_TYPE_PRESENT_INFO_KHR;
@@ -263,34 +427,54 @@
 				presentInfo.pSwapchains = swapChainList;
 				presentInfo.pImageIndices = &currentSwapFrame;
 
-				currentSyncFrame = (currentSyncFrame + 1) % static_cast<size_t>(imageSources.size());
-				return vkQueuePresentKHR(renderContext.graphicsPipeline.GetPresentQueue(), &presentInfo);
+				currentSyncFrame = (currentSyncFrame + 1) % static_cast<uint32_t>(framesInFlight);
+				renderContext.vkdevice.GetGraphicsTimeline().Flush(); // Binary semaphore signals must be submitted before the present waits on them.
+				return renderContext.vkdevice.GetPresentTimeline().Present(presentInfo);
 			}
 
+			/// @brief Pipelined frame: wait on frame reuse -> record -> acquire (late) -> copy -> submit -> present.
+			/// With directRendering: wait on frame reuse -> acquire -> record into the swapchain image -> submit -> present.
 			VkResult RenderSwapChain() {
-				if (refreshable) { OnFrameBufferResizeCallbackNoLock(window.hwndWindow, window.hwndWidth, window.hwndHeight); return VK_SUBOPTIMAL_KHR; }
-				if (!presentable) return VK_ERROR_OUT_OF_DATE_KHR;
-				
-				VkResult result = QueryNextImage();
-				TinyVkImage* swapDepthImage = (renderContext.graphicsPipeline.DepthTestingIsEnabled())? imageDepthSources[currentSyncFrame]: VK_NULL_HANDLE;
+				if (refreshable) {
+					if (pendingWidth == 0 || pendingHeight == 0) return VK_ERROR_OUT_OF_DATE_KHR;
+					refreshable = false;
+					ReCreateSwapChain(pendingWidth, pendingHeight);
+				}
 				
-				imageSources[currentSwapFrame]->imageAvailable = imageAvailable[currentSyncFrame];
-				imageSources[currentSwapFrame]->imageFinished = imageFinished[currentSyncFrame];
-				imageSources[currentSwapFrame]->imageWaitable = imageInFlight[currentSyncFrame];
+				if (!presentable) return VK_ERROR_OUT_OF_DATE_KHR;
 				
-				this->SetRenderTarget(imageCmdPools[currentSyncFrame], imageSources[currentSwapFrame], swapDepthImage, false);
+				VkResult result = WaitFrameReuse();
+				if (result != VK_SUCCESS) return result;
+				renderContext.graphicsPipeline.ApplyShaderReloads(this);
 
-				if (result == VK_SUCCESS) {
-					result = this->TinyVkGraphicsRenderer::RenderExecute(false);
-					if (result == VK_SUCCESS)
-						result = this->RenderPresent();
+				bool direct = directRendering;
+				TinyVkImage* swapDepthImage = (renderContext.graphicsPipeline.DepthTestingIsEnabled())? imageDepthSources[currentSyncFrame]: VK_NULL_HANDLE;
+				std::vector<VkCommandBuffer> commandBuffers;
+				if (!direct) {
+					this->SetRenderTarget(imageCmdPools[currentSyncFrame], imageFrameTargets[currentSyncFrame], swapDepthImage, false);
+					commandBuffers = this->RecordRenderCommands();
 				}
+
+				result = QueryNextImage();
+				if (result == VK_SUCCESS || result == VK_SUBOPTIMAL_KHR) {
+					if (direct) {
+						this->SetRenderTarget(imageCmdPools[currentSyncFrame], imageSources[currentSwapFrame], swapDepthImage, false);
+						commandBuffers = this->RecordRenderCommands();
+					} else commandBuffers.push_back(RecordPresentCopy());
+
+					acquireWaitStage = (direct)? VK_PIPELINE_STAGE_2_COLOR_ATTACHMENT_OUTPUT_BIT : VK_PIPELINE_STAGE_2_COPY_BIT;
+					this->TrackRenderSubmission(SubmitRenderCommands(commandBuffers));
+					VkResult presentResult = this->RenderPresent();
+					if (result == VK_SUCCESS || presentResult != VK_SUCCESS) result = presentResult;
+				} else if (!direct) this->DiscardRenderCommands();
 				
 				if (result == VK_ERROR_OUT_OF_DATE_KHR) {
-					imageCmdPools[currentSyncFrame]->ReturnAllBuffers();
+					// Recreated at the latest frame buffer size on the next frame, also when the driver reports it without a resize event.
 					presentable = false;
-					currentSyncFrame = 0;
-				} else if (result != VK_SUCCESS && result != VK_SUBOPTIMAL_KHR)
+					refreshable = true;
+				} else if (result == VK_SUBOPTIMAL_KHR) {
+					refreshable = true;
+				} else if (result != VK_SUCCESS && result != VK_TIMEOUT)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to acquire swap chain image or submit to draw queue!");
 				
 				return result;
@@ -302,18 +486,32 @@
 
 			inline static TinyVkInvokable<int, int> onResizeFrameBuffer;
 
+			/// Acquires the swapchain image before recording and renders into it directly instead of recording into a per-frame target
+			/// and copying it into an image acquired just before submission. Saves the full-screen copy, but the CPU may block in
+			/// vkAcquireNextImageKHR before recording (FIFO with every image queued) instead of recording while the images are busy.
+			bool directRendering = false;
+
 			TinyVkSwapchainRenderer operator=(const TinyVkSwapchainRenderer& swapRenderer) = delete;
 
 			~TinyVkSwapchainRenderer() { this->Dispose(); }
 
 			void Disposable(bool waitIdle) {
-				if (waitIdle) renderContext.vkdevice.DeviceWaitIdle();
+				if (waitIdle) {
+					renderContext.vkdevice.DeviceWaitIdle();
+				} else {
+					std::pair<TinyVkTimelinePoint, TinyVkTimelinePoint> lastUse = GetSwapchainLastUse();
+					lastUse.first.Wait(UINT64_MAX, "TinyVkSwapchainRenderer::Disposable");
+					lastUse.second.Wait(UINT64_MAX, "TinyVkSwapchainRenderer::Disposable");
+				}
 
-				if (renderContext.graphicsPipeline.DepthTestingIsEnabled()) {
-					for(size_t i = 0; i < static_cast<size_t>(bufferingMode); i++) {
-						imageDepthSources[i]->Dispose();
-						delete imageDepthSources[i];
-					}
+				for(TinyVkImage* depthImage : imageDepthSources) {
+					depthImage->Dispose();
+					delete depthImage;
+				}
+
+				for(TinyVkImage* frameTarget : imageFrameTargets) {
+					frameTarget->Dispose();
+					delete frameTarget;
 				}
 
 				for (TinyVkCommandPool* cmdPool : imageCmdPools) {
@@ -321,11 +519,13 @@
 					delete cmdPool;
 				}
 
-				for (size_t i = 0; i < imageInFlight.size(); i++) {
-					vkDestroySemaphore(renderContext.vkdevice.GetLogicalDevice(), imageAvailable[i], VK_NULL_HANDLE);
-					vkDestroySemaphore(renderContext.vkdevice.GetLogicalDevice(), imageFinished[i], VK_NULL_HANDLE);
-					vkDestroyFence(renderContext.vkdevice.GetLogicalDevice(), imageInFlight[i], VK_NULL_HANDLE);
-				}
+				for(VkSemaphore semaphore : imageAvailable)
+					vkDestroySemaphore(renderContext.vkdevice.GetLogicalDevice(), semaphore, VK_NULL_HANDLE);
+
+				for(VkSemaphore semaphore : imageFinished)
+					vkDestroySemaphore(renderContext.vkdevice.GetLogicalDevice(), semaphore, VK_NULL_HANDLE);
+
+				CollectRetiredSwapchains(true);
 
 				for(auto image : imageSources) {
 					vkDestroyImageView(renderContext.vkdevice.GetLogicalDevice(), image->imageView, VK_NULL_HANDLE);
@@ -336,62 +536,69 @@
 			}
 
 			/// @brief Creates a renderer specifically for performing render commands on a TinyVkSwapChain (VkSwapChain) to present to the window.
-			TinyVkSwapchainRenderer(TinyVkRenderContext& renderContext, TinyVkWindow& window, const TinyVkBufferingMode bufferingMode, size_t cmdpoolbuffercount = TinyVkCommandPool::GetDefaultPoolSize(), TinyVkSurfaceSupporter presentDetails = TinyVkSurfaceSupporter(), VkImageUsageFlags imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT)
-				: window(window), bufferingMode(bufferingMode), presentDetails(presentDetails), imageUsage(imageUsage), presentable(true), TinyVkGraphicsRenderer(renderContext, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE) {
+			/// @param bufferingMode Requested number of swapchain images (the driver may return more).
+			/// @param framesInFlight Number of frames the CPU may record ahead of the GPU (0 = match bufferingMode), e.g. 2 frames in flight over a TRIPLE buffered mailbox swapchain.
+			TinyVkSwapchainRenderer(TinyVkRenderContext& renderContext, TinyVkWindow& window, const TinyVkBufferingMode bufferingMode, size_t cmdpoolbuffercount = TinyVkCommandPool::GetDefaultPoolSize(), TinyVkSurfaceSupporter presentDetails = TinyVkSurfaceSupporter(), VkImageUsageFlags imageUsage = VK_IMAGE_USAGE_COLOR_ATTACHMENT_BIT, size_t framesInFlight = 0)
+				: window(window), bufferingMode(bufferingMode), framesInFlight((framesInFlight > 0)? framesInFlight : static_cast<size_t>(bufferingMode)), presentDetails(presentDetails), imageUsage(imageUsage | VK_IMAGE_USAGE_TRANSFER_DST_BIT), presentable(true), TinyVkGraphicsRenderer(renderContext, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE) {
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
-				onResizeFrameBuffer.hook(TinyVkCallback<int, int>([this](int, int){ this->RenderSwapChain(); }));
+				gpuScopeName = "TinyVkSwapchainRenderer";
+				renderStats.name = "TinyVkSwapchainRenderer";
 				window.onResizeFrameBuffer.hook(TinyVkCallback<GLFWwindow*, int, int>([this](GLFWwindow* w, int x, int y) { this->OnFrameBufferResizeCallback(w, x, y); }));
 				imageExtent = (VkExtent2D) { static_cast<uint32_t>(window.hwndWidth), static_cast<uint32_t>(window.hwndHeight) };
+				pendingWidth = imageExtent.width;
+				pendingHeight = imageExtent.height;
 
-				for(size_t i = 0; i < static_cast<size_t>(bufferingMode); i++)
+				for(size_t i = 0; i < this->framesInFlight; i++)
 					imageCmdPools.push_back(new TinyVkCommandPool(renderContext.vkdevice, false, cmdpoolbuffercount));
 				
 				if (renderContext.graphicsPipeline.DepthTestingIsEnabled())
-					for(size_t i = 0; i < static_cast<size_t>(bufferingMode); i++)
-						imageDepthSources.push_back(new TinyVkImage(renderContext, TinyVkImageType::TINYVK_IMAGE_TYPE_DEPTHSTENCIL, imageExtent.width, imageExtent.height, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, renderContext.graphicsPipeline.QueryDepthFormat(), VK_SAMPLER_ADDRESS_MODE_REPEAT));
+					for(size_t i = 0; i < this->framesInFlight; i++)
+						imageDepthSources.push_back(new TinyVkImage(renderContext, TinyVkImageType::TINYVK_IMAGE_TYPE_DEPTHSTENCIL, imageExtent.width, imageExtent.height, VK_NULL_HANDLE, VK_NULL_HANDLE, VK_NULL_HANDLE, renderContext.graphicsPipeline.QueryDepthFormat(), VK_SAMPLER_ADDRESS_MODE_REPEAT));
 				
 				CreateSwapChain();
 				CreateImageSyncObjects();
+
+				#if TVK_DEBUG_UTILS
+					for(size_t i = 0; i < this->framesInFlight; i++) {
+						imageCmdPools[i]->SetDebugName("TinyVkSwapchainRenderer::imageCmdPools[" + std::to_string(i) + "]");
+						if (i < imageDepthSources.size()) imageDepthSources[i]->SetDebugName("TinyVkSwapchainRenderer::imageDepthSources[" + std::to_string(i) + "]");
+					}
+				#endif
 			}
 
 			#pragma region SWAPCHAIN_RESIZE_CALLBACKS
 			
 			/// @brief Notify the render engine that the window's frame buffer needs to be refreshed (without thread locking).
+			/// Resize events are coalesced: only the latest size is stored and the swapchain is recreated once at the start of the next frame.
 			void OnFrameBufferResizeCallbackNoLock(GLFWwindow* hwndWindow, int width, int height) {
 				if (hwndWindow != window.hwndWindow) return;
 
-				if (width > 0 && height > 0) {
-					renderContext.vkdevice.DeviceWaitIdle();
-
-					for(auto swapImage : imageSources) {
-						vkDestroyImageView(renderContext.vkdevice.GetLogicalDevice(), swapImage->imageView, VK_NULL_HANDLE);
-						delete swapImage;
-					}
-
-					VkSwapchainKHR oldSwapChain = swapChain;
-					CreateSwapChain(width, height);
-					vkDestroySwapchainKHR(renderContext.vkdevice.GetLogicalDevice(), oldSwapChain, VK_NULL_HANDLE);
-
-					presentable = true;
-					refreshable = false;
-					imageExtent = (VkExtent2D) { static_cast<uint32_t>(width), static_cast<uint32_t>(height) };
-					onResizeFrameBuffer.invoke(imageExtent.width, imageExtent.height);
-				}
+				pendingWidth = static_cast<uint32_t>(std::max(width, 0));
+				pendingHeight = static_cast<uint32_t>(std::max(height, 0));
+				refreshable = true;
 			}
 			
 			/// @brief Notify the render engine that the window's frame buffer needs to be refreshed (with thread locking).
+			/// If the renderer is idle (e.g. the main thread is blocked in a window resize loop) a frame is rendered at the new size immediately.
 			void OnFrameBufferResizeCallback(GLFWwindow* hwndWindow, int width, int height) {
-				timed_guard<true> swapChainLock(swapChainMutex);
-				if (!swapChainLock.Acquired()) return;
 				OnFrameBufferResizeCallbackNoLock(hwndWindow, width, height);
+				
+				timed_guard<true, 0> swapChainLock(swapChainMutex);
+				if (swapChainLock.Acquired()) RenderSwapChain();
 			}
 
 			#pragma endregion
 			#pragma region REFERENCE_GETTERS
 			
-			/// @brief Returns the current resource synchronized frame index.
+			/// @brief Returns the current resource synchronized frame index (0 to GetFramesInFlight() - 1).
 			uint32_t GetSyncronizedFrameIndex() { return currentSyncFrame; }
 			
+			/// @brief Returns the number of frames the CPU may record ahead of the GPU.
+			size_t GetFramesInFlight() { return framesInFlight; }
+			
+			/// @brief Returns the number of images in the swapchain (may differ from the requested TinyVkBufferingMode).
+			size_t GetSwapchainImageCount() { return imageSources.size(); }
+			
 			/// @brief Returns reference to presentable atomic_bool (whether swapchain is presentable or not).
 			std::atomic_bool& GetPresentableBool() { return presentable; }
 			
@@ -410,7 +617,9 @@
 			}
 
 			/// @brief Executes the registered onRenderEvents and presents them to the SwapChain(Window).
-			VkResult RenderExecute(bool waitFences = true) override {
+			VkResult RenderExecute(bool waitLastUse = true) override {
+				TINYVK_TRACE_SCOPE_CATEGORY("TinyVkSwapchainRenderer::RenderExecute", "tinyvk");
+				TinyVkRenderStatsScope statsScope(renderStats, true);
 				timed_guard swapChainLock(swapChainMutex);
 				if (!swapChainLock.Acquired()) return VK_ERROR_OUT_OF_DATE_KHR;
 				return RenderSwapChain();
@@ -0,0 +1,351 @@
+#pragma once
+#ifndef TINYVK_TINYVKTIMELINE
+#define TINYVK_TINYVKTIMELINE
+	#include "./TinyVulkan.hpp"
+	#include <thread>
+	#include <unordered_map>
+
+	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT QUEUE TIMELINES:
+				Every VkQueue owned by the TinyVkVulkanDevice has exactly one timeline semaphore (TinyVkTimeline).
+				Each submission to that queue signals the next monotonically increasing value on the timeline.
+
+				Resources (buffers, images, command pools) record the TinyVkTimelinePoint of their last use:
+					CPU Waits:          wait until the timeline reaches the recorded value (vkWaitSemaphores).
+					Cross-Queue Waits:  submit with a GPU wait on the other queue's timeline value (TinyVkTimeline::AddWait()).
+					Resource Retirement: destroy the resource once the timeline has passed the recorded value.
+
+				Swapchain acquire/present still require binary semaphores (WSI does not accept timelines),
+				those are passed along as additional wait/signal semaphores of the same submission.
+
+				Submissions are issued with vkQueueSubmit2. Outside of a batch every Submit() is flushed immediately,
+				inside a batch (TinyVkSubmissionBatch) the submissions made by the batching thread are flushed with a single
+				vkQueueSubmit2 when the batch ends (submissions from other threads are issued immediately, along with
+				whatever is pending). A submission is merged into the preceding VkSubmitInfo2 only if both wait on the
+				same semaphores and the preceding one signals nothing but the timeline.
+				CPU waits and presents on values that are still pending flush the queue first, so a batch never deadlocks.
+
+			ABOUT STALL DETECTION:
+				CPU waits block in slices of the timeline's stall threshold (default 1 second). Every slice that expires
+				without the value being reached is reported as a stall: logged to std::cerr with the waiting call site, the
+				queue family and the outstanding/completed/submitted timeline values, counted as TINYVK_COUNTER_STALLS and
+				passed to onStall (TinyVkVulkanDevice::onGpuStall for every queue). A long frame reports one stall, a hung
+				GPU or missed signal keeps reporting with the growing wait time.
+
+				The wait timeout (default UINT64_MAX, never give up) bounds every wait on the timeline: once exceeded the
+				wait is reported with timedOut = true and returns VK_TIMEOUT. Renderers return VK_TIMEOUT from
+				RenderSwapChain/RenderExecute/ComputeExecute, transfers throw a TinyVkRuntimeError.
+		*/
+
+		class TinyVkTimeline;
+
+		/// @brief A single value on a queue timeline, typically the submission that last used a resource.
+		struct TinyVkTimelinePoint {
+		public:
+			TinyVkTimeline* timeline = VK_NULL_HANDLE;
+			uint64_t value = 0;
+
+			/// @brief Returns true if this point has been reached (or was never submitted).
+			bool IsComplete();
+
+			/// @brief Blocks the calling thread until this point has been reached (source names the waiting call site in stall reports).
+			VkResult Wait(uint64_t timeout = UINT64_MAX, const char* source = "TinyVkTimelinePoint::Wait");
+		};
+
+		/// @brief Describes a CPU wait which exceeded its stall threshold (see TinyVkTimeline::onStall).
+		struct TinyVkStallInfo {
+		public:
+			const char* source = ""; /// Waiting call site, e.g. "TinyVkSwapchainRenderer::WaitFrameReuse".
+			uint32_t queueFamily = 0; /// Queue family of the outstanding submission.
+			uint64_t waitValue = 0; /// Timeline value of the outstanding submission (0 for swapchain image acquisition).
+			uint64_t completedValue = 0; /// Timeline value the GPU has reached.
+			uint64_t submittedValue = 0; /// Most recent timeline value submitted to the queue.
+			uint64_t waitedNs = 0; /// Time spent waiting so far.
+			bool timedOut = false; /// The wait exceeded the wait timeout and gave up, otherwise it keeps waiting.
+		};
+
+		/// @brief A semaphore wait (binary or timeline) applied to a queue submission.
+		struct TinyVkSemaphoreWait {
+		public:
+			VkSemaphore semaphore = VK_NULL_HANDLE;
+			uint64_t value = 0; /// Ignored for binary semaphores.
+			VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT;
+		};
+
+		/// @brief Device-wide timeline semaphore for a single VkQueue which tags every submission with an increasing value.
+		class TinyVkTimeline : public TinyVkDisposable {
+		private:
+			VkDevice logicalDevice;
+			VkQueue queue;
+			uint32_t queueFamily;
+			VkSemaphore semaphore = VK_NULL_HANDLE;
+			std::atomic<uint64_t> submittedValue = 0;
+			std::atomic<uint64_t> flushedValue = 0;
+			std::atomic<uint64_t> completedValue = 0;
+			std::atomic<uint64_t> stallThreshold = 1000000000;
+			std::atomic<uint64_t> waitTimeout = UINT64_MAX;
+			std::timed_mutex queue_lock;
+
+			/// Submissions collected for the next vkQueueSubmit2 (one VkSubmitInfo2 each).
+			struct TinyVkPendingSubmit {
+				std::vector<VkCommandBufferSubmitInfo> commandBuffers;
+				std::vector<VkSemaphoreSubmitInfo> waits;
+				std::vector<VkSemaphoreSubmitInfo> signals;
+			};
+			std::vector<TinyVkPendingSubmit> pendingSubmits;
+			std::unordered_map<std::thread::id, size_t> batchDepths; /// Batch nesting depth of each thread inside a batch.
+
+			/// @brief Returns true if the calling thread is inside a batch (queue_lock must be held).
+			bool IsBatchingNoLock() { return batchDepths.find(std::this_thread::get_id()) != batchDepths.end(); }
+
+			/// @brief Returns true if a submission with these waits can share the VkSubmitInfo2 of the pending submission (same waits, no binary signals).
+			bool CanMergeNoLock(const TinyVkPendingSubmit& pending, const std::vector<TinyVkSemaphoreWait>& waits) {
+				if (pending.waits.size() != waits.size()) return false;
+				for(size_t i = 0; i < waits.size(); i++)
+					if (pending.waits[i].semaphore != waits[i].semaphore || pending.waits[i].value != waits[i].value || pending.waits[i].stageMask != waits[i].stageMask) return false;
+
+				for(const VkSemaphoreSubmitInfo& signal : pending.signals)
+					if (signal.semaphore != semaphore) return false;
+				return true;
+			}
+
+			/// @brief Issues every pending submission with a single vkQueueSubmit2 (queue_lock must be held).
+			void FlushNoLock() {
+				if (pendingSubmits.size() == 0) return;
+
+				std::vector<VkSubmitInfo2> submitInfos(pendingSubmits.size());
+				for(size_t i = 0; i < pendingSubmits.size(); i++) {
+					submitInfos[i].sType = VK_STRUCTURE_TYPE_SUBMIT_INFO_2;
+					submitInfos[i].commandBufferInfoCount = static_cast<uint32_t>(pendingSubmits[i].commandBuffers.size());
+					submitInfos[i].pCommandBufferInfos = pendingSubmits[i].commandBuffers.data();
+					submitInfos[i].waitSemaphoreInfoCount = static_cast<uint32_t>(pendingSubmits[i].waits.size());
+					submitInfos[i].pWaitSemaphoreInfos = pendingSubmits[i].waits.data();
+					submitInfos[i].signalSemaphoreInfoCount = static_cast<uint32_t>(pendingSubmits[i].signals.size());
+					submitInfos[i].pSignalSemaphoreInfos = pendingSubmits[i].signals.data();
+				}
+
+				if (vkQueueSubmit2(queue, static_cast<uint32_t>(submitInfos.size()), submitInfos.data(), VK_NULL_HANDLE) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to submit command buffers to TinyVkTimeline queue!");
+
+				pendingSubmits.clear();
+				flushedValue = submittedValue.load();
+			}
+
+			void CreateTimelineSemaphore() {
+				VkSemaphoreTypeCreateInfo timelineInfo{};
+				timelineInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO;
+				timelineInfo.semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE;
+				timelineInfo.initialValue = 0;
+
+				VkSemaphoreCreateInfo semaphoreInfo{};
+				semaphoreInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_CREATE_INFO;
+				semaphoreInfo.pNext = &timelineInfo;
+
+				if (vkCreateSemaphore(logicalDevice, &semaphoreInfo, VK_NULL_HANDLE, &semaphore) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to create timeline semaphore for TinyVkTimeline!");
+
+				#if TVK_DEBUG_UTILS
+					TinyVkDebugUtils::SetObjectName(logicalDevice, VK_OBJECT_TYPE_SEMAPHORE, semaphore, "TinyVkTimeline[queue family " + std::to_string(queueFamily) + "]");
+					TinyVkDebugUtils::SetObjectName(logicalDevice, VK_OBJECT_TYPE_QUEUE, queue, "TinyVkQueue[queue family " + std::to_string(queueFamily) + "]");
+				#endif
+			}
+
+		public:
+			/// @brief Invoked on the waiting thread for every stalled or timed out wait on this timeline.
+			TinyVkInvokable<TinyVkStallInfo> onStall;
+
+			TinyVkTimeline operator=(const TinyVkTimeline&) = delete;
+
+			~TinyVkTimeline() { this->Dispose(); }
+
+			void Disposable(bool waitIdle) {
+				if (waitIdle) WaitIdle();
+				vkDestroySemaphore(logicalDevice, semaphore, VK_NULL_HANDLE);
+			}
+
+			/// @brief Creates the timeline semaphore for the given VkQueue (owned by the TinyVkVulkanDevice).
+			TinyVkTimeline(VkDevice logicalDevice, VkQueue queue, uint32_t queueFamily) : logicalDevice(logicalDevice), queue(queue), queueFamily(queueFamily) {
+				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
+				CreateTimelineSemaphore();
+			}
+
+			#pragma region REFERENCE_GETTERS
+
+			VkSemaphore GetSemaphore() { return semaphore; }
+			VkQueue GetQueue() { return queue; }
+			uint32_t GetQueueFamily() { return queueFamily; }
+
+			/// @brief Returns the value signaled by the most recent submission to this queue (may still be pending in a batch).
+			uint64_t GetSubmittedValue() { return submittedValue; }
+
+			/// @brief Returns the value signaled by the most recent submission actually issued to the queue.
+			uint64_t GetFlushedValue() { return flushedValue; }
+
+			/// @brief Returns the value the GPU has currently reached on this timeline.
+			uint64_t GetCompletedValue() {
+				uint64_t value = 0;
+				if (vkGetSemaphoreCounterValue(logicalDevice, semaphore, &value) == VK_SUCCESS)
+					completedValue = std::max(completedValue.load(), value);
+				return completedValue;
+			}
+
+			/// @brief Returns a TinyVkTimelinePoint for the most recent submission to this queue.
+			TinyVkTimelinePoint GetSubmittedPoint() { return { this, submittedValue }; }
+
+			/// @brief Adds a GPU wait on a point of another timeline to the waits of a submission to this queue (merged per timeline, skipped if
+			/// complete). Points on this timeline need no wait: submission order plus the barriers of the submission order them.
+			void AddWait(std::vector<TinyVkSemaphoreWait>& waits, TinyVkTimelinePoint point, VkPipelineStageFlags2 stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT) {
+				if (point.timeline == this || point.IsComplete()) return;
+
+				VkSemaphore waitSemaphore = point.timeline->GetSemaphore();
+				auto waitInfo = std::find_if(waits.begin(), waits.end(), [waitSemaphore](TinyVkSemaphoreWait& wait) { return wait.semaphore == waitSemaphore; });
+				if (waitInfo == waits.end()) {
+					waits.push_back({ waitSemaphore, point.value, stageMask });
+				} else {
+					waitInfo->value = std::max(waitInfo->value, point.value);
+					waitInfo->stageMask |= stageMask;
+				}
+			}
+
+			#pragma endregion
+			#pragma region TIMELINE_SYNCHRONIZATION
+
+			/// @brief Returns true if the timeline has reached the value (avoids a driver call when the cached value suffices).
+			bool IsComplete(uint64_t value) {
+				if (value <= completedValue) return true;
+				return value <= GetCompletedValue();
+			}
+
+			/// @brief Blocks the calling thread until the timeline reaches the value (or the timeout/wait timeout in nanoseconds expires), reporting stalls.
+			VkResult Wait(uint64_t value, uint64_t timeout = UINT64_MAX, const char* source = "TinyVkTimeline::Wait") {
+				if (IsComplete(value)) return VK_SUCCESS;
+				TINYVK_TRACE_SCOPE_CATEGORY("TinyVkTimeline::Wait", "tinyvk");
+				if (value > flushedValue) Flush();
+
+				VkSemaphoreWaitInfo waitInfo{};
+				waitInfo.sType = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO;
+				waitInfo.semaphoreCount = 1;
+				waitInfo.pSemaphores = &semaphore;
+				waitInfo.pValues = &value;
+
+				timeout = std::min(timeout, waitTimeout.load());
+				uint64_t threshold = stallThreshold, waitedNs = 0;
+				auto waitStart = std::chrono::steady_clock::now();
+				VkResult result = VK_TIMEOUT;
+
+				while(true) {
+					result = vkWaitSemaphores(logicalDevice, &waitInfo, std::min(threshold, timeout - waitedNs));
+					waitedNs = static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - waitStart).count());
+					if (result != VK_TIMEOUT || waitedNs >= timeout) break;
+					ReportStall({ source, queueFamily, value, GetCompletedValue(), submittedValue, waitedNs, false });
+				}
+
+				TinyVkRenderStats::Active().RecordWait(waitedNs);
+				if (result == VK_SUCCESS) {
+					completedValue = std::max(completedValue.load(), value);
+				} else if (result == VK_TIMEOUT && timeout >= threshold)
+					ReportStall({ source, queueFamily, value, GetCompletedValue(), submittedValue, waitedNs, true });
+				return result;
+			}
+
+			/// @brief Blocks the calling thread until every submission made to this queue has completed.
+			VkResult WaitIdle(uint64_t timeout = UINT64_MAX) { return Wait(submittedValue, timeout, "TinyVkTimeline::WaitIdle"); }
+
+			/// @brief Sets how long a wait blocks before it is reported as a stall (repeated every threshold) and after which every wait gives up with VK_TIMEOUT.
+			void SetWaitTimeouts(uint64_t stallThresholdNs, uint64_t waitTimeoutNs = UINT64_MAX) {
+				stallThreshold = std::max<uint64_t>(stallThresholdNs, 1);
+				waitTimeout = waitTimeoutNs;
+			}
+
+			/// @brief Returns the time in nanoseconds a wait blocks before it is reported as a stall.
+			uint64_t GetStallThreshold() { return stallThreshold; }
+
+			/// @brief Returns the time in nanoseconds after which every wait gives up with VK_TIMEOUT.
+			uint64_t GetWaitTimeout() { return waitTimeout; }
+
+			/// @brief Logs a stalled wait, counts it in the active TinyVkRenderStats and invokes onStall.
+			void ReportStall(TinyVkStallInfo stall) {
+				TinyVkRenderStats::Active().RecordStall();
+				std::cerr << "TinyVulkan: " << ((stall.timedOut)? "GPU wait timed out" : "GPU stall") << " in " << stall.source << " after " << (stall.waitedNs / 1000000.0)
+					<< "ms [queue family: " << stall.queueFamily << ", waiting on: " << stall.waitValue << ", completed: " << stall.completedValue << ", submitted: " << stall.submittedValue << "]" << std::endl;
+				onStall.invoke(stall);
+			}
+
+			#pragma endregion
+			#pragma region QUEUE_SUBMISSION
+
+			/// @brief Submits command buffers to the queue, signaling the next timeline value (plus any binary semaphores).
+			/// Inside a batch the submission is collected and issued when the batch ends, otherwise it is issued immediately.
+			TinyVkTimelinePoint Submit(const std::vector<VkCommandBuffer>& commandBuffers, const std::vector<TinyVkSemaphoreWait>& waits = {}, const std::vector<VkSemaphore>& signalSemaphores = {}) {
+				timed_guard<false> queueLock(queue_lock);
+				uint64_t value = submittedValue + 1;
+				TinyVkRenderStats::Active().RecordSubmit(commandBuffers.size());
+
+				bool merge = pendingSubmits.size() > 0 && CanMergeNoLock(pendingSubmits.back(), waits);
+				if (!merge) pendingSubmits.push_back(TinyVkPendingSubmit());
+				
+				TinyVkPendingSubmit& pending = pendingSubmits.back();
+				for(VkCommandBuffer commandBuffer : commandBuffers)
+					pending.commandBuffers.push_back({ .sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_SUBMIT_INFO, .commandBuffer = commandBuffer });
+				
+				if (!merge)
+					for(const TinyVkSemaphoreWait& wait : waits)
+						pending.waits.push_back({ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, .semaphore = wait.semaphore, .value = wait.value, .stageMask = wait.stageMask });
+
+				// Merged submissions signal the timeline once with the latest value (a wait on an earlier value is satisfied by a later one).
+				std::erase_if(pending.signals, [this](VkSemaphoreSubmitInfo& signal) { return signal.semaphore == semaphore; });
+				for(VkSemaphore signalSemaphore : signalSemaphores)
+					pending.signals.push_back({ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, .semaphore = signalSemaphore, .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT });
+				pending.signals.push_back({ .sType = VK_STRUCTURE_TYPE_SEMAPHORE_SUBMIT_INFO, .semaphore = semaphore, .value = value, .stageMask = VK_PIPELINE_STAGE_2_ALL_COMMANDS_BIT });
+
+				submittedValue = value;
+				if (!IsBatchingNoLock()) FlushNoLock();
+				return { this, value };
+			}
+
+			/// @brief Issues every pending submission with a single vkQueueSubmit2.
+			void Flush() {
+				timed_guard<false> queueLock(queue_lock);
+				FlushNoLock();
+			}
+
+			/// @brief Starts collecting the calling thread's submissions (batches may be nested, the outermost EndBatch() flushes).
+			void BeginBatch() {
+				timed_guard<false> queueLock(queue_lock);
+				batchDepths[std::this_thread::get_id()] ++;
+			}
+
+			/// @brief Stops collecting the calling thread's submissions and flushes them once its outermost batch ends.
+			void EndBatch() {
+				timed_guard<false> queueLock(queue_lock);
+				auto batch = batchDepths.find(std::this_thread::get_id());
+				if (batch == batchDepths.end()) return;
+				if (-- batch->second > 0) return;
+
+				batchDepths.erase(batch);
+				FlushNoLock();
+			}
+
+			/// @brief Presents swapchain images on this queue (shares the queue lock with submissions, flushes pending submissions first).
+			VkResult Present(const VkPresentInfoKHR& presentInfo) {
+				TINYVK_TRACE_SCOPE_CATEGORY("TinyVkTimeline::Present", "tinyvk");
+				timed_guard<false> queueLock(queue_lock);
+				FlushNoLock();
+				return vkQueuePresentKHR(queue, &presentInfo);
+			}
+
+			#pragma endregion
+		};
+
+		inline bool TinyVkTimelinePoint::IsComplete() {
+			return timeline == VK_NULL_HANDLE || timeline->IsComplete(value);
+		}
+
+		inline VkResult TinyVkTimelinePoint::Wait(uint64_t timeout, const char* source) {
+			if (timeline == VK_NULL_HANDLE) return VK_SUCCESS;
+			return timeline->Wait(value, timeout, source);
+		}
+	}
+
+#endif
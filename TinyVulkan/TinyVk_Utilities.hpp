@@ -33,6 +33,11 @@
 		}
 
 		VKAPI_ATTR VkBool32 VKAPI_CALL DebugCallback(VkDebugUtilsMessageSeverityFlagBitsEXT messageSeverity, VkDebugUtilsMessageTypeFlagsEXT messageType, const VkDebugUtilsMessengerCallbackDataEXT* pCallbackData, void* pUserData) {
+			if (pCallbackData->pMessageIdName != VK_NULL_HANDLE && std::string(pCallbackData->pMessageIdName) == "TinyVulkan") {
+				std::cerr << pCallbackData->pMessage << std::endl; // Submitted by TinyVkDebugUtils::SubmitMessage().
+				return VK_FALSE;
+			}
+
 			std::cerr << "TinyVulkan: Validation Layer: " << pCallbackData->pMessage << std::endl;
 			return VK_FALSE;
 		}
@@ -43,11 +48,36 @@
 		PFN_vkCmdBeginRenderingKHR vkCmdBeginRenderingEXTKHR = VK_NULL_HANDLE;
 		PFN_vkCmdEndRenderingKHR vkCmdEndRenderingEXTKHR = VK_NULL_HANDLE;
 		PFN_vkCmdPushDescriptorSetKHR vkCmdPushDescriptorSetEXTKHR = VK_NULL_HANDLE;
+		PFN_vkCmdPushDescriptorSetWithTemplateKHR vkCmdPushDescriptorSetWithTemplateEXTKHR = VK_NULL_HANDLE;
+		PFN_vkCmdBeginConditionalRenderingEXT vkCmdBeginConditionalRenderingEXTKHR = VK_NULL_HANDLE;
+		PFN_vkCmdEndConditionalRenderingEXT vkCmdEndConditionalRenderingEXTKHR = VK_NULL_HANDLE;
+		PFN_vkCmdSetPolygonModeEXT vkCmdSetPolygonModeEXTKHR = VK_NULL_HANDLE;
+		PFN_vkCmdSetColorBlendEnableEXT vkCmdSetColorBlendEnableEXTKHR = VK_NULL_HANDLE;
+		PFN_vkCmdSetColorBlendEquationEXT vkCmdSetColorBlendEquationEXTKHR = VK_NULL_HANDLE;
+		PFN_vkCmdSetColorWriteMaskEXT vkCmdSetColorWriteMaskEXTKHR = VK_NULL_HANDLE;
+		PFN_vkSetDebugUtilsObjectNameEXT vkSetDebugUtilsObjectNameEXTKHR = VK_NULL_HANDLE;
+		PFN_vkCmdBeginDebugUtilsLabelEXT vkCmdBeginDebugUtilsLabelEXTKHR = VK_NULL_HANDLE;
+		PFN_vkCmdEndDebugUtilsLabelEXT vkCmdEndDebugUtilsLabelEXTKHR = VK_NULL_HANDLE;
+		PFN_vkSubmitDebugUtilsMessageEXT vkSubmitDebugUtilsMessageEXTKHR = VK_NULL_HANDLE;
 
 		void vkCmdRenderingGetCallbacks(VkInstance instance) {
 			vkCmdBeginRenderingEXTKHR = (PFN_vkCmdBeginRenderingKHR)vkGetInstanceProcAddr(instance, "vkCmdBeginRenderingKHR");
 			vkCmdEndRenderingEXTKHR = (PFN_vkCmdEndRenderingKHR)vkGetInstanceProcAddr(instance, "vkCmdEndRenderingKHR");
 			vkCmdPushDescriptorSetEXTKHR = (PFN_vkCmdPushDescriptorSetKHR)vkGetInstanceProcAddr(instance, "vkCmdPushDescriptorSetKHR");
+			vkCmdPushDescriptorSetWithTemplateEXTKHR = (PFN_vkCmdPushDescriptorSetWithTemplateKHR)vkGetInstanceProcAddr(instance, "vkCmdPushDescriptorSetWithTemplateKHR");
+			vkCmdBeginConditionalRenderingEXTKHR = (PFN_vkCmdBeginConditionalRenderingEXT)vkGetInstanceProcAddr(instance, "vkCmdBeginConditionalRenderingEXT");
+			vkCmdEndConditionalRenderingEXTKHR = (PFN_vkCmdEndConditionalRenderingEXT)vkGetInstanceProcAddr(instance, "vkCmdEndConditionalRenderingEXT");
+			vkCmdSetPolygonModeEXTKHR = (PFN_vkCmdSetPolygonModeEXT)vkGetInstanceProcAddr(instance, "vkCmdSetPolygonModeEXT");
+			vkCmdSetColorBlendEnableEXTKHR = (PFN_vkCmdSetColorBlendEnableEXT)vkGetInstanceProcAddr(instance, "vkCmdSetColorBlendEnableEXT");
+			vkCmdSetColorBlendEquationEXTKHR = (PFN_vkCmdSetColorBlendEquationEXT)vkGetInstanceProcAddr(instance, "vkCmdSetColorBlendEquationEXT");
+			vkCmdSetColorWriteMaskEXTKHR = (PFN_vkCmdSetColorWriteMaskEXT)vkGetInstanceProcAddr(instance, "vkCmdSetColorWriteMaskEXT");
+
+			#if TVK_DEBUG_UTILS
+				vkSetDebugUtilsObjectNameEXTKHR = (PFN_vkSetDebugUtilsObjectNameEXT)vkGetInstanceProcAddr(instance, "vkSetDebugUtilsObjectNameEXT");
+				vkCmdBeginDebugUtilsLabelEXTKHR = (PFN_vkCmdBeginDebugUtilsLabelEXT)vkGetInstanceProcAddr(instance, "vkCmdBeginDebugUtilsLabelEXT");
+				vkCmdEndDebugUtilsLabelEXTKHR = (PFN_vkCmdEndDebugUtilsLabelEXT)vkGetInstanceProcAddr(instance, "vkCmdEndDebugUtilsLabelEXT");
+				vkSubmitDebugUtilsMessageEXTKHR = (PFN_vkSubmitDebugUtilsMessageEXT)vkGetInstanceProcAddr(instance, "vkSubmitDebugUtilsMessageEXT");
+			#endif
 		}
 
 		VkResult vkCmdBeginRenderingEKHR(VkInstance instance, VkCommandBuffer commandBuffer, const VkRenderingInfo* pRenderingInfo) {
@@ -76,10 +106,154 @@
 					throw TinyVkRuntimeError("TinyVulkan: Failed to load VK_KHR_dynamic_rendering EXT function: PFN_vkCmdPushDescriptorSetKHR");
 			#endif
 
+			TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_DESCRIPTORS_PUSHED, writeCount);
 			vkCmdPushDescriptorSetEXTKHR(commandBuffer, bindPoint, layout, set, writeCount, pWriteSets);
 			return VK_SUCCESS;
 		}
 
+		VkResult vkCmdPushDescriptorSetWithTemplateEKHR(VkInstance instance, VkCommandBuffer commandBuffer, VkDescriptorUpdateTemplate descriptorTemplate, VkPipelineLayout layout, uint32_t set, const void* pData, uint32_t entryCount) {
+			#if TVK_VALIDATION_LAYERS
+				if (vkCmdPushDescriptorSetWithTemplateEXTKHR == VK_NULL_HANDLE)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to load VK_KHR_push_descriptor EXT function: PFN_vkCmdPushDescriptorSetWithTemplateKHR");
+			#endif
+
+			TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_DESCRIPTORS_PUSHED, entryCount);
+			vkCmdPushDescriptorSetWithTemplateEXTKHR(commandBuffer, descriptorTemplate, layout, set, pData);
+			return VK_SUCCESS;
+		}
+
+		VkResult vkCmdBeginConditionalRenderingEKHR(VkInstance instance, VkCommandBuffer commandBuffer, const VkConditionalRenderingBeginInfoEXT* pConditionalRenderingBegin) {
+			#if TVK_VALIDATION_LAYERS
+				if (vkCmdBeginConditionalRenderingEXTKHR == VK_NULL_HANDLE)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to load VK_EXT_conditional_rendering EXT function: PFN_vkCmdBeginConditionalRenderingEXT");
+			#endif
+
+			vkCmdBeginConditionalRenderingEXTKHR(commandBuffer, pConditionalRenderingBegin);
+			return VK_SUCCESS;
+		}
+
+		VkResult vkCmdEndConditionalRenderingEKHR(VkInstance instance, VkCommandBuffer commandBuffer) {
+			#if TVK_VALIDATION_LAYERS
+				if (vkCmdEndConditionalRenderingEXTKHR == VK_NULL_HANDLE)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to load VK_EXT_conditional_rendering EXT function: PFN_vkCmdEndConditionalRenderingEXT");
+			#endif
+
+			vkCmdEndConditionalRenderingEXTKHR(commandBuffer);
+			return VK_SUCCESS;
+		}
+
+		VkResult vkCmdSetPolygonModeEKHR(VkInstance instance, VkCommandBuffer commandBuffer, VkPolygonMode polygonMode) {
+			#if TVK_VALIDATION_LAYERS
+				if (vkCmdSetPolygonModeEXTKHR == VK_NULL_HANDLE)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to load VK_EXT_extended_dynamic_state3 EXT function: PFN_vkCmdSetPolygonModeEXT");
+			#endif
+
+			vkCmdSetPolygonModeEXTKHR(commandBuffer, polygonMode);
+			return VK_SUCCESS;
+		}
+
+		VkResult vkCmdSetColorBlendEnableEKHR(VkInstance instance, VkCommandBuffer commandBuffer, uint32_t firstAttachment, uint32_t attachmentCount, const VkBool32* pColorBlendEnables) {
+			#if TVK_VALIDATION_LAYERS
+				if (vkCmdSetColorBlendEnableEXTKHR == VK_NULL_HANDLE)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to load VK_EXT_extended_dynamic_state3 EXT function: PFN_vkCmdSetColorBlendEnableEXT");
+			#endif
+
+			vkCmdSetColorBlendEnableEXTKHR(commandBuffer, firstAttachment, attachmentCount, pColorBlendEnables);
+			return VK_SUCCESS;
+		}
+
+		VkResult vkCmdSetColorBlendEquationEKHR(VkInstance instance, VkCommandBuffer commandBuffer, uint32_t firstAttachment, uint32_t attachmentCount, const VkColorBlendEquationEXT* pColorBlendEquations) {
+			#if TVK_VALIDATION_LAYERS
+				if (vkCmdSetColorBlendEquationEXTKHR == VK_NULL_HANDLE)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to load VK_EXT_extended_dynamic_state3 EXT function: PFN_vkCmdSetColorBlendEquationEXT");
+			#endif
+
+			vkCmdSetColorBlendEquationEXTKHR(commandBuffer, firstAttachment, attachmentCount, pColorBlendEquations);
+			return VK_SUCCESS;
+		}
+
+		VkResult vkCmdSetColorWriteMaskEKHR(VkInstance instance, VkCommandBuffer commandBuffer, uint32_t firstAttachment, uint32_t attachmentCount, const VkColorComponentFlags* pColorWriteMasks) {
+			#if TVK_VALIDATION_LAYERS
+				if (vkCmdSetColorWriteMaskEXTKHR == VK_NULL_HANDLE)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to load VK_EXT_extended_dynamic_state3 EXT function: PFN_vkCmdSetColorWriteMaskEXT");
+			#endif
+
+			vkCmdSetColorWriteMaskEXTKHR(commandBuffer, firstAttachment, attachmentCount, pColorWriteMasks);
+			return VK_SUCCESS;
+		}
+
+		#pragma endregion
+		#pragma region VULKAN_DEBUG_UTILS_LABELS
+
+		/// @brief Names Vulkan objects and labels command buffer regions (VK_EXT_debug_utils) for validation messages and GPU captures.
+		/// Every call compiles to nothing unless TVK_DEBUG_UTILS is enabled (debug builds or TINYVK_DEBUG_LABELS).
+		class TinyVkDebugUtils {
+		public:
+			/// @brief Names a Vulkan object (VkBuffer, VkImage, VkPipeline, VkCommandPool, VkSemaphore, ...).
+			template<typename T>
+			inline static void SetObjectName(VkDevice device, VkObjectType objectType, T handle, const std::string& name) {
+				#if TVK_DEBUG_UTILS
+					if (vkSetDebugUtilsObjectNameEXTKHR == VK_NULL_HANDLE || handle == VK_NULL_HANDLE) return;
+
+					VkDebugUtilsObjectNameInfoEXT nameInfo{};
+					nameInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_OBJECT_NAME_INFO_EXT;
+					nameInfo.objectType = objectType;
+					nameInfo.objectHandle = (uint64_t) handle;
+					nameInfo.pObjectName = name.c_str();
+					vkSetDebugUtilsObjectNameEXTKHR(device, &nameInfo);
+				#endif
+			}
+
+			/// @brief Opens a labeled region in the command buffer (close with EndLabel).
+			inline static void BeginLabel(VkCommandBuffer commandBuffer, const std::string& name, std::array<float, 4> color = { 0.25f, 0.5f, 1.0f, 1.0f }) {
+				#if TVK_DEBUG_UTILS
+					if (vkCmdBeginDebugUtilsLabelEXTKHR == VK_NULL_HANDLE) return;
+
+					VkDebugUtilsLabelEXT labelInfo{};
+					labelInfo.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_LABEL_EXT;
+					labelInfo.pLabelName = name.c_str();
+					std::copy(color.begin(), color.end(), labelInfo.color);
+					vkCmdBeginDebugUtilsLabelEXTKHR(commandBuffer, &labelInfo);
+				#endif
+			}
+
+			/// @brief Closes the most recently opened labeled region in the command buffer.
+			inline static void EndLabel(VkCommandBuffer commandBuffer) {
+				#if TVK_DEBUG_UTILS
+					if (vkCmdEndDebugUtilsLabelEXTKHR != VK_NULL_HANDLE) vkCmdEndDebugUtilsLabelEXTKHR(commandBuffer);
+				#endif
+			}
+
+			/// @brief Reports a library message to the instance's debug messengers (the validation messenger prints it, capture tools log it).
+			inline static void SubmitMessage(VkInstance instance, const std::string& message, VkDebugUtilsMessageSeverityFlagBitsEXT severity = VK_DEBUG_UTILS_MESSAGE_SEVERITY_ERROR_BIT_EXT) {
+				#if TVK_DEBUG_UTILS
+					if (vkSubmitDebugUtilsMessageEXTKHR == VK_NULL_HANDLE) return;
+
+					VkDebugUtilsMessengerCallbackDataEXT callbackData{};
+					callbackData.sType = VK_STRUCTURE_TYPE_DEBUG_UTILS_MESSENGER_CALLBACK_DATA_EXT;
+					callbackData.pMessageIdName = "TinyVulkan";
+					callbackData.pMessage = message.c_str();
+					vkSubmitDebugUtilsMessageEXTKHR(instance, severity, VK_DEBUG_UTILS_MESSAGE_TYPE_GENERAL_BIT_EXT, &callbackData);
+				#endif
+			}
+		};
+
+		/// @brief Scoped command buffer label: labels the commands recorded between construction and destruction.
+		class TinyVkDebugLabel {
+		private:
+			VkCommandBuffer commandBuffer;
+
+		public:
+			TinyVkDebugLabel(VkCommandBuffer commandBuffer, const std::string& name, std::array<float, 4> color = { 0.25f, 0.5f, 1.0f, 1.0f }) : commandBuffer(commandBuffer) {
+				TinyVkDebugUtils::BeginLabel(commandBuffer, name, color);
+			}
+
+			~TinyVkDebugLabel() { TinyVkDebugUtils::EndLabel(commandBuffer); }
+
+			TinyVkDebugLabel(const TinyVkDebugLabel&) = delete;
+			TinyVkDebugLabel operator=(const TinyVkDebugLabel&) = delete;
+		};
+
 		#pragma endregion
 
 		/// @brief List of valid Buffering Mode sizes.
@@ -130,6 +304,7 @@
 
 			/// @brief Alias call for vkCmdDraw (isIndexed = false) and vkCmdDrawIndexed (isIndexed = true).
 			inline static void CmdDrawGeometry(VkCommandBuffer cmdBuffer, bool isIndexed = false, uint32_t instanceCount = 1, uint32_t firstInstance = 0, uint32_t vertexCount = 0, uint32_t vertexOffset = 0, uint32_t firstIndex = 0) {
+				TinyVkRenderStats::Active().RecordDraw(isIndexed, vertexCount, instanceCount);
 				switch (isIndexed) {
 					case true:
 					vkCmdDrawIndexed(cmdBuffer, vertexCount, instanceCount, firstIndex, vertexOffset, firstInstance);
@@ -142,11 +317,13 @@
 
 			/// @brief Alias call for: vkCmdDrawIndexedIndirect.
 			inline static void CmdDrawGeometryIndirect(VkCommandBuffer cmdBuffer, const VkBuffer drawParamBuffer, VkDeviceSize offset, uint32_t drawCount, uint32_t stride) {
+				TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_DRAW_CALLS, drawCount);
 				vkCmdDrawIndexedIndirect(cmdBuffer, drawParamBuffer, offset, drawCount, stride);
 			}
 
 			/// @brief Alias call for: vkCmdDrawIndexedIndirectCount.
 			inline static void CmdDrawGeometryIndirect(VkCommandBuffer cmdBuffer, const VkBuffer drawParamBuffer, VkDeviceSize offset, const VkBuffer countBuffer, VkDeviceSize countBufferOffset, uint32_t drawCount, uint32_t maxDrawCount, uint32_t stride) {
+				TinyVkRenderStats::Active().Add(TinyVkRenderCounter::TINYVK_COUNTER_DRAW_CALLS);
 				vkCmdDrawIndexedIndirectCount(cmdBuffer, drawParamBuffer, offset, countBuffer, countBufferOffset, maxDrawCount, stride);
 			}
 		};
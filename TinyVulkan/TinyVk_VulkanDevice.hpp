@@ -3,10 +3,25 @@
 #define TINYVK_TINYVKVULKANDEVICE
 
 	#include "./TinyVulkan.hpp"
+	#include <chrono>
+	#include <cstring>
+	#include <filesystem>
 	
 	namespace TINYVULKAN_NAMESPACE {
 		#define VK_VALIDATION_LAYER_KHRONOS_EXTENSION_NAME "VK_LAYER_KHRONOS_validation"
 
+		/*
+			ABOUT THE PIPELINE CACHE:
+				The device owns one VkPipelineCache used by every TinyVkGraphicsPipeline and TinyVkComputeRenderer. Pass a
+				pipelineCacheFile to the TinyVkVulkanDevice (or call SetPipelineCacheFile()) to merge a previously saved cache into it
+				at startup. Files whose header (VkPipelineCacheHeaderVersionOne) was written by a different vendor/device/driver
+				(pipelineCacheUUID) are rejected, the pipelines are then compiled from scratch and the file is replaced on save.
+
+				The cache is saved back on disposal and, if autoSaveSeconds > 0, from CollectRetiredResources() whenever the
+				interval elapsed and the cache grew. Saves write "<file>.tmp" and rename it over the file, so a crash while saving
+				never leaves a truncated cache behind.
+		*/
+
 		struct TinyVkQueueFamily {
 			uint32_t graphicsFamily, presentFamily, computeFamily;
 			bool hasGraphicsFamily, hasPresentFamily, hasComputeFamily;
@@ -20,6 +35,16 @@
 			bool HasComputeFamily() { return hasComputeFamily; }
 		};
 
+		/// @brief Extended dynamic state enabled on the logical device (state which is not dynamic is baked into pipeline variants).
+		struct TinyVkDynamicStateSupport {
+			bool extendedDynamicState = false;  /// Cull mode, front face, primitive topology (within a topology class), depth test/write/compare op (core 1.3).
+			bool extendedDynamicState2 = false; /// Primitive restart enable (core 1.3).
+			bool polygonMode = false;           /// VK_EXT_extended_dynamic_state3: extendedDynamicState3PolygonMode.
+			bool colorBlendEnable = false;      /// VK_EXT_extended_dynamic_state3: extendedDynamicState3ColorBlendEnable.
+			bool colorBlendEquation = false;    /// VK_EXT_extended_dynamic_state3: extendedDynamicState3ColorBlendEquation.
+			bool colorWriteMask = false;        /// VK_EXT_extended_dynamic_state3: extendedDynamicState3ColorWriteMask.
+		};
+
 		union VkPhysicalDeviceFeaturesUnionArray {
 			VkBool32 features[sizeof(VkPhysicalDeviceFeatures)/sizeof(VkBool32)];
 			VkPhysicalDeviceFeatures vkfeatures;
@@ -31,9 +56,12 @@
 			std::vector<const char*> validationLayers = { VK_VALIDATION_LAYER_KHRONOS_EXTENSION_NAME };
 			std::vector<const char*> deviceExtensions = { VK_KHR_CREATE_RENDERPASS_2_EXTENSION_NAME, VK_KHR_DEPTH_STENCIL_RESOLVE_EXTENSION_NAME, VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME, VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME };
 			std::vector<const char*> instanceExtensions = {  };
+			std::vector<const char*> optionalDeviceExtensions = { VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME, VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME };
 
 			const std::vector<VkPhysicalDeviceType> deviceTypes;
 			VkPhysicalDeviceFeatures deviceFeatures {};
+			TinyVkDynamicStateSupport dynamicStateSupport {};
+			bool descriptorIndexingSupport = false;
 			const bool useComputeBit;
 
 			VkApplicationInfo appInfo{};
@@ -45,6 +73,19 @@
 			VkSurfaceKHR presentSurface = VK_NULL_HANDLE;
 			VmaAllocator memoryAllocator = VK_NULL_HANDLE;
 
+			TinyVkQueueFamily queueFamilies;
+			std::vector<TinyVkTimeline*> queueTimelines;
+			std::timed_mutex retirement_lock;
+			std::vector<std::pair<TinyVkTimelinePoint, std::function<void()>>> retiredResources;
+
+			VkPipelineCache pipelineCache = VK_NULL_HANDLE;
+			TinyVkShaderCache* shaderCache = nullptr;
+			std::timed_mutex pipeline_cache_lock;
+			std::string pipelineCacheFile;
+			size_t pipelineCacheSavedSize = 0;
+			std::chrono::steady_clock::duration pipelineCacheAutoSave = std::chrono::steady_clock::duration::zero();
+			std::chrono::steady_clock::time_point pipelineCacheLastSave;
+
 			/// @brief Creates the underlying Vulkan Instance w/ Required Extensions.
 			void CreateVkInstance(const std::string& title, TinyVkWindow* window = VK_NULL_HANDLE) {
 				VkApplicationInfo appInfo {};
@@ -53,7 +94,7 @@
 				appInfo.applicationVersion = TVK_RENDERER_VERSION;
 				appInfo.pEngineName = TVK_RENDERER_NAME;
 				appInfo.engineVersion = TVK_RENDERER_VERSION;
-				appInfo.apiVersion = TVK_RENDERER_VERSION;
+				appInfo.apiVersion = TVK_VULKAN_API_VERSION;
 
 				VkInstanceCreateInfo createInfo {};
 				createInfo.sType = VK_STRUCTURE_TYPE_INSTANCE_CREATE_INFO;
@@ -78,13 +119,18 @@
 					createInfo.enabledLayerCount = static_cast<uint32_t>(validationLayers.size());
 					createInfo.ppEnabledLayerNames = validationLayers.data();
 					createInfo.pNext = (VkDebugUtilsMessengerCreateInfoEXT*)&debugCreateInfo;
-					
+				#endif
+
+				#if TVK_DEBUG_UTILS
 					instanceExtensions.push_back(VK_EXT_DEBUG_UTILS_EXTENSION_NAME);
 				#endif
 
 				if (window != VK_NULL_HANDLE)
-					for (const auto& extension : window->QueryRequiredExtensions())
+					for (const auto& extension : window->QueryRequiredExtensions(window->IsHeadless()))
 						instanceExtensions.push_back(extension);
+
+				if (window != VK_NULL_HANDLE && window->IsHeadless() && !QueryInstanceExtensionAvailable(VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME))
+					throw TinyVkRuntimeError("TinyVulkan: Headless window requires VK_EXT_headless_surface which is not supported by the Vulkan loader/ICDs!");
 				
 				createInfo.enabledExtensionCount = static_cast<uint32_t>(instanceExtensions.size());
 				createInfo.ppEnabledExtensionNames = instanceExtensions.data();
@@ -173,6 +219,9 @@
 				presentFamily = indices.hasPresentFamily? indices.presentFamily : graphicsFamily;
 				computeFamily = indices.hasComputeFamily? indices.computeFamily : graphicsFamily;
 				std::set<uint32_t> uniqueQueueFamilies = { graphicsFamily, presentFamily, computeFamily };
+				queueFamilies.SetGraphicsFamily(graphicsFamily);
+				queueFamilies.SetPresentFamily(presentFamily);
+				queueFamilies.SetComputeFamily(computeFamily);
 
 				float queuePriority = 1.0f;
 				for (uint32_t queueFamily : uniqueQueueFamilies) {
@@ -188,9 +237,90 @@
 				dynamicRenderingCreateInfo.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_DYNAMIC_RENDERING_FEATURES_KHR;
 				dynamicRenderingCreateInfo.dynamicRendering = VK_TRUE;
 
+				VkPhysicalDeviceSynchronization2Features synchronization2Features{};
+				synchronization2Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SYNCHRONIZATION_2_FEATURES;
+				synchronization2Features.synchronization2 = VK_TRUE;
+				dynamicRenderingCreateInfo.pNext = &synchronization2Features;
+
+				VkPhysicalDeviceVulkan12Features vulkan12Features{};
+				vulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+				vulkan12Features.timelineSemaphore = VK_TRUE;
+				vulkan12Features.hostQueryReset = VK_TRUE;
+				vulkan12Features.pNext = &dynamicRenderingCreateInfo;
+
+				// Optional query features/extensions (TinyVkPipelineQueries) are enabled only where the device supports them.
+				VkPhysicalDeviceFeatures supportedFeatures {};
+				vkGetPhysicalDeviceFeatures(physicalDevice, &supportedFeatures);
+				deviceFeatures.pipelineStatisticsQuery |= supportedFeatures.pipelineStatisticsQuery;
+				deviceFeatures.occlusionQueryPrecise |= supportedFeatures.occlusionQueryPrecise;
+
+				for (const char* extension : optionalDeviceExtensions)
+					if (QueryDeviceExtensionAvailable(physicalDevice, extension)) deviceExtensions.push_back(extension);
+
+				VkPhysicalDeviceConditionalRenderingFeaturesEXT conditionalRenderingFeatures{};
+				conditionalRenderingFeatures.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_CONDITIONAL_RENDERING_FEATURES_EXT;
+				conditionalRenderingFeatures.conditionalRendering = VK_TRUE;
+				if (IsDeviceExtensionEnabled(VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME)) {
+					conditionalRenderingFeatures.pNext = vulkan12Features.pNext;
+					vulkan12Features.pNext = &conditionalRenderingFeatures;
+				}
+
+				// Extended dynamic state 1/2 is core in Vulkan 1.3, only the supported extended dynamic state 3 features are enabled.
+				VkPhysicalDeviceExtendedDynamicState3FeaturesEXT dynamicState3Features{};
+				dynamicState3Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+				#ifndef TINYVK_DISABLE_DYNAMIC_STATE
+					VkPhysicalDeviceProperties deviceProperties {};
+					vkGetPhysicalDeviceProperties(physicalDevice, &deviceProperties);
+					dynamicStateSupport.extendedDynamicState = deviceProperties.apiVersion >= VK_API_VERSION_1_3;
+					dynamicStateSupport.extendedDynamicState2 = deviceProperties.apiVersion >= VK_API_VERSION_1_3;
+
+					if (IsDeviceExtensionEnabled(VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME)) {
+						VkPhysicalDeviceExtendedDynamicState3FeaturesEXT supportedDynamicState3{};
+						supportedDynamicState3.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_EXTENDED_DYNAMIC_STATE_3_FEATURES_EXT;
+						VkPhysicalDeviceFeatures2 supportedFeatures2{};
+						supportedFeatures2.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+						supportedFeatures2.pNext = &supportedDynamicState3;
+						vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedFeatures2);
+
+						dynamicState3Features.extendedDynamicState3PolygonMode = supportedDynamicState3.extendedDynamicState3PolygonMode;
+						dynamicState3Features.extendedDynamicState3ColorBlendEnable = supportedDynamicState3.extendedDynamicState3ColorBlendEnable;
+						dynamicState3Features.extendedDynamicState3ColorBlendEquation = supportedDynamicState3.extendedDynamicState3ColorBlendEquation;
+						dynamicState3Features.extendedDynamicState3ColorWriteMask = supportedDynamicState3.extendedDynamicState3ColorWriteMask;
+						dynamicState3Features.pNext = vulkan12Features.pNext;
+						vulkan12Features.pNext = &dynamicState3Features;
+
+						dynamicStateSupport.polygonMode = dynamicState3Features.extendedDynamicState3PolygonMode;
+						dynamicStateSupport.colorBlendEnable = dynamicState3Features.extendedDynamicState3ColorBlendEnable;
+						dynamicStateSupport.colorBlendEquation = dynamicState3Features.extendedDynamicState3ColorBlendEquation;
+						dynamicStateSupport.colorWriteMask = dynamicState3Features.extendedDynamicState3ColorWriteMask;
+					}
+				#endif
+
+				// Descriptor indexing (core 1.2) for TinyVkBindlessTable: partially bound, update-after-bind, non-uniformly indexed sampled image/sampler arrays.
+				#ifndef TINYVK_DISABLE_BINDLESS
+					VkPhysicalDeviceVulkan12Features supportedVulkan12{};
+					supportedVulkan12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+					VkPhysicalDeviceFeatures2 supportedVulkan12Features{};
+					supportedVulkan12Features.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2;
+					supportedVulkan12Features.pNext = &supportedVulkan12;
+					vkGetPhysicalDeviceFeatures2(physicalDevice, &supportedVulkan12Features);
+
+					descriptorIndexingSupport = supportedVulkan12.descriptorIndexing && supportedVulkan12.runtimeDescriptorArray
+						&& supportedVulkan12.descriptorBindingPartiallyBound && supportedVulkan12.descriptorBindingSampledImageUpdateAfterBind
+						&& supportedVulkan12.descriptorBindingUpdateUnusedWhilePending && supportedVulkan12.shaderSampledImageArrayNonUniformIndexing;
+					if (descriptorIndexingSupport) {
+						vulkan12Features.descriptorIndexing = VK_TRUE;
+						vulkan12Features.runtimeDescriptorArray = VK_TRUE;
+						vulkan12Features.descriptorBindingPartiallyBound = VK_TRUE;
+						vulkan12Features.descriptorBindingSampledImageUpdateAfterBind = VK_TRUE;
+						vulkan12Features.descriptorBindingUpdateUnusedWhilePending = VK_TRUE;
+						vulkan12Features.shaderSampledImageArrayNonUniformIndexing = VK_TRUE;
+					}
+				#endif
+
 				VkDeviceCreateInfo createInfo{};
 				createInfo.sType = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO;
-				createInfo.pNext = &dynamicRenderingCreateInfo;
+				createInfo.pNext = &vulkan12Features;
 				createInfo.pQueueCreateInfos = queueCreateInfos.data();
 				createInfo.queueCreateInfoCount = static_cast<uint32_t>(queueCreateInfos.size());
 				createInfo.pEnabledFeatures = &deviceFeatures;
@@ -218,17 +348,70 @@
 				#endif
 			}
 			
+			/// @brief Creates one TinyVkTimeline per unique queue family (all queue submissions go through these timelines).
+			void CreateQueueTimelines() {
+				std::set<uint32_t> uniqueQueueFamilies = { queueFamilies.graphicsFamily, queueFamilies.presentFamily, queueFamilies.computeFamily };
+
+				for (uint32_t queueFamily : uniqueQueueFamilies) {
+					VkQueue queue = VK_NULL_HANDLE;
+					vkGetDeviceQueue(logicalDevice, queueFamily, 0, &queue);
+					queueTimelines.push_back(new TinyVkTimeline(logicalDevice, queue, queueFamily));
+					queueTimelines.back()->onStall.hook(TinyVkCallback<TinyVkStallInfo>([this](TinyVkStallInfo stall) { onGpuStall.invoke(stall); }));
+				}
+			}
+
 			/// @brief Creates the VMAllocator for AMD's GPU memory handling API.
 			void CreateVMAllocator() {
 				VmaAllocatorCreateInfo allocatorCreateInfo {};
-				allocatorCreateInfo.vulkanApiVersion = TVK_RENDERER_VERSION;
+				allocatorCreateInfo.vulkanApiVersion = TVK_VULKAN_API_VERSION;
 				allocatorCreateInfo.physicalDevice = physicalDevice;
 				allocatorCreateInfo.device = logicalDevice;
 				allocatorCreateInfo.instance = instance;
 				vmaCreateAllocator(&allocatorCreateInfo, &memoryAllocator);
 			}
+
+			/// @brief Creates the (empty) device pipeline cache shared by all pipelines.
+			void CreatePipelineCache() {
+				VkPipelineCacheCreateInfo createInfo{};
+				createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+
+				if (vkCreatePipelineCache(logicalDevice, &createInfo, VK_NULL_HANDLE, &pipelineCache) != VK_SUCCESS)
+					throw TinyVkRuntimeError("TinyVulkan: Failed to create pipeline cache!");
+			}
+
+			/// @brief Writes the device pipeline cache to "<path>.tmp" and atomically renames it over path (caller holds pipeline_cache_lock).
+			bool SavePipelineCacheNoLock(const std::string& path) {
+				size_t cacheSize = 0;
+				if (vkGetPipelineCacheData(logicalDevice, pipelineCache, &cacheSize, VK_NULL_HANDLE) != VK_SUCCESS) return false;
+
+				std::vector<char> cacheData(cacheSize);
+				if (vkGetPipelineCacheData(logicalDevice, pipelineCache, &cacheSize, cacheData.data()) != VK_SUCCESS) return false;
+				cacheData.resize(cacheSize);
+
+				const std::string tempPath = path + ".tmp";
+				{
+					std::ofstream file(tempPath, std::ios::out | std::ios::binary | std::ios::trunc);
+					if (!file.is_open()) return false;
+					file.write(cacheData.data(), cacheData.size());
+					file.flush();
+					if (!file.good()) return false;
+				}
+
+				std::error_code error;
+				std::filesystem::rename(tempPath, path, error);
+				if (error) {
+					std::filesystem::remove(tempPath, error);
+					return false;
+				}
+
+				if (path == pipelineCacheFile) pipelineCacheSavedSize = cacheSize;
+				pipelineCacheLastSave = std::chrono::steady_clock::now();
+				return true;
+			}
 			
 		public:
+			/// @brief Invoked on the waiting thread for every stalled or timed out wait on any of the device's queue timelines.
+			TinyVkInvokable<TinyVkStallInfo> onGpuStall;
 
 			TinyVkVulkanDevice operator=(const TinyVkVulkanDevice&) = delete;
 
@@ -237,10 +420,24 @@
 			void Disposable(bool waitIdle) {
 				if (waitIdle) DeviceWaitIdle();
 
+				for (TinyVkTimeline* timeline : queueTimelines) timeline->WaitIdle();
+				CollectRetiredResources();
+
+				for (TinyVkTimeline* timeline : queueTimelines) {
+					timeline->Dispose();
+					delete timeline;
+				}
+
 				#if TVK_VALIDATION_LAYERS
 					DestroyDebugUtilsMessengerEXT(instance, debugMessenger, VK_NULL_HANDLE);
 				#endif
 				
+				if (!pipelineCacheFile.empty()) SavePipelineCache(pipelineCacheFile);
+				vkDestroyPipelineCache(logicalDevice, pipelineCache, VK_NULL_HANDLE);
+				if (shaderCache != nullptr) {
+					shaderCache->Dispose();
+					delete shaderCache;
+				}
 				vmaDestroyAllocator(memoryAllocator);
 				vkDestroyDevice(logicalDevice, VK_NULL_HANDLE);
 				if (presentSurface != VK_NULL_HANDLE)
@@ -248,7 +445,8 @@
 				vkDestroyInstance(instance, VK_NULL_HANDLE);
 			}
 
-			TinyVkVulkanDevice(const std::string title, bool useComputeBit = false, const std::vector<VkPhysicalDeviceType> deviceTypes = { VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU, VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU }, TinyVkWindow* window = VK_NULL_HANDLE, VkPhysicalDeviceFeatures deviceFeatures = { .multiDrawIndirect = VK_TRUE })
+			/// @param pipelineCacheFile Pipeline cache file loaded at startup and saved on disposal (empty = in-memory cache only), see ABOUT THE PIPELINE CACHE.
+			TinyVkVulkanDevice(const std::string title, bool useComputeBit = false, const std::vector<VkPhysicalDeviceType> deviceTypes = { VK_PHYSICAL_DEVICE_TYPE_DISCRETE_GPU, VK_PHYSICAL_DEVICE_TYPE_INTEGRATED_GPU, VK_PHYSICAL_DEVICE_TYPE_VIRTUAL_GPU }, TinyVkWindow* window = VK_NULL_HANDLE, VkPhysicalDeviceFeatures deviceFeatures = { .multiDrawIndirect = VK_TRUE }, const std::string pipelineCacheFile = "")
 			: useComputeBit(useComputeBit), deviceTypes(deviceTypes) {
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose) {this->Disposable(forceDispose); }));
 				
@@ -264,7 +462,12 @@
 				vkCmdRenderingGetCallbacks(instance);
 				QueryPhysicalDevice();
 				CreateLogicalDevice();
+				CreateQueueTimelines();
 				CreateVMAllocator();
+				CreatePipelineCache();
+				shaderCache = new TinyVkShaderCache(logicalDevice);
+
+				if (!pipelineCacheFile.empty()) SetPipelineCacheFile(pipelineCacheFile);
 			}
 
 			#pragma region REFERENCE_GETTERS
@@ -275,8 +478,15 @@
 			VkDevice GetLogicalDevice() { return logicalDevice; }
 			VkSurfaceKHR GetPresentSurface() { return presentSurface; }
 			VmaAllocator GetAllocator() { return memoryAllocator; }
+			VkPipelineCache GetPipelineCache() { return pipelineCache; }
+			TinyVkShaderCache& GetShaderCache() { return *shaderCache; }
+			TinyVkQueueFamily GetQueueFamilies() { return queueFamilies; }
 			VkApplicationInfo GetAppInfo() { return appInfo; }
 			const std::vector<const char*> GetDeviceExtensions() { return deviceExtensions; }
+			VkPhysicalDeviceFeatures GetDeviceFeatures() { return deviceFeatures; }
+			TinyVkDynamicStateSupport GetDynamicStateSupport() { return dynamicStateSupport; }
+			/// @brief Returns true if the descriptor indexing features used by TinyVkBindlessTable are enabled.
+			bool IsDescriptorIndexingSupported() { return descriptorIndexingSupport; }
 			const bool IsComputeCompatible() { return useComputeBit; }
 
 			#pragma endregion
@@ -353,6 +563,37 @@
 				return details;
 			}
 
+			/// @brief Returns BOOL(true/false) if the instance extension is supported by the Vulkan loader or any installed ICD.
+			bool QueryInstanceExtensionAvailable(const char* extensionName) {
+				uint32_t extensionCount;
+				vkEnumerateInstanceExtensionProperties(VK_NULL_HANDLE, &extensionCount, VK_NULL_HANDLE);
+				std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+				vkEnumerateInstanceExtensionProperties(VK_NULL_HANDLE, &extensionCount, availableExtensions.data());
+
+				for (const auto& extension : availableExtensions)
+					if (!std::string(extensionName).compare(extension.extensionName)) return true;
+				return false;
+			}
+
+			/// @brief Returns BOOL(true/false) if the VkPhysicalDevice (GPU/iGPU) supports a single (optional) extension.
+			bool QueryDeviceExtensionAvailable(VkPhysicalDevice device, const char* extensionName) {
+				uint32_t extensionCount;
+				vkEnumerateDeviceExtensionProperties(device, VK_NULL_HANDLE, &extensionCount, VK_NULL_HANDLE);
+				std::vector<VkExtensionProperties> availableExtensions(extensionCount);
+				vkEnumerateDeviceExtensionProperties(device, VK_NULL_HANDLE, &extensionCount, availableExtensions.data());
+
+				for (const auto& extension : availableExtensions)
+					if (!std::string(extensionName).compare(extension.extensionName)) return true;
+				return false;
+			}
+
+			/// @brief Returns BOOL(true/false) if the extension was enabled on the logical device (required or supported optional extension).
+			bool IsDeviceExtensionEnabled(const char* extensionName) {
+				for (const char* extension : deviceExtensions)
+					if (!std::string(extensionName).compare(extension)) return true;
+				return false;
+			}
+
 			/// @brief Returns BOOL(true/false) if the VkPhysicalDevice (GPU/iGPU) supports extensions.
 			bool QueryDeviceExtensionSupport(VkPhysicalDevice device) {
 				uint32_t extensionCount;
@@ -417,6 +658,162 @@
 			}
 
 			#pragma endregion
+			#pragma region QUEUE_TIMELINES
+
+			/// @brief Returns the TinyVkTimeline of the queue for the given queue family.
+			TinyVkTimeline& GetQueueTimeline(uint32_t queueFamily) {
+				for (TinyVkTimeline* timeline : queueTimelines)
+					if (timeline->GetQueueFamily() == queueFamily) return *timeline;
+
+				throw TinyVkRuntimeError("TinyVulkan: No TinyVkTimeline exists for queue family: " + std::to_string(queueFamily));
+			}
+
+			/// @brief Returns the TinyVkTimeline of the graphics queue (transfer & render submissions).
+			TinyVkTimeline& GetGraphicsTimeline() { return GetQueueTimeline(queueFamilies.graphicsFamily); }
+
+			/// @brief Returns the TinyVkTimeline of the present queue (falls back to the graphics queue without a present surface).
+			TinyVkTimeline& GetPresentTimeline() { return GetQueueTimeline(queueFamilies.presentFamily); }
+
+			/// @brief Returns the TinyVkTimeline of the compute queue (falls back to the graphics queue if not compute compatible).
+			TinyVkTimeline& GetComputeTimeline() { return GetQueueTimeline(queueFamilies.computeFamily); }
+
+			/// @brief Sets the stall threshold and wait timeout (nanoseconds) of every queue timeline (see TinyVkTimeline::SetWaitTimeouts).
+			void SetWaitTimeouts(uint64_t stallThresholdNs, uint64_t waitTimeoutNs = UINT64_MAX) {
+				for (TinyVkTimeline* timeline : queueTimelines) timeline->SetWaitTimeouts(stallThresholdNs, waitTimeoutNs);
+			}
+
+			/// @brief Starts collecting the calling thread's submissions on every queue timeline (see TinyVkSubmissionBatch).
+			void BeginSubmissionBatch() {
+				for (TinyVkTimeline* timeline : queueTimelines) timeline->BeginBatch();
+			}
+
+			/// @brief Flushes the submissions collected on every queue timeline with one vkQueueSubmit2 per queue.
+			void EndSubmissionBatch() {
+				for (TinyVkTimeline* timeline : queueTimelines) timeline->EndBatch();
+			}
+
+			/// @brief Destroys a resource (via callback) once the GPU has passed the timeline point of its last use.
+			void RetireResource(TinyVkTimelinePoint lastUse, std::function<void()> destructor) {
+				if (lastUse.IsComplete()) { destructor(); return; }
+
+				timed_guard<false> retirementLock(retirement_lock);
+				retiredResources.push_back(std::pair(lastUse, destructor));
+			}
+
+			/// @brief Destroys all retired resources whose last use has completed on the GPU (call once per frame).
+			void CollectRetiredResources() {
+				std::vector<std::function<void()>> destructors;
+
+				{
+					timed_guard<false> retirementLock(retirement_lock);
+					std::erase_if(retiredResources, [&destructors](std::pair<TinyVkTimelinePoint, std::function<void()>>& retired) {
+						if (!retired.first.IsComplete()) return false;
+						destructors.push_back(retired.second);
+						return true;
+					});
+				}
+
+				for (auto& destructor : destructors) destructor();
+				PollPipelineCacheAutoSave();
+			}
+
+			#pragma endregion
+			#pragma region PIPELINE_CACHE
+
+			/// @brief Returns true if the pipeline cache data's header was written by this physical device and driver (vendor/device ID and pipelineCacheUUID).
+			bool QueryPipelineCacheCompatible(const std::vector<char>& cacheData) {
+				VkPhysicalDeviceProperties properties;
+				vkGetPhysicalDeviceProperties(physicalDevice, &properties);
+				return QueryPipelineCacheCompatible(cacheData, properties);
+			}
+
+			/// @brief Returns true if the pipeline cache data's header matches the device properties (vendor/device ID and pipelineCacheUUID).
+			static bool QueryPipelineCacheCompatible(const std::vector<char>& cacheData, const VkPhysicalDeviceProperties& properties) {
+				VkPipelineCacheHeaderVersionOne header{};
+				if (cacheData.size() < sizeof(VkPipelineCacheHeaderVersionOne)) return false;
+				std::memcpy(&header, cacheData.data(), sizeof(VkPipelineCacheHeaderVersionOne));
+
+				return header.headerSize >= sizeof(VkPipelineCacheHeaderVersionOne) && header.headerSize <= cacheData.size()
+					&& header.headerVersion == VK_PIPELINE_CACHE_HEADER_VERSION_ONE
+					&& header.vendorID == properties.vendorID && header.deviceID == properties.deviceID
+					&& std::memcmp(header.pipelineCacheUUID, properties.pipelineCacheUUID, VK_UUID_SIZE) == 0;
+			}
+
+			/// @brief Merges a saved pipeline cache file into the device pipeline cache, returns false if the file is missing or stale (other device/driver).
+			bool LoadPipelineCache(const std::string& path) {
+				std::ifstream file(path, std::ios::in | std::ios::binary | std::ios::ate);
+				if (!file.is_open()) return false;
+
+				std::vector<char> cacheData(static_cast<size_t>(file.tellg()));
+				file.seekg(0);
+				file.read(cacheData.data(), cacheData.size());
+				if (!file.good() || !QueryPipelineCacheCompatible(cacheData)) {
+					#if TVK_VALIDATION_LAYERS
+						std::cout << "TinyVulkan: Rejected stale or invalid pipeline cache: " << path << std::endl;
+					#endif
+					return false;
+				}
+
+				VkPipelineCacheCreateInfo createInfo{};
+				createInfo.sType = VK_STRUCTURE_TYPE_PIPELINE_CACHE_CREATE_INFO;
+				createInfo.initialDataSize = cacheData.size();
+				createInfo.pInitialData = cacheData.data();
+
+				VkPipelineCache loadedCache = VK_NULL_HANDLE;
+				if (vkCreatePipelineCache(logicalDevice, &createInfo, VK_NULL_HANDLE, &loadedCache) != VK_SUCCESS) return false;
+
+				timed_guard<false> pipelineCacheLock(pipeline_cache_lock);
+				VkResult result = vkMergePipelineCaches(logicalDevice, pipelineCache, 1, &loadedCache);
+				vkDestroyPipelineCache(logicalDevice, loadedCache, VK_NULL_HANDLE);
+				if (result == VK_SUCCESS && path == pipelineCacheFile) pipelineCacheSavedSize = cacheData.size();
+				return result == VK_SUCCESS;
+			}
+
+			/// @brief Writes the device pipeline cache to "<path>.tmp" and atomically renames it over path, returns false on failure.
+			bool SavePipelineCache(const std::string& path) {
+				timed_guard<false> pipelineCacheLock(pipeline_cache_lock);
+				return SavePipelineCacheNoLock(path);
+			}
+
+			/// @brief Sets the file the pipeline cache is loaded from (now) and saved to (on disposal and every autoSaveSeconds if > 0), returns true if the file was loaded.
+			bool SetPipelineCacheFile(const std::string& path, uint32_t autoSaveSeconds = 0) {
+				{
+					timed_guard<false> pipelineCacheLock(pipeline_cache_lock);
+					pipelineCacheFile = path;
+					pipelineCacheAutoSave = std::chrono::seconds(autoSaveSeconds);
+					pipelineCacheLastSave = std::chrono::steady_clock::now();
+					pipelineCacheSavedSize = 0;
+				}
+				return !path.empty() && LoadPipelineCache(path);
+			}
+
+			/// @brief Saves the pipeline cache if the auto-save interval elapsed and pipelines were added to the cache since the last save.
+			void PollPipelineCacheAutoSave() {
+				timed_guard<false> pipelineCacheLock(pipeline_cache_lock);
+				if (pipelineCacheFile.empty() || pipelineCacheAutoSave == std::chrono::steady_clock::duration::zero()) return;
+				if (std::chrono::steady_clock::now() - pipelineCacheLastSave < pipelineCacheAutoSave) return;
+
+				size_t cacheSize = 0;
+				vkGetPipelineCacheData(logicalDevice, pipelineCache, &cacheSize, VK_NULL_HANDLE);
+				if (cacheSize != pipelineCacheSavedSize) { SavePipelineCacheNoLock(pipelineCacheFile); } else pipelineCacheLastSave = std::chrono::steady_clock::now();
+			}
+
+			#pragma endregion
+		};
+
+		/// @brief Scoped frame submission collector: the renderer/transfer submissions made by the creating thread while alive are issued with one vkQueueSubmit2 per queue when it goes out of scope.
+		class TinyVkSubmissionBatch {
+		private:
+			TinyVkVulkanDevice& vkdevice;
+
+		public:
+			explicit TinyVkSubmissionBatch(TinyVkVulkanDevice& vkdevice) : vkdevice(vkdevice) { vkdevice.BeginSubmissionBatch(); }
+
+			~TinyVkSubmissionBatch() { vkdevice.EndSubmissionBatch(); }
+
+			TinyVkSubmissionBatch(const TinyVkSubmissionBatch&) = delete;
+
+			TinyVkSubmissionBatch& operator=(const TinyVkSubmissionBatch&) = delete;
 		};
 	}
 
@@ -68,10 +68,19 @@
 	int glfwGetGamepadButton(tinyvk::TinyVkGamepads id, tinyvk::TinyVkGamepadButtons button) { return static_cast<int>(glfwGamepadCache[int(id)].buttons[int(button)]); }
 
 	namespace TINYVULKAN_NAMESPACE {
+		/*
+			ABOUT HEADLESS WINDOWS:
+				A headless TinyVkWindow (headless = true) creates no GLFW window: its surface is created with VK_EXT_headless_surface
+				so TinyVkSwapchainRenderer runs the same acquire / frames in flight / present / recreation path without a display
+				(e.g. CI machines running lavapipe). The frame buffer size is the requested width/height and resize events are
+				generated with SetHeadlessFrameBufferSize(). Headless windows have a null hwndWindow (resize events are shared by
+				every headless window) and never request to close, exit WhileMain() through onWhileMain instead.
+		*/
+
 		/// @brief GLFW window handler for TinyVulkan that will link to and initialize GLFW and Vulkan to create your game/application window
 		class TinyVkWindow : public TinyVkDisposable {
 		public:
-			bool hwndResizable;
+			bool hwndResizable, hwndHeadless;
 			int hwndWidth, hwndHeight, hwndXpos, hwndYpos;
 			std::string title;
 			GLFWwindow* hwndWindow;
@@ -92,16 +101,26 @@
 
 			/// @brief Disposable function for disposable class interface and window resource cleanup.
 			void Disposable(bool waitIdle) {
+				if (hwndHeadless) return;
 				glfwDestroyWindow(hwndWindow);
 				glfwTerminate();
 			}
 
 			/// @brief Initiialize managed GLFW Window and Vulkan API. Initialize GLFW window unique_ptr.
-			TinyVkWindow(std::string title, int width, int height, bool resizable, bool transparentFramebuffer = false, bool hasMinSize = false, int minWidth = 200, int minHeight = 200) {
+			/// @param headless Creates no GLFW window, the Vulkan surface is created with VK_EXT_headless_surface (see ABOUT HEADLESS WINDOWS).
+			TinyVkWindow(std::string title, int width, int height, bool resizable, bool transparentFramebuffer = false, bool hasMinSize = false, int minWidth = 200, int minHeight = 200, bool headless = false)
+			: title(title), hwndHeadless(headless), hwndXpos(0), hwndYpos(0), hwndWindow(VK_NULL_HANDLE) {
 				onDispose.hook(TinyVkCallback<bool>([this](bool forceDispose){this->Disposable(forceDispose); }));
 				onWindowResized.hook(TinyVkCallback<GLFWwindow*, int, int>([this](GLFWwindow* hwnd, int width, int height) { if (hwnd != hwndWindow) return; hwndWidth = width; hwndHeight = height; }));
 				onWindowPositionMoved.hook(TinyVkCallback<GLFWwindow*, int, int>([this](GLFWwindow* hwnd, int xpos, int ypos) { if (hwnd != hwndWindow) return; hwndXpos = xpos; hwndYpos = ypos; }));
 
+				if (headless) {
+					hwndResizable = resizable;
+					hwndWidth = std::max(width, 1);
+					hwndHeight = std::max(height, 1);
+					return;
+				}
+
 				hwndWindow = InitiateWindow(title, width, height, resizable, transparentFramebuffer);
 				glfwSetWindowUserPointer(hwndWindow, this);
 				glfwSetFramebufferSizeCallback(hwndWindow, TinyVkWindow::OnFrameBufferNotifyReSizeCallback);
@@ -142,6 +161,12 @@
 
 			/// @brief Pass to render engine for swapchain resizing.
 			void OnFrameBufferReSizeCallback(int& width, int& height) {
+				if (hwndHeadless) {
+					width = hwndWidth;
+					height = hwndHeight;
+					return;
+				}
+
 				width = 0;
 				height = 0;
 
@@ -152,11 +177,22 @@
 				hwndHeight = height;
 			}
 
+			/// @brief Generates a frame buffer resize event for a headless window (swapchain recreation without a display).
+			void SetHeadlessFrameBufferSize(int width, int height) {
+				if (!hwndHeadless)
+					throw TinyVkRuntimeError("TinyVulkan: SetHeadlessFrameBufferSize called on a GLFW window, resize the GLFW window instead!");
+				OnFrameBufferNotifyReSizeCallback(hwndWindow, std::max(width, 0), std::max(height, 0));
+			}
+
+			/// @brief Returns true if this window has no GLFW window and presents to a VK_EXT_headless_surface.
+			bool IsHeadless() { return hwndHeadless; }
+
 			/// @brief Checks if the GLFW window should close.
-			bool ShouldClose() { return glfwWindowShouldClose(hwndWindow) == GLFW_TRUE; }
+			bool ShouldClose() { return !hwndHeadless && glfwWindowShouldClose(hwndWindow) == GLFW_TRUE; }
 
 			/// @brief Returns [BOOL] should close and polls input events (optional).
 			bool ShouldClosePollEvents() {
+				if (hwndHeadless) return false;
 				bool shouldClose = glfwWindowShouldClose(hwndWindow) == GLFW_TRUE;
 				glfwPollEvents();
 				#ifdef TINYVK_ALLOWS_POLLING_GAMEPADS
@@ -167,6 +203,7 @@
 
 			/// @brief Returns [BOOL] should close and polls input events (optional).
 			bool ShouldCloseWaitEvents() {
+				if (hwndHeadless) return false;
 				bool shouldClose = ShouldClose();
 				glfwWaitEvents();
 				#ifdef TINYVK_ALLOWS_POLLING_GAMEPADS
@@ -176,21 +213,33 @@
 			}
 
 			/// @brief Sets the callback pointer for the window.
-			void SetCallbackPointer(void* data) { glfwSetWindowUserPointer(hwndWindow, data); }
+			void SetCallbackPointer(void* data) { if (!hwndHeadless) glfwSetWindowUserPointer(hwndWindow, data); }
 
 			/// @brief Gets the callback pointer for the window.
-			void* GetCallbackPointer() { return glfwGetWindowUserPointer(hwndWindow); }
+			void* GetCallbackPointer() { return (hwndHeadless)? VK_NULL_HANDLE : glfwGetWindowUserPointer(hwndWindow); }
 
-			/// @brief Creates a Vulkan surface for this GLFW window.
+			/// @brief Creates a Vulkan surface for this GLFW window (or a VK_EXT_headless_surface for headless windows).
 			VkSurfaceKHR CreateWindowSurface(VkInstance instance) {
 				VkSurfaceKHR wndSurface;
+				if (hwndHeadless) {
+					PFN_vkCreateHeadlessSurfaceEXT vkCreateHeadlessSurfaceEXT = (PFN_vkCreateHeadlessSurfaceEXT) vkGetInstanceProcAddr(instance, "vkCreateHeadlessSurfaceEXT");
+					VkHeadlessSurfaceCreateInfoEXT createInfo{};
+					createInfo.sType = VK_STRUCTURE_TYPE_HEADLESS_SURFACE_CREATE_INFO_EXT;
+					
+					if (vkCreateHeadlessSurfaceEXT == VK_NULL_HANDLE || vkCreateHeadlessSurfaceEXT(instance, &createInfo, VK_NULL_HANDLE, &wndSurface) != VK_SUCCESS)
+						throw TinyVkRuntimeError("TinyVulkan: Failed to create headless window surface [VK_EXT_headless_surface]!");
+					return wndSurface;
+				}
+
 				if (glfwCreateWindowSurface(instance, hwndWindow, VK_NULL_HANDLE, &wndSurface) != VK_SUCCESS)
 					throw TinyVkRuntimeError("TinyVulkan: Failed to create GLFW Window Surface!");
 				return wndSurface;
 			}
 
 			/// @brief Gets the required GLFW extensions.
-			inline static std::vector<const char*> QueryRequiredExtensions() {
+			inline static std::vector<const char*> QueryRequiredExtensions(bool headless = false) {
+				if (headless) return { VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME };
+
 				glfwInit();
 
 				uint32_t glfwExtensionCount = 0;
@@ -30,11 +30,33 @@
 			VK_KHR_DYNAMIC_RENDERING_EXTENSION_NAME,     // Allows for rendering without framebuffers and render passes.
 			VK_KHR_PUSH_DESCRIPTOR_EXTENSION_NAME        // Allows for writing descriptors directly into a command buffer rather than allocating from sets / pools.
 
+        OPTIONAL DEVICE EXTENSIONS (enabled if supported):
+			VK_EXT_CONDITIONAL_RENDERING_EXTENSION_NAME    // Occlusion query driven conditional rendering (TinyVkPipelineQueries).
+			VK_EXT_EXTENDED_DYNAMIC_STATE_3_EXTENSION_NAME // Dynamic polygon mode/blend enable/blend equation/color write mask (pipeline variants otherwise).
+
+        OPTIONAL DEVICE FEATURES (enabled if supported):
+			Vulkan 1.2 descriptor indexing                 // Partially bound, update-after-bind sampled image/sampler arrays (TinyVkBindlessTable).
+
         Allows the window to poll gamepad inputs:
             #define TINYVK_ALLOWS_POLLING_GAMEPADS
         
         Auto inserts window instance extensions:
             #define TINYVK_AUTO_PRESENT_EXTENSIONS
+
+        Compiles in the CPU frame tracer scopes (TinyVk_FrameTracer.hpp):
+            #define TINYVK_FRAME_TRACING
+
+        Compiles in VK_EXT_debug_utils object names and command buffer labels in release builds (always on in debug builds):
+            #define TINYVK_DEBUG_LABELS
+
+        Bakes all render state into pipeline variants instead of using extended dynamic state 1/2/3 (e.g. to test the fallback):
+            #define TINYVK_DISABLE_DYNAMIC_STATE
+
+        Leaves descriptor indexing disabled (TinyVkBindlessTable throws, push descriptors only):
+            #define TINYVK_DISABLE_BINDLESS
+
+        HEADLESS PRESENTATION (TinyVkWindow headless = true):
+            VK_KHR_SURFACE_EXTENSION_NAME, VK_EXT_HEADLESS_SURFACE_EXTENSION_NAME instance extensions replace the GLFW surface extensions.
     */
 
     #define GLFW_INCLUDE_VULKAN
@@ -69,10 +91,16 @@
         namespace TINYVULKAN_NAMESPACE {}
     #endif
     #define TINYVK_VALIDATION_LAYERS TVK_VALIDATION_LAYERS
+    #if TVK_VALIDATION_LAYERS || defined(TINYVK_DEBUG_LABELS)
+        #define TVK_DEBUG_UTILS VK_TRUE
+    #else
+        #define TVK_DEBUG_UTILS VK_FALSE
+    #endif
 
     #define TVK_MAKE_VERSION(variant, major, minor, patch) ((((uint32_t)variant)<<29)|(((uint32_t)major)<<22)|(((uint32_t)minor)<<12)|((uint32_t)patch))
     #define TVK_RENDERER_VERSION TVK_MAKE_VERSION(0, 1, 1, 0)
     #define TVK_RENDERER_NAME "TINYVULKAN_LIBRARY"
+    #define TVK_VULKAN_API_VERSION VK_API_VERSION_1_3
 
     #define VMA_IMPLEMENTATION
     #define VMA_DEBUG_GLOBAL_MUTEX VK_TRUE
@@ -96,9 +124,13 @@
     #include <string>
     #include <vector>
     #include <algorithm>
+    #include <atomic>
+    #include <functional>
 
     #pragma region BACKEND_SYSTEMS
         #include "./TinyVk_TimedGuard.hpp"
+        #include "./TinyVk_FrameTracer.hpp"
+        #include "./TinyVk_RenderStats.hpp"
         #include "./TinyVk_Invokable.hpp"
         #include "./TinyVk_Utilities.hpp"
         #include "./TinyVk_Disposable.hpp"
@@ -108,17 +140,28 @@
         #include "./TinyVk_Window.hpp"
     #pragma endregion
     #pragma region VULKAN_INITIALIZATION
+        #include "./TinyVk_Timeline.hpp"
+        #include "./TinyVk_ShaderCache.hpp"
         #include "./TinyVk_VulkanDevice.hpp"
+        #include "./TinyVk_BindlessTable.hpp"
         #include "./TinyVk_CommandPool.hpp"
+        #include "./TinyVk_BarrierBatch.hpp"
+        #include "./TinyVk_GpuProfiler.hpp"
+        #include "./TinyVk_PipelineQueries.hpp"
+        #include "./TinyVk_PipelineCompiler.hpp"
+        #include "./TinyVk_ShaderReflection.hpp"
         #include "./TinyVk_GraphicsPipeline.hpp"
     #pragma endregion
     #pragma region TINYVULKAN_RENDERING
         #include "./TinyVk_RenderContext.hpp"
         #include "./TinyVk_Buffer.hpp"
+        #include "./TinyVk_ParameterBlock.hpp"
         #include "./TinyVk_Image.hpp"
         #include "./TinyVk_GraphicsRenderer.hpp"
         #include "./TinyVk_SwapchainRenderer.hpp"
         #include "./TinyVk_ComputeRenderer.hpp"
+        #include "./TinyVk_ShaderWatcher.hpp"
+        #include "./TinyVk_FrameGraph.hpp"
         #include "./TinyVk_ResourceQueue.hpp"
         #include "./TinyVk_VertexMath.hpp"
     #pragma endregion
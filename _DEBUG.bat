@@ -2,6 +2,8 @@
 :: The ^ (carret) forces next parameter to CLI command on a new-line for readability.
 :: Note the extra   (space) at the beginning of each new-line to separate parameters when combined into one line during execution.
 ::
+:: Compiles the shaders and generates the embedded SPIR-V headers (./Shaders/*_spv.h) included by source.cpp.
+call "%CD%/_SHADERS.bat" nopause
 clang-cl^
  /D _DEBUG^
  /D _CRT_SECURE_NO_WARNINGS^
@@ -1,5 +1,6 @@
 :: Change the "1.3.211.0" to your Vulkan version.
 :: Change "sample_shader" to the shader you want to compile.
+:: _DEBUG.bat/_RELEASE.bat call this with "nopause" before compiling (source.cpp includes the generated ./Shaders/*_spv.h).
 mkdir "%CD%/x64/DEBUG/Shaders/"
 mkdir "%CD%/x64/RELEASE/Shaders/"
 	"%VULKAN%/Bin/glslc.exe" "%CD%/Shaders/passthrough_vert.vert" -o "%CD%/x64/DEBUG/Shaders/passthrough_vert.spv"
@@ -10,4 +11,22 @@ mkdir "%CD%/x64/RELEASE/Shaders/"
 
 	"%VULKAN%/Bin/glslc.exe" "%CD%/Shaders/passthrough_comp.comp" -o "%CD%/x64/DEBUG/Shaders/passthrough_comp.spv"
 	"%VULKAN%/Bin/glslc.exe" "%CD%/Shaders/passthrough_comp.comp" -o "%CD%/x64/RELEASE/Shaders/passthrough_comp.spv"
-pause
\ No newline at end of file
+
+	:: Embedded SPIR-V for source.cpp: glslc -mfmt=num writes the words, *_spv.h registers them under the .spv path.
+	call :EMBED passthrough_vert vert
+	call :EMBED passthrough_frag frag
+if not "%1"=="nopause" pause
+goto :EOF
+
+:: Writes ./Shaders/%1_spv.inc (SPIR-V words) and ./Shaders/%1_spv.h (constexpr array + TINYVK_EMBED_SHADER).
+:EMBED
+	"%VULKAN%/Bin/glslc.exe" -mfmt=num "%CD%/Shaders/%1.%2" -o "%CD%/Shaders/%1_spv.inc"
+	(
+		echo // Generated by _SHADERS.bat from %1.%2, do not edit.
+		echo #pragma once
+		echo inline constexpr uint32_t %1_spv[] = {
+		echo 	#include "%1_spv.inc"
+		echo };
+		echo TINYVK_EMBED_SHADER^("./Shaders/%1.spv", %1_spv^)
+	) > "%CD%/Shaders/%1_spv.h"
+goto :EOF
\ No newline at end of file
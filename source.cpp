@@ -6,6 +6,10 @@ using namespace tinyvk;
 #define DEFAULT_VERTEX_SHADER "./Shaders/passthrough_vert.spv"
 #define DEFAULT_FRAGMENT_SHADER "./Shaders/passthrough_frag.spv"
 
+// Embedded SPIR-V generated by _SHADERS.bat (registered under the paths above, pipelines never read the .spv files).
+#include "./Shaders/passthrough_vert_spv.h"
+#include "./Shaders/passthrough_frag_spv.h"
+
 //const std::string computeShader = DEFAULT_COMPUTE_SHADER;
 const std::tuple<VkShaderStageFlagBits, std::string> vertexShader = { VK_SHADER_STAGE_VERTEX_BIT, DEFAULT_VERTEX_SHADER };
 const std::tuple<VkShaderStageFlagBits, std::string> fragmentShader = { VK_SHADER_STAGE_FRAGMENT_BIT, DEFAULT_FRAGMENT_SHADER };